@@ -69,6 +69,10 @@ static const aiImporterDesc desc = {
     "3ds prj"
 };
 
+static const uint16_t magicTokenData[] = { 0x4d4d, 0x3dc2 };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 2, 0, 2 };
+
 // ------------------------------------------------------------------------------------------------
 // Begins a new parsing block
 // - Reads the current chunk and validates it
@@ -118,15 +122,17 @@ bool Discreet3DSImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler
     }
 
     if (!extension.length() || checkSig) {
-        uint16_t token[3];
-        token[0] = 0x4d4d;
-        token[1] = 0x3dc2;
-        //token[2] = 0x3daa;
-        return CheckMagicToken(pIOHandler, pFile, token, 2, 0, 2);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *Discreet3DSImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Loader registry entry
 const aiImporterDesc *Discreet3DSImporter::GetInfo() const {
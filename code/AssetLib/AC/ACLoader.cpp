@@ -75,6 +75,10 @@ static const aiImporterDesc desc = {
     "ac acc ac3d"
 };
 
+static const uint32_t magicTokenData[] = { AI_MAKE_MAGIC("AC3D") };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 1, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // skip to the next token
 inline const char *AcSkipToNextToken(const char *buffer) {
@@ -160,12 +164,17 @@ bool AC3DImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool
         return true;
     }
     if (!extension.length() || checkSig) {
-        uint32_t token = AI_MAKE_MAGIC("AC3D");
-        return CheckMagicToken(pIOHandler, pFile, &token, 1, 0);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *AC3DImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Loader meta information
 const aiImporterDesc *AC3DImporter::GetInfo() const {
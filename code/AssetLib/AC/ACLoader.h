@@ -187,6 +187,11 @@ public:
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler,
             bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format.
+     * See BaseImporter::GetMagicTokens() for details. */
+    const MagicTokenInfo *GetMagicTokens() const;
+
 protected:
     // -------------------------------------------------------------------
     /** Return importer meta information.
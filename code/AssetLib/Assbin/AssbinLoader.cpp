@@ -50,11 +50,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "AssetLib/Assbin/AssbinLoader.h"
 #include "Common/assbin_chunks.h"
+#include "Common/FileHeaderCache.h"
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/anim.h>
 #include <assimp/importerdesc.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
+#include <algorithm>
 #include <memory>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
@@ -85,16 +87,11 @@ const aiImporterDesc *AssbinImporter::GetInfo() const {
 
 // -----------------------------------------------------------------------------------
 bool AssbinImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /*checkSig*/) const {
-    IOStream *in = pIOHandler->Open(pFile);
-    if (nullptr == in) {
+    char s[19];
+    if (sizeof(s) != FileHeaderCache::ReadHeader(pIOHandler, pFile, s, sizeof(s))) {
         return false;
     }
 
-    char s[32];
-    in->Read(s, sizeof(char), 32);
-
-    pIOHandler->Close(in);
-
     return strncmp(s, "ASSIMP.binary-dump.", 19) == 0;
 }
 
@@ -145,10 +142,17 @@ aiQuaternion Read<aiQuaternion>(IOStream *stream) {
 template <>
 aiString Read<aiString>(IOStream *stream) {
     aiString s;
-    stream->Read(&s.length, 4, 1);
+    ai_uint32 length = 0;
+    stream->Read(&length, 4, 1);
+
+    // the file may come from a build with a larger string capacity, truncate then
+    s.length = std::min(length, static_cast<ai_uint32>(MAXLEN - 1));
     if (s.length) {
         stream->Read(s.data, s.length, 1);
     }
+    if (length > s.length) {
+        stream->Seek(length - s.length, aiOrigin_CUR);
+    }
     s.data[s.length] = 0;
 
     return s;
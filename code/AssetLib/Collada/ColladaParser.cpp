@@ -1432,20 +1432,10 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
                 SkipSpacesAndLineEnd(&content);
             }
         } else {
-            data.mValues.reserve(count);
-
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading float_array contents.");
-                }
-
-                ai_real value;
-                // read a number
-                //SkipSpacesAndLineEnd(&content);
-                content = fast_atoreal_move<ai_real>(content, value);
-                data.mValues.push_back(value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd(&content);
+            // parse all numbers in one go
+            data.mValues.resize(count);
+            if (count > 0 && fast_atoreal_array<ai_real>(&content, v.c_str() + v.size(), &data.mValues[0], count) != count) {
+                throw DeadlyImportError("Expected more values while reading float_array contents.");
             }
         }
     }
@@ -1731,14 +1721,15 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
         std::string v;
         XmlParser::getValueAsString(node, v);
         const char *content = v.c_str();
-        SkipSpacesAndLineEnd(&content);
-        while (*content != 0) {
-            // read a value.
+        const char *end = content + v.size();
+        static const size_t ChunkSize = 256;
+        int values[ChunkSize];
+        size_t numValues;
+        while ((numValues = strtol10_array(&content, end, values, ChunkSize)) > 0) {
             // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-            int value = std::max(0, strtol10(content, &content));
-            indices.push_back(size_t(value));
-            // skip whitespace after it
-            SkipSpacesAndLineEnd(&content);
+            for (size_t i = 0; i < numValues; ++i) {
+                indices.push_back(size_t(std::max(0, values[i])));
+            }
         }
     }
 
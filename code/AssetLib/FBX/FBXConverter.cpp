@@ -53,6 +53,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXProperties.h"
 #include "FBXUtil.h"
 
+#include "Common/ThreadPool.h"
+
 #include <assimp/MathFunctions.h>
 #include <assimp/StringComparison.h>
 
@@ -64,6 +66,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdlib.h>
 #include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -81,7 +84,7 @@ using namespace Util;
 
 #define CONVERT_FBX_TIME(time) (static_cast<double>(time) * 1000.0 / 46186158000LL)
 
-FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBones) :
+FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBones, ThreadPool *threadPool) :
         defaultMaterialIndex(),
         mMeshes(),
         lights(),
@@ -95,7 +98,8 @@ FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBo
         anim_fps(),
         mSceneOut(out),
         doc(doc),
-        mRemoveEmptyBones(removeEmptyBones) {
+        mRemoveEmptyBones(removeEmptyBones),
+        mThreadPool(threadPool) {
     // animations need to be converted first since this will
     // populate the node_anim_chain_bits map, which is needed
     // to determine which nodes need to be generated.
@@ -108,6 +112,7 @@ FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBo
         ConvertOrphanedEmbeddedTextures();
     }
     ConvertRootNode();
+    ConvertMeshJobs();
 
     if (doc.Settings().readAllMaterials) {
         // unfortunately this means we have to evaluate all objects
@@ -1029,12 +1034,60 @@ aiMesh *FBXConverter::SetupEmptyMesh(const Geometry &mesh, aiNode *parent) {
     return out_mesh;
 }
 
+void FBXConverter::ConvertMeshJobs() {
+    // the output meshes were set up and numbered while walking the node graph, filling
+    // them only reads the DOM, so this can happen concurrently
+    const std::function<void(size_t)> fill = [this](size_t i) {
+        MeshJob &job = mMeshJobs[i];
+        if (job.materialIndex == NO_MATERIAL_SEPARATION) {
+            FillMeshSingleMaterial(job);
+        } else {
+            FillMeshMultiMaterial(job);
+        }
+    };
+    if (nullptr != mThreadPool) {
+        mThreadPool->ParallelFor(mMeshJobs.size(), fill);
+    } else {
+        for (size_t i = 0; i < mMeshJobs.size(); ++i) {
+            fill(i);
+        }
+    }
+
+    // bones are created through bone_map, so the skins are converted serially in mesh order
+    if (doc.Settings().readWeights) {
+        for (MeshJob &job : mMeshJobs) {
+            if (job.geo->DeformerSkin() == nullptr) {
+                continue;
+            }
+            const bool split = job.materialIndex != NO_MATERIAL_SEPARATION;
+            ConvertWeights(job.out, *job.geo, job.absoluteTransform, job.parent, job.materialIndex,
+                    split ? &job.reverseMapping : nullptr);
+        }
+    }
+    mMeshJobs.clear();
+}
+
 unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, const Model &model,
         const aiMatrix4x4 &absolute_transform, aiNode *parent,
         aiNode *) {
     const MatIndexArray &mindices = mesh.GetMaterialIndices();
     aiMesh *const out_mesh = SetupEmptyMesh(mesh, parent);
 
+    if (!doc.Settings().readMaterials || mindices.empty()) {
+        FBXImporter::LogError("no material assigned to mesh, setting default material");
+        out_mesh->mMaterialIndex = GetDefaultMaterial();
+    } else {
+        ConvertMaterialForMesh(out_mesh, model, mesh, mindices[0]);
+    }
+
+    mMeshJobs.push_back({ out_mesh, &mesh, NO_MATERIAL_SEPARATION, absolute_transform, parent, {} });
+    return static_cast<unsigned int>(mMeshes.size() - 1);
+}
+
+void FBXConverter::FillMeshSingleMaterial(MeshJob &job) const {
+    const MeshGeometry &mesh = *job.geo;
+    aiMesh *const out_mesh = job.out;
+
     const std::vector<aiVector3D> &vertices = mesh.GetVertices();
     const std::vector<unsigned int> &faces = mesh.GetFaceIndexCounts();
 
@@ -1142,17 +1195,6 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
         std::copy(colors.begin(), colors.end(), out_mesh->mColors[i]);
     }
 
-    if (!doc.Settings().readMaterials || mindices.empty()) {
-        FBXImporter::LogError("no material assigned to mesh, setting default material");
-        out_mesh->mMaterialIndex = GetDefaultMaterial();
-    } else {
-        ConvertMaterialForMesh(out_mesh, model, mesh, mindices[0]);
-    }
-
-    if (doc.Settings().readWeights && mesh.DeformerSkin() != nullptr) {
-        ConvertWeights(out_mesh, mesh, absolute_transform, parent, NO_MATERIAL_SEPARATION, nullptr);
-    }
-
     std::vector<aiAnimMesh *> animMeshes;
     for (const BlendShape *blendShape : mesh.GetBlendShapes()) {
         for (const BlendShapeChannel *blendShapeChannel : blendShape->BlendShapeChannels()) {
@@ -1193,7 +1235,6 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
             out_mesh->mAnimMeshes[i] = animMeshes.at(i);
         }
     }
-    return static_cast<unsigned int>(mMeshes.size() - 1);
 }
 
 std::vector<unsigned int>
@@ -1223,6 +1264,17 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         const aiMatrix4x4 &absolute_transform) {
     aiMesh *const out_mesh = SetupEmptyMesh(mesh, parent);
 
+    ConvertMaterialForMesh(out_mesh, model, mesh, index);
+
+    mMeshJobs.push_back({ out_mesh, &mesh, static_cast<unsigned int>(index), absolute_transform, parent, {} });
+    return static_cast<unsigned int>(mMeshes.size() - 1);
+}
+
+void FBXConverter::FillMeshMultiMaterial(MeshJob &job) const {
+    const MeshGeometry &mesh = *job.geo;
+    aiMesh *const out_mesh = job.out;
+    const MatIndexArray::value_type index = static_cast<MatIndexArray::value_type>(job.materialIndex);
+
     const MatIndexArray &mindices = mesh.GetMaterialIndices();
     const std::vector<aiVector3D> &vertices = mesh.GetVertices();
     const std::vector<unsigned int> &faces = mesh.GetFaceIndexCounts();
@@ -1248,7 +1300,7 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
     ai_assert(count_vertices);
 
     // mapping from output indices to DOM indexing, needed to resolve weights or blendshapes
-    std::vector<unsigned int> reverseMapping;
+    std::vector<unsigned int> &reverseMapping = job.reverseMapping;
     std::map<unsigned int, unsigned int> translateIndexMap;
     if (process_weights || mesh.GetBlendShapes().size() > 0) {
         reverseMapping.resize(count_vertices);
@@ -1380,12 +1432,6 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         }
     }
 
-    ConvertMaterialForMesh(out_mesh, model, mesh, index);
-
-    if (process_weights) {
-        ConvertWeights(out_mesh, mesh, absolute_transform, parent, index, &reverseMapping);
-    }
-
     std::vector<aiAnimMesh *> animMeshes;
     for (const BlendShape *blendShape : mesh.GetBlendShapes()) {
         for (const BlendShapeChannel *blendShapeChannel : blendShape->BlendShapeChannels()) {
@@ -1429,8 +1475,6 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
             out_mesh->mAnimMeshes[i] = animMeshes.at(i);
         }
     }
-
-    return static_cast<unsigned int>(mMeshes.size() - 1);
 }
 
 void FBXConverter::ConvertWeights(aiMesh *out, const MeshGeometry &geo,
@@ -2492,7 +2536,7 @@ std::string FBXConverter::FixNodeName(const std::string &name) {
     return name;
 }
 
-std::string FBXConverter::FixAnimMeshName(const std::string &name) {
+std::string FBXConverter::FixAnimMeshName(const std::string &name) const {
     if (name.length()) {
         size_t indexOf = name.find_first_of("::");
         if (indexOf != std::string::npos && indexOf < name.size() - 2) {
@@ -2502,6 +2546,67 @@ std::string FBXConverter::FixAnimMeshName(const std::string &name) {
     return name.length() ? name : "AnimMesh";
 }
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// distance of a key from the interpolation between two other keys
+ai_real KeyError(const aiVectorKey &a, const aiVectorKey &b, const aiVectorKey &key) {
+    const ai_real factor = static_cast<ai_real>((key.mTime - a.mTime) / (b.mTime - a.mTime));
+    const aiVector3D value = a.mValue + (b.mValue - a.mValue) * factor;
+    return (value - key.mValue).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// angle between a key and the interpolation between two other keys
+ai_real KeyError(const aiQuatKey &a, const aiQuatKey &b, const aiQuatKey &key) {
+    const ai_real factor = static_cast<ai_real>((key.mTime - a.mTime) / (b.mTime - a.mTime));
+    aiQuaternion value;
+    aiQuaternion::Interpolate(value, a.mValue, b.mValue, factor);
+
+    const aiQuaternion &q = key.mValue;
+    const ai_real dot = std::abs(value.x * q.x + value.y * q.y + value.z * q.z + value.w * q.w);
+    return 2 * std::acos(std::min(dot, ai_real(1.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// drop the keys which interpolating between the remaining keys reproduces within the tolerance,
+// a distance for vector keys and an angle in radians for rotation keys.
+// The first and the last key are always kept.
+template <typename KeyType>
+void ReduceKeys(KeyType *&keys, unsigned int &numKeys, ai_real tolerance) {
+    if (numKeys < 3) {
+        return;
+    }
+
+    // keys[anchor] is the last key kept, the kept keys are compacted to the front in place
+    unsigned int anchor = 0, count = 1;
+    for (unsigned int i = 1; i + 1 < numKeys; ++i) {
+        const KeyType &next = keys[i + 1];
+
+        // can the segment from the anchor to the next key replace all keys in between?
+        bool redundant = next.mTime > keys[anchor].mTime;
+        for (unsigned int j = anchor + 1; redundant && j <= i; ++j) {
+            redundant = KeyError(keys[anchor], next, keys[j]) <= tolerance;
+        }
+        if (!redundant) {
+            // count never exceeds i, so this only overwrites keys which are not needed anymore
+            keys[count++] = keys[i];
+            anchor = i;
+        }
+    }
+    keys[count++] = keys[numKeys - 1];
+
+    if (count < numKeys) {
+        KeyType *reduced = new KeyType[count];
+        std::copy(keys, keys + count, reduced);
+        delete[] keys;
+        keys = reduced;
+        numKeys = count;
+    }
+}
+
+} // namespace
+
 void FBXConverter::ConvertAnimationStack(const AnimationStack &st) {
     const AnimationLayerList &layers = st.Layers();
     if (layers.empty()) {
@@ -2588,6 +2693,18 @@ void FBXConverter::ConvertAnimationStack(const AnimationStack &st) {
         throw;
     }
 
+    const ai_real keyTolerance = doc.Settings().animationKeyTolerance;
+    const ai_real rotationKeyTolerance = doc.Settings().animationRotationKeyTolerance;
+    for (aiNodeAnim *na : node_anims) {
+        if (keyTolerance > 0) {
+            ReduceKeys(na->mPositionKeys, na->mNumPositionKeys, keyTolerance);
+            ReduceKeys(na->mScalingKeys, na->mNumScalingKeys, keyTolerance);
+        }
+        if (rotationKeyTolerance > 0) {
+            ReduceKeys(na->mRotationKeys, na->mNumRotationKeys, rotationKeyTolerance);
+        }
+    }
+
     if (node_anims.size() || morphAnimDatas.size()) {
         if (node_anims.size()) {
             anim->mChannels = new aiNodeAnim *[node_anims.size()]();
@@ -3114,26 +3231,21 @@ aiNodeAnim* FBXConverter::GenerateSimpleNodeAnim(const std::string& name,
 
     const PropertyTable &props = target.Props();
 
-    // collect unique times and keyframe lists
+    // collect keyframe lists and merge their times
     KeyFrameListList keyframeLists[TransformationComp_MAXIMUM];
-    KeyTimeList keytimes;
+    KeyFrameListList allKeyframeLists;
 
     for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
         if (chain[i] == iterEnd)
             continue;
 
         keyframeLists[i] = GetKeyframeList((*chain[i]).second, start, stop);
+        allKeyframeLists.insert(allKeyframeLists.end(), keyframeLists[i].begin(), keyframeLists[i].end());
+    }
 
-        for (KeyFrameListList::const_iterator it = keyframeLists[i].begin(); it != keyframeLists[i].end(); ++it) {
-            const KeyTimeList& times = *std::get<0>(*it);
-            keytimes.insert(keytimes.end(), times.begin(), times.end());
-        }
-
-        // remove duplicates
-        std::sort(keytimes.begin(), keytimes.end());
-
-        auto last = std::unique(keytimes.begin(), keytimes.end());
-        keytimes.erase(last, keytimes.end());
+    KeyTimeList keytimes;
+    if (!allKeyframeLists.empty()) {
+        keytimes = GetKeyTimeList(allKeyframeLists);
     }
 
     const Model::RotOrder rotOrder = target.RotationOrder();
@@ -3249,21 +3361,15 @@ FBXConverter::KeyFrameListList FBXConverter::GetKeyframeList(const std::vector<c
             ai_assert(curve->GetKeys().size() == curve->GetValues().size());
             ai_assert(curve->GetKeys().size());
 
-            //get values within the start/stop time window
-            std::shared_ptr<KeyTimeList> Keys(new KeyTimeList());
-            std::shared_ptr<KeyValueList> Values(new KeyValueList());
-            const size_t count = curve->GetKeys().size();
-            Keys->reserve(count);
-            Values->reserve(count);
-            for (size_t n = 0; n < count; n++) {
-                int64_t k = curve->GetKeys().at(n);
-                if (k >= adj_start && k <= adj_stop) {
-                    Keys->push_back(k);
-                    Values->push_back(curve->GetValues().at(n));
-                }
-            }
+            // get values within the start/stop time window, the keys are sorted by time
+            const KeyTimeList &times = curve->GetKeys();
+            const KeyTimeList::const_iterator first = std::lower_bound(times.begin(), times.end(), adj_start);
+            const KeyTimeList::const_iterator last = std::upper_bound(first, times.end(), adj_stop);
+            const size_t offset = static_cast<size_t>(first - times.begin());
 
-            inputs.push_back(std::make_tuple(Keys, Values, mapto));
+            const KeyFrameList kfl = { times.data() + offset, curve->GetValues().data() + offset,
+                static_cast<size_t>(last - first), mapto };
+            inputs.push_back(kfl);
         }
     }
     return inputs; // pray for NRVO :-)
@@ -3279,23 +3385,21 @@ KeyTimeList FBXConverter::GetKeyTimeList(const KeyFrameListList &inputs) {
 
     size_t estimate = 0;
     for (const KeyFrameList &kfl : inputs) {
-        estimate = std::max(estimate, std::get<0>(kfl)->size());
+        estimate = std::max(estimate, kfl.count);
     }
 
     keys.reserve(estimate);
 
-    std::vector<unsigned int> next_pos;
-    next_pos.resize(inputs.size(), 0);
+    // merge the sorted time lists, advancing one cursor per input
+    std::vector<size_t> next_pos(inputs.size(), 0);
 
     const size_t count = inputs.size();
     while (true) {
-
         int64_t min_tick = std::numeric_limits<int64_t>::max();
         for (size_t i = 0; i < count; ++i) {
             const KeyFrameList &kfl = inputs[i];
-
-            if (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) < min_tick) {
-                min_tick = std::get<0>(kfl)->at(next_pos[i]);
+            if (next_pos[i] < kfl.count && kfl.times[next_pos[i]] < min_tick) {
+                min_tick = kfl.times[next_pos[i]];
             }
         }
 
@@ -3306,8 +3410,7 @@ KeyTimeList FBXConverter::GetKeyTimeList(const KeyFrameListList &inputs) {
 
         for (size_t i = 0; i < count; ++i) {
             const KeyFrameList &kfl = inputs[i];
-
-            while (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == min_tick) {
+            while (next_pos[i] < kfl.count && kfl.times[next_pos[i]] == min_tick) {
                 ++next_pos[i];
             }
         }
@@ -3323,22 +3426,21 @@ void FBXConverter::InterpolateKeys(aiVectorKey *valOut, const KeyTimeList &keys,
     ai_assert(!keys.empty());
     ai_assert(nullptr != valOut);
 
-    std::vector<unsigned int> next_pos;
+    // keys are visited in order, so each input only ever moves its cursor forward
+    std::vector<size_t> next_pos(inputs.size(), 0);
     const size_t count(inputs.size());
 
-    next_pos.resize(inputs.size(), 0);
-
     for (KeyTimeList::value_type time : keys) {
         ai_real result[3] = { def_value.x, def_value.y, def_value.z };
 
         for (size_t i = 0; i < count; ++i) {
             const KeyFrameList &kfl = inputs[i];
 
-            const size_t ksize = std::get<0>(kfl)->size();
+            const size_t ksize = kfl.count;
             if (ksize == 0) {
                 continue;
             }
-            if (ksize > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == time) {
+            if (ksize > next_pos[i] && kfl.times[next_pos[i]] == time) {
                 ++next_pos[i];
             }
 
@@ -3346,16 +3448,16 @@ void FBXConverter::InterpolateKeys(aiVectorKey *valOut, const KeyTimeList &keys,
             const size_t id1 = next_pos[i] == ksize ? ksize - 1 : next_pos[i];
 
             // use lerp for interpolation
-            const KeyValueList::value_type valueA = std::get<1>(kfl)->at(id0);
-            const KeyValueList::value_type valueB = std::get<1>(kfl)->at(id1);
+            const KeyValueList::value_type valueA = kfl.values[id0];
+            const KeyValueList::value_type valueB = kfl.values[id1];
 
-            const KeyTimeList::value_type timeA = std::get<0>(kfl)->at(id0);
-            const KeyTimeList::value_type timeB = std::get<0>(kfl)->at(id1);
+            const KeyTimeList::value_type timeA = kfl.times[id0];
+            const KeyTimeList::value_type timeB = kfl.times[id1];
 
             const ai_real factor = timeB == timeA ? ai_real(0.) : static_cast<ai_real>((time - timeA)) / (timeB - timeA);
             const ai_real interpValue = static_cast<ai_real>(valueA + (valueB - valueA) * factor);
 
-            result[std::get<2>(kfl)] = interpValue;
+            result[kfl.mapto] = interpValue;
         }
 
         // magic value to convert fbx times to seconds
@@ -3584,8 +3686,8 @@ void FBXConverter::ConvertOrphanedEmbeddedTextures() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ConvertToAssimpScene(aiScene *out, const Document &doc, bool removeEmptyBones) {
-    FBXConverter converter(out, doc, removeEmptyBones);
+void ConvertToAssimpScene(aiScene *out, const Document &doc, bool removeEmptyBones, ThreadPool *threadPool) {
+    FBXConverter converter(out, doc, removeEmptyBones, threadPool);
 }
 
 } // namespace FBX
@@ -73,6 +73,9 @@ struct morphKeyData {
 typedef std::map<int64_t, morphKeyData*> morphAnimData;
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 class Document;
@@ -81,8 +84,9 @@ class Document;
  *  @param out Empty scene to be populated
  *  @param doc Parsed FBX document
  *  @param removeEmptyBones Will remove bones, which do not have any references to vertices.
+ *  @param threadPool Workers to convert the meshes concurrently, nullptr to convert them serially.
  */
-void ConvertToAssimpScene(aiScene* out, const Document& doc, bool removeEmptyBones);
+void ConvertToAssimpScene(aiScene* out, const Document& doc, bool removeEmptyBones, ThreadPool* threadPool = nullptr);
 
 /** Dummy class to encapsulate the conversion process */
 class FBXConverter {
@@ -113,7 +117,7 @@ public:
     };
 
 public:
-    FBXConverter(aiScene* out, const Document& doc, bool removeEmptyBones);
+    FBXConverter(aiScene* out, const Document& doc, bool removeEmptyBones, ThreadPool* threadPool = nullptr);
     ~FBXConverter();
 
 private:
@@ -195,11 +199,33 @@ private:
     // ------------------------------------------------------------------------------------------------
     aiMesh* SetupEmptyMesh(const Geometry& mesh, aiNode *parent);
 
+    // ------------------------------------------------------------------------------------------------
+    // An output mesh set up while walking the node graph. Its geometry is filled in by
+    // ConvertMeshJobs() once all meshes are known.
+    struct MeshJob {
+        aiMesh *out;
+        const MeshGeometry *geo;
+        // NO_MATERIAL_SEPARATION unless the geometry is split by material
+        unsigned int materialIndex;
+        aiMatrix4x4 absoluteTransform;
+        aiNode *parent;
+        // output vertex -> DOM vertex, only for split skinned meshes
+        std::vector<unsigned int> reverseMapping;
+    };
+
+    // ------------------------------------------------------------------------------------------------
+    // fill all pending output meshes, concurrently if there is a thread pool, then add the skin weights
+    void ConvertMeshJobs();
+
     // ------------------------------------------------------------------------------------------------
     unsigned int ConvertMeshSingleMaterial(const MeshGeometry &mesh, const Model &model,
                                            const aiMatrix4x4 &absolute_transform, aiNode *parent,
                                            aiNode *root_node);
 
+    // ------------------------------------------------------------------------------------------------
+    // copy vertex data, faces and blend shapes of an unsplit mesh. Touches no converter state.
+    void FillMeshSingleMaterial(MeshJob &job) const;
+
     // ------------------------------------------------------------------------------------------------
     std::vector<unsigned int>
     ConvertMeshMultiMaterial(const MeshGeometry &mesh, const Model &model, aiNode *parent, aiNode *root_node,
@@ -209,6 +235,10 @@ private:
     unsigned int ConvertMeshMultiMaterial(const MeshGeometry &mesh, const Model &model, MatIndexArray::value_type index,
                                           aiNode *parent, aiNode *root_node, const aiMatrix4x4 &absolute_transform);
 
+    // ------------------------------------------------------------------------------------------------
+    // copy the part of a mesh using one material. Touches no converter state.
+    void FillMeshMultiMaterial(MeshJob &job) const;
+
     // ------------------------------------------------------------------------------------------------
     static const unsigned int NO_MATERIAL_SEPARATION = /* std::numeric_limits<unsigned int>::max() */
         static_cast<unsigned int>(-1);
@@ -290,7 +320,7 @@ private:
     // the function is guaranteed to provide consistent results over multiple invocations
     // UNLESS RenameNode() is called for a particular node name.
     std::string FixNodeName(const std::string& name);
-    std::string FixAnimMeshName(const std::string& name);
+    std::string FixAnimMeshName(const std::string& name) const;
 
     typedef std::map<const AnimationCurveNode*, const AnimationLayer*> LayerMap;
 
@@ -355,8 +385,14 @@ private:
         double& maxTime,
         double& minTime);
 
-    // key (time), value, mapto (component index)
-    typedef std::tuple<std::shared_ptr<KeyTimeList>, std::shared_ptr<KeyValueList>, unsigned int > KeyFrameList;
+    // the keys of an animation curve within the converted time window, points into the curve
+    struct KeyFrameList {
+        const KeyTimeList::value_type *times;
+        const KeyValueList::value_type *values;
+        size_t count;
+        // component index
+        unsigned int mapto;
+    };
     typedef std::vector<KeyFrameList> KeyFrameListList;
 
     // ------------------------------------------------------------------------------------------------
@@ -435,6 +471,9 @@ private:
     using MeshMap = std::fbx_unordered_map<const Geometry*, std::vector<unsigned int> >;
     MeshMap meshes_converted;
 
+    // meshes whose geometry has not been filled yet, in output order
+    std::vector<MeshJob> mMeshJobs;
+
     // fixed node name -> which trafo chain components have animations?
     using NodeAnimBitMap = std::fbx_unordered_map<std::string, unsigned int> ;
     NodeAnimBitMap node_anim_chain_bits;
@@ -452,6 +491,7 @@ private:
     aiScene* const mSceneOut;
     const FBX::Document& doc;
     bool mRemoveEmptyBones;
+    ThreadPool* mThreadPool;
     static void BuildBoneList(aiNode *current_node, const aiNode *root_node, const aiScene *scene,
                              std::vector<aiBone*>& bones);
 
@@ -62,6 +62,8 @@ struct ImportSettings {
             readWeights(true),
             preservePivots(true),
             optimizeEmptyAnimationCurves(true),
+            animationKeyTolerance(0.f),
+            animationRotationKeyTolerance(0.f),
             useLegacyEmbeddedTextureNaming(false),
             removeEmptyBones(true),
             convertToMeters(false) {
@@ -139,6 +141,14 @@ struct ImportSettings {
      *  The default value is true. */
     bool optimizeEmptyAnimationCurves;
 
+    /** drop position and scaling keys which interpolating their neighbours
+     *  reproduces within this distance. The default value is 0, keeping all keys. */
+    float animationKeyTolerance;
+
+    /** drop rotation keys which interpolating their neighbours reproduces
+     *  within this angle in radians. The default value is 0, keeping all keys. */
+    float animationRotationKeyTolerance;
+
     /** use legacy naming for embedded textures eg: (*0, *1, *2)
     */
     bool useLegacyEmbeddedTextureNaming;
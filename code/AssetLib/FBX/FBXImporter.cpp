@@ -53,7 +53,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 #include "FBXUtil.h"
 
+#include <assimp/IOStreamView.h>
 #include <assimp/MemoryIOWrapper.h>
+#include <assimp/Profiler.h>
 #include <assimp/StreamReader.h>
 #include <assimp/importerdesc.h>
 #include <assimp/Importer.hpp>
@@ -134,6 +136,8 @@ void FBXImporter::SetupProperties(const Importer *pImp) {
 	settings.strictMode = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_STRICT_MODE, false);
 	settings.preservePivots = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, true);
 	settings.optimizeEmptyAnimationCurves = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_OPTIMIZE_EMPTY_ANIMATION_CURVES, true);
+	settings.animationKeyTolerance = pImp->GetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_KEY_TOLERANCE, 0.f);
+	settings.animationRotationKeyTolerance = pImp->GetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_ROTATION_KEY_TOLERANCE, 0.f);
 	settings.useLegacyEmbeddedTextureNaming = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_EMBEDDED_TEXTURES_LEGACY_NAMING, false);
 	settings.removeEmptyBones = pImp->GetPropertyBool(AI_CONFIG_IMPORT_REMOVE_EMPTY_BONES, true);
 	settings.convertToMeters = pImp->GetPropertyBool(AI_CONFIG_FBX_CONVERT_TO_M, false);
@@ -157,52 +161,66 @@ void FBXImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 	// then becomes very large, too. Assimp doesn't support
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
-	std::vector<char> contents;
-	contents.resize(stream->FileSize() + 1);
-	stream->Read(&*contents.begin(), 1, contents.size() - 1);
-	contents[contents.size() - 1] = 0;
-	const char *const begin = &*contents.begin();
+	// If the stream is memory-mapped, binary files are tokenized in place.
+	// The text tokenizer relies on a terminating null character, so it
+	// always works on a copy.
+	if (m_profiler) {
+		m_profiler->BeginRegion("read");
+	}
+	IOStreamView contents;
+	contents.load(stream.get(), false);
+	const bool is_binary = contents.size() >= 18 && !strncmp(contents.data(), "Kaydara FBX Binary", 18);
+	if (!is_binary && contents.isMapped()) {
+		contents.load(stream.get(), true);
+	}
+	const char *const begin = contents.data();
+	if (m_profiler) {
+		m_profiler->EndRegion("read");
+	}
 
 	// broadphase tokenizing pass in which we identify the core
 	// syntax elements of FBX (brackets, commas, key:value mappings)
 	TokenList tokens;
-	try {
-
-		bool is_binary = false;
-		if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
-			is_binary = true;
-			TokenizeBinary(tokens, begin, contents.size());
-		} else {
-			Tokenize(tokens, begin);
-		}
-
-		// use this information to construct a very rudimentary
-		// parse-tree representing the FBX scope structure
-		Parser parser(tokens, is_binary);
-
-		// take the raw parse-tree and convert it to a FBX DOM
-		Document doc(parser, settings);
-
-		// convert the FBX DOM to aiScene
-		ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones);
-
-		// size relative to cm
-		float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
-        if (size_relative_to_cm == 0.0)
-        {
-			// BaseImporter later asserts that fileScale is non-zero.
-			ThrowException("The UnitScaleFactor must be non-zero");
-        }
-
-		// Set FBX file scale is relative to CM must be converted to M for
-		// assimp universal format (M)
-		SetFileScale(size_relative_to_cm * 0.01f);
-
-		std::for_each(tokens.begin(), tokens.end(), Util::delete_fun<Token>());
-	} catch (std::exception &) {
-		std::for_each(tokens.begin(), tokens.end(), Util::delete_fun<Token>());
-		throw;
+	if (m_profiler) {
+		m_profiler->BeginRegion("parse");
+	}
+
+	if (is_binary) {
+		TokenizeBinary(tokens, begin, contents.size());
+	} else {
+		Tokenize(tokens, begin);
 	}
+
+	// use this information to construct a very rudimentary
+	// parse-tree representing the FBX scope structure
+	Parser parser(tokens, is_binary, m_threadPool);
+
+	// take the raw parse-tree and convert it to a FBX DOM
+	Document doc(parser, settings);
+
+	if (m_profiler) {
+		m_profiler->EndRegion("parse");
+		m_profiler->BeginRegion("convert");
+	}
+
+	// convert the FBX DOM to aiScene
+	ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones, m_threadPool);
+
+	if (m_profiler) {
+		m_profiler->EndRegion("convert");
+	}
+
+	// size relative to cm
+	float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
+	if (size_relative_to_cm == 0.0)
+	{
+		// BaseImporter later asserts that fileScale is non-zero.
+		ThrowException("The UnitScaleFactor must be non-zero");
+	}
+
+	// Set FBX file scale is relative to CM must be converted to M for
+	// assimp universal format (M)
+	SetFileScale(size_relative_to_cm * 0.01f);
 }
 
 #endif // !ASSIMP_BUILD_NO_FBX_IMPORTER
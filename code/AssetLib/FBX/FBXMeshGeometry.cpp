@@ -60,6 +60,26 @@ namespace FBX {
 
 using namespace Util;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// collect the data arrays of a geometry scope including its layer elements.
+// The edge list is skipped as it is never read.
+void CollectDataArrays(const Scope& sc, std::vector<const Element*>& out) {
+    for (const ElementMap::value_type& v : sc.Elements()) {
+        if (v.first == "Edges") {
+            continue;
+        }
+        if (v.second->Compound()) {
+            CollectDataArrays(*v.second->Compound(), out);
+        } else {
+            out.push_back(v.second);
+        }
+    }
+}
+
+} // !anon
+
 // ------------------------------------------------------------------------------------------------
 Geometry::Geometry(uint64_t id, const Element& element, const std::string& name, const Document& doc)
     : Object(id, element, name)
@@ -103,6 +123,11 @@ MeshGeometry::MeshGeometry(uint64_t id, const Element& element, const std::strin
         DOMError("failed to read Geometry object (class: Mesh), no data scope found");
     }
 
+    // inflate the compressed arrays of the mesh concurrently, they are read one by one below
+    std::vector<const Element*> arrays;
+    CollectDataArrays(*sc, arrays);
+    element.GetParser().PrefetchArrays(arrays);
+
     // must have Mesh elements:
     const Element& Vertices = GetRequiredElement(*sc,"Vertices",&element);
     const Element& PolygonVertexIndex = GetRequiredElement(*sc,"PolygonVertexIndex",&element);
@@ -172,7 +197,7 @@ MeshGeometry::MeshGeometry(uint64_t id, const Element& element, const std::strin
     // if settings.readAllLayers is false:
     //  * read only the layer with index 0, but warn about any further layers
     for (ElementMap::const_iterator it = Layer.first; it != Layer.second; ++it) {
-        const TokenList& tokens = (*it).second->Tokens();
+        const TokenRange& tokens = (*it).second->Tokens();
 
         const char* err;
         const int index = ParseTokenAsInt(*tokens[0], err);
@@ -675,6 +700,7 @@ ShapeGeometry::ShapeGeometry(uint64_t id, const Element& element, const std::str
     const Element& Indexes = GetRequiredElement(*sc, "Indexes", &element);
     const Element& Normals = GetRequiredElement(*sc, "Normals", &element);
     const Element& Vertices = GetRequiredElement(*sc, "Vertices", &element);
+    element.GetParser().PrefetchArrays({ &Indexes, &Normals, &Vertices });
     ParseVectorDataArray(m_indices, Indexes);
     ParseVectorDataArray(m_vertices, Vertices);
     ParseVectorDataArray(m_normals, Normals);
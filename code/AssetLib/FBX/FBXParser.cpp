@@ -61,6 +61,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ByteSwapper.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include "Common/ThreadPool.h"
+
 #include <iostream>
 
 using namespace Assimp;
@@ -117,6 +119,9 @@ namespace FBX {
 // ------------------------------------------------------------------------------------------------
 Element::Element(const Token& key_token, Parser& parser)
 : key_token(key_token)
+, parser(parser)
+, first_token(static_cast<unsigned int>(parser.element_tokens.size()))
+, num_tokens()
 {
     TokenPtr n = nullptr;
     do {
@@ -126,7 +131,8 @@ Element::Element(const Token& key_token, Parser& parser)
         }
 
         if (n->Type() == TokenType_DATA) {
-            tokens.push_back(n);
+            parser.AddElementToken();
+            ++num_tokens;
 			TokenPtr prev = n;
             n = parser.AdvanceToNextToken();
             if(!n) {
@@ -137,7 +143,8 @@ Element::Element(const Token& key_token, Parser& parser)
 
 			// some exporters are missing a comma on the next line
 			if (ty == TokenType_DATA && prev->Type() == TokenType_DATA && (n->Line() == prev->Line() + 1)) {
-				tokens.push_back(n);
+				parser.AddElementToken();
+				++num_tokens;
 				continue;
 			}
 
@@ -170,6 +177,15 @@ Element::~Element()
      // no need to delete tokens, they are owned by the parser
 }
 
+// ------------------------------------------------------------------------------------------------
+TokenRange Element::Tokens() const
+{
+    if (!num_tokens) {
+        return TokenRange();
+    }
+    return TokenRange(parser.tokens.data(), parser.element_tokens.data() + first_token, num_tokens);
+}
+
 // ------------------------------------------------------------------------------------------------
 Scope::Scope(Parser& parser,bool topLevel)
 {
@@ -214,14 +230,18 @@ Scope::~Scope()
 }
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenList& tokens, bool is_binary, ThreadPool* threadPool)
 : tokens(tokens)
 , last()
 , current()
-, cursor(tokens.begin())
+, cursor()
 , is_binary(is_binary)
+, thread_pool(threadPool)
 {
     ASSIMP_LOG_DEBUG("Parsing FBX tokens");
+
+    // data tokens and the commas between them make up most of the file
+    element_tokens.reserve(tokens.size() / 2);
     root.reset(new Scope(*this,true));
 }
 
@@ -235,14 +255,21 @@ Parser::~Parser()
 TokenPtr Parser::AdvanceToNextToken()
 {
     last = current;
-    if (cursor == tokens.end()) {
+    if (cursor == tokens.size()) {
         current = nullptr;
     } else {
-        current = *cursor++;
+        current = &tokens[cursor++];
     }
     return current;
 }
 
+// ------------------------------------------------------------------------------------------------
+void Parser::AddElementToken()
+{
+    ai_assert(current);
+    element_tokens.push_back(static_cast<unsigned int>(current - tokens.data()));
+}
+
 // ------------------------------------------------------------------------------------------------
 TokenPtr Parser::CurrentToken() const
 {
@@ -521,10 +548,63 @@ void ReadBinaryDataArrayHead(const char*& data, const char* end, char& type, uin
 
 
 // ------------------------------------------------------------------------------------------------
-// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header)
-void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
+// size of one element of a binary data array, 0 for unknown types
+uint32_t BinaryDataArrayStride(char type)
+{
+    switch(type)
+    {
+        case 'f':
+        case 'i':
+            return 4;
+
+        case 'd':
+        case 'l':
+            return 8;
+
+        default:
+            return 0;
+    };
+}
+
+// ------------------------------------------------------------------------------------------------
+// inflate zlib/deflate compressed data, buff must be sized to the uncompressed length
+void InflateDataArray(const char* data, uint32_t comp_len, std::vector<char>& buff)
+{
+    // next comes ZIP head (0x78 0x01)
+    // see http://www.ietf.org/rfc/rfc1950.txt
+
+    z_stream zstream;
+    zstream.opaque = Z_NULL;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree  = Z_NULL;
+    zstream.data_type = Z_BINARY;
+
+    // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
+    if(Z_OK != inflateInit(&zstream)) {
+        ParseError("failure initializing zlib");
+    }
+
+    zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
+    zstream.avail_in  = comp_len;
+
+    zstream.avail_out = static_cast<uInt>(buff.size());
+    zstream.next_out = reinterpret_cast<Bytef*>(buff.data());
+    const int ret = inflate(&zstream, Z_FINISH);
+
+    // terminate zlib
+    inflateEnd(&zstream);
+
+    if (ret != Z_STREAM_END && ret != Z_OK) {
+        ParseError("failure decompressing compressed data section");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header).
+// Plain data is copied to buff, compressed data is inflated into buff unless it was prefetched.
+const std::vector<char>& ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
     std::vector<char>& buff,
-    const Element& /*el*/)
+    const Element& el)
 {
     BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
     AI_SWAP4(encmode);
@@ -538,60 +618,28 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
     ai_assert(data + comp_len == end);
 
     // determine the length of the uncompressed data by looking at the type signature
-    uint32_t stride = 0;
-    switch(type)
-    {
-        case 'f':
-        case 'i':
-            stride = 4;
-            break;
-
-        case 'd':
-        case 'l':
-            stride = 8;
-            break;
-
-        default:
-            ai_assert(false);
-    };
+    const uint32_t stride = BinaryDataArrayStride(type);
+    ai_assert(stride > 0);
 
     const uint32_t full_length = stride * count;
-    buff.resize(full_length);
+
+    const char* const begin = data;
+    data += comp_len;
+    ai_assert(data == end);
 
     if(encmode == 0) {
         ai_assert(full_length == comp_len);
 
         // plain data, no compression
-        std::copy(data, end, buff.begin());
+        buff.assign(begin, end);
+        return buff;
     }
     else if(encmode == 1) {
-        // zlib/deflate, next comes ZIP head (0x78 0x01)
-        // see http://www.ietf.org/rfc/rfc1950.txt
-
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        if(Z_OK != inflateInit(&zstream)) {
-            ParseError("failure initializing zlib");
-        }
-
-        zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
-        zstream.avail_in  = comp_len;
-
-        zstream.avail_out = static_cast<uInt>(buff.size());
-        zstream.next_out = reinterpret_cast<Bytef*>(&*buff.begin());
-        const int ret = inflate(&zstream, Z_FINISH);
-
-        if (ret != Z_STREAM_END && ret != Z_OK) {
-            ParseError("failure decompressing compressed data section");
+        if (!el.GetParser().TakeInflatedArray(begin, buff)) {
+            buff.resize(full_length);
+            InflateDataArray(begin, comp_len, buff);
         }
-
-        // terminate zlib
-        inflateEnd(&zstream);
+        return buff;
     }
 #ifdef ASSIMP_BUILD_DEBUG
     else {
@@ -599,13 +647,83 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
         ai_assert(false);
     }
 #endif
-
-    data += comp_len;
-    ai_assert(data == end);
+    return buff;
 }
 
 } // !anon
 
+// ------------------------------------------------------------------------------------------------
+void Parser::PrefetchArrays(const std::vector<const Element*>& elements) const
+{
+    if (nullptr == thread_pool) {
+        return;
+    }
+
+    struct CompressedArray {
+        const char* data;
+        uint32_t comp_len;
+        uint32_t full_length;
+    };
+
+    std::vector<CompressedArray> pending;
+    {
+        std::lock_guard<std::mutex> lock(inflated_mutex);
+        for (const Element* el : elements) {
+            const TokenRange& tok = el->Tokens();
+            if (tok.empty() || !tok[0]->IsBinary() || tok[0]->end() - tok[0]->begin() < 13) {
+                continue;
+            }
+
+            const char* data = tok[0]->begin(), *end = tok[0]->end();
+            char type;
+            uint32_t count;
+            ReadBinaryDataArrayHead(data, end, type, count, *el);
+
+            BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
+            AI_SWAP4(encmode);
+            BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(data + 4, end);
+            AI_SWAP4(comp_len);
+            data += 8;
+
+            // anything unusual is left to ParseVectorDataArray() to report
+            const uint32_t stride = BinaryDataArrayStride(type);
+            if (encmode != 1 || !stride || !count || static_cast<size_t>(end - data) != comp_len || inflated.count(data)) {
+                continue;
+            }
+            pending.push_back({ data, comp_len, stride * count });
+        }
+    }
+
+    if (pending.size() < 2) {
+        return;
+    }
+
+    std::vector< std::vector<char> > buffers(pending.size());
+    thread_pool->ParallelFor(pending.size(), [&pending, &buffers](size_t i) {
+        buffers[i].resize(pending[i].full_length);
+        InflateDataArray(pending[i].data, pending[i].comp_len, buffers[i]);
+    });
+
+    std::lock_guard<std::mutex> lock(inflated_mutex);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        inflated.emplace(pending[i].data, std::move(buffers[i]));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Parser::TakeInflatedArray(const char* data, std::vector<char>& out) const
+{
+    std::lock_guard<std::mutex> lock(inflated_mutex);
+    const auto it = inflated.find(data);
+    if (it == inflated.end()) {
+        return false;
+    }
+
+    // each prefetched array is consumed once, so it isn't kept next to the DOM copy
+    out = std::move(it->second);
+    inflated.erase(it);
+    return true;
+}
 
 // ------------------------------------------------------------------------------------------------
 // read an array of float3 tuples
@@ -613,7 +731,7 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
 {
     out.resize( 0 );
 
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -637,8 +755,8 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -688,7 +806,7 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
     if (a.Tokens().size() % 3 != 0) {
         ParseError("number of floats is not a multiple of three (3)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiVector3D v;
         v.x = ParseTokenAsFloat(**it++);
         v.y = ParseTokenAsFloat(**it++);
@@ -704,7 +822,7 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
 void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -728,8 +846,8 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -770,7 +888,7 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
     if (a.Tokens().size() % 4 != 0) {
         ParseError("number of floats is not a multiple of four (4)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiColor4D v;
         v.r = ParseTokenAsFloat(**it++);
         v.g = ParseTokenAsFloat(**it++);
@@ -787,7 +905,7 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
 void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -811,8 +929,8 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -852,7 +970,7 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
     if (a.Tokens().size() % 2 != 0) {
         ParseError("number of floats is not a multiple of two (2)",&el);
     }
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiVector2D v;
         v.x = ParseTokenAsFloat(**it++);
         v.y = ParseTokenAsFloat(**it++);
@@ -867,7 +985,7 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el)
 void ParseVectorDataArray(std::vector<int>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -887,8 +1005,8 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el)
             ParseError("expected int array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
@@ -917,7 +1035,7 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const int ival = ParseTokenAsInt(**it++);
         out.push_back(ival);
     }
@@ -929,7 +1047,7 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el)
 void ParseVectorDataArray(std::vector<float>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -949,8 +1067,8 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -983,7 +1101,7 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const float ival = ParseTokenAsFloat(**it++);
         out.push_back(ival);
     }
@@ -994,7 +1112,7 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
 void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -1014,8 +1132,8 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
             ParseError("expected (u)int array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
@@ -1048,7 +1166,7 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const int ival = ParseTokenAsInt(**it++);
         if(ival < 0) {
             ParseError("encountered negative integer index");
@@ -1063,7 +1181,7 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
 void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if(tok.empty()) {
         ParseError("unexpected empty element",&el);
     }
@@ -1083,8 +1201,8 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
             ParseError("expected long array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
@@ -1113,7 +1231,7 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const uint64_t ival = ParseTokenAsID(**it++);
 
         out.push_back(ival);
@@ -1125,7 +1243,7 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
 void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
 {
     out.resize( 0 );
-    const TokenList& tok = el.Tokens();
+    const TokenRange& tok = el.Tokens();
     if (tok.empty()) {
         ParseError("unexpected empty element", &el);
     }
@@ -1145,8 +1263,8 @@ void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
             ParseError("expected long array (binary)", &el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> scratch;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, scratch, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
@@ -1175,7 +1293,7 @@ void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope, "a", &el);
 
-    for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end;) {
+    for (TokenRange::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end;) {
         const int64_t ival = ParseTokenAsInt64(**it++);
 
         out.push_back(ival);
@@ -1270,7 +1388,7 @@ const Scope& GetRequiredScope(const Element& el)
 // get token at a particular index
 const Token& GetRequiredToken(const Element& el, unsigned int index)
 {
-    const TokenList& t = el.Tokens();
+    const TokenRange& t = el.Tokens();
     if(index >= t.size()) {
         ParseError(Formatter::format( "missing token at index " ) << index,&el);
     }
@@ -48,6 +48,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <assimp/LogAux.h>
 #include <assimp/fast_atof.h>
@@ -56,6 +58,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 
 namespace Assimp {
+
+class ThreadPool;
+
 namespace FBX {
 
 class Scope;
@@ -97,13 +102,19 @@ public:
         return key_token;
     }
 
-    const TokenList& Tokens() const {
-        return tokens;
+    TokenRange Tokens() const;
+
+    const Parser& GetParser() const {
+        return parser;
     }
 
 private:
     const Token& key_token;
-    TokenList tokens;
+    const Parser& parser;
+
+    // range of the data tokens of the element in Parser::element_tokens
+    unsigned int first_token;
+    unsigned int num_tokens;
     std::unique_ptr<Scope> compound;
 };
 
@@ -158,8 +169,10 @@ class Parser
 {
 public:
     /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+     *  the objects must persist during the entire parser lifetime.
+     *  threadPool is used to inflate compressed arrays concurrently,
+     *  nullptr to inflate them one by one as they are read. */
+    Parser (const TokenList& tokens,bool is_binary, ThreadPool* threadPool = nullptr);
     ~Parser();
 
     const Scope& GetRootScope() const {
@@ -170,6 +183,17 @@ public:
         return is_binary;
     }
 
+    /** Inflate the zlib-compressed binary arrays of the given elements
+     *  concurrently on the worker pool. Does nothing without a pool, the
+     *  arrays are then inflated by ParseVectorDataArray() on demand. */
+    void PrefetchArrays(const std::vector<const Element*>& elements) const;
+
+    /** Move the contents of a compressed binary array inflated by
+     *  PrefetchArrays() to out and drop it from the cache.
+     *  Safe to call concurrently.
+     *  @return false if the array wasn't prefetched. */
+    bool TakeInflatedArray(const char* data, std::vector<char>& out) const;
+
 private:
     friend class Scope;
     friend class Element;
@@ -178,14 +202,28 @@ private:
     TokenPtr LastToken() const;
     TokenPtr CurrentToken() const;
 
+    // add the current token to the data tokens of the element being parsed
+    void AddElementToken();
+
 private:
     const TokenList& tokens;
 
     TokenPtr last, current;
-    TokenList::const_iterator cursor;
+    size_t cursor;
+
+    // indices of the data tokens of all elements, stored back to back
+    std::vector<unsigned int> element_tokens;
+
     std::unique_ptr<Scope> root;
 
     const bool is_binary;
+
+    ThreadPool* thread_pool;
+
+    // compressed arrays inflated ahead of use by PrefetchArrays(), keyed by
+    // the start of their compressed data, until ParseVectorDataArray() takes them
+    mutable std::unordered_map<const char*, std::vector<char> > inflated;
+    mutable std::mutex inflated_mutex;
 };
 
 
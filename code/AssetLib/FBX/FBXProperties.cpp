@@ -69,7 +69,7 @@ Property::~Property()
 
 namespace {
 
-void checkTokenCount(const TokenList& tok, unsigned int expectedCount)
+void checkTokenCount(const TokenRange& tok, unsigned int expectedCount)
 {
     ai_assert(expectedCount >= 2);
     if (tok.size() < expectedCount) {
@@ -89,7 +89,7 @@ Property* ReadTypedProperty(const Element& element)
 {
     ai_assert(element.KeyToken().StringContents() == "P");
 
-    const TokenList& tok = element.Tokens();
+    const TokenRange& tok = element.Tokens();
     if (tok.size() < 2) {
         return nullptr;
     }
@@ -153,7 +153,7 @@ Property* ReadTypedProperty(const Element& element)
 std::string PeekPropertyName(const Element& element)
 {
     ai_assert(element.KeyToken().StringContents() == "P");
-    const TokenList& tok = element.Tokens();
+    const TokenRange& tok = element.Tokens();
     if(tok.size() < 4) {
         return std::string();
     }
@@ -154,11 +154,97 @@ private:
     const unsigned int column;
 };
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
 typedef const Token* TokenPtr;
-typedef std::vector< TokenPtr > TokenList;
 
-#define new_Token new Token
+/** All tokens of a file, stored back to back in the order they were read.
+ *  Tokens are addressed by their index, pointers to them stay valid as long
+ *  as the list is not modified after tokenizing. */
+typedef std::vector< Token > TokenList;
+
+/** Read-only view of a subset of the tokens in a #TokenList, given as
+ *  a range of indices into the list. Used by #Element to refer to its
+ *  data tokens without copying pointers into a container of its own. */
+class TokenRange
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(const Token* tokens, const unsigned int* index)
+            : tokens(tokens)
+            , index(index)
+        {}
+
+        TokenPtr operator*() const {
+            return tokens + *index;
+        }
+
+        const_iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator it = *this;
+            ++index;
+            return it;
+        }
+
+        const_iterator operator+(size_t n) const {
+            return const_iterator(tokens, index + n);
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return index != other.index;
+        }
+
+    private:
+        const Token* tokens;
+        const unsigned int* index;
+    };
+
+    TokenRange()
+        : tokens()
+        , indices()
+        , count()
+    {}
+
+    TokenRange(const Token* tokens, const unsigned int* indices, size_t count)
+        : tokens(tokens)
+        , indices(indices)
+        , count(count)
+    {}
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    TokenPtr operator[](size_t i) const {
+        ai_assert(i < count);
+        return tokens + indices[i];
+    }
+
+    const_iterator begin() const {
+        return const_iterator(tokens, indices);
+    }
+
+    const_iterator end() const {
+        return const_iterator(tokens, indices + count);
+    }
+
+private:
+    const Token* tokens;
+    const unsigned int* indices;
+    size_t count;
+};
 
 
 /** Main FBX tokenizer function. Transform input buffer into a list of preprocessed tokens.
@@ -70,6 +70,14 @@ static const aiImporterDesc desc = {
     "hmp"
 };
 
+static const uint32_t magicTokenData[] = {
+    AI_HMP_MAGIC_NUMBER_LE_4,
+    AI_HMP_MAGIC_NUMBER_LE_5,
+    AI_HMP_MAGIC_NUMBER_LE_7
+};
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 3, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 HMPImporter::HMPImporter() {
@@ -91,15 +99,17 @@ bool HMPImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
 
     // if check for extension is not enough, check for the magic tokens
     if (!extension.length() || cs) {
-        uint32_t tokens[3];
-        tokens[0] = AI_HMP_MAGIC_NUMBER_LE_4;
-        tokens[1] = AI_HMP_MAGIC_NUMBER_LE_5;
-        tokens[2] = AI_HMP_MAGIC_NUMBER_LE_7;
-        return CheckMagicToken(pIOHandler, pFile, tokens, 3, 0);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *HMPImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get list of all file extensions that are handled by this loader
 const aiImporterDesc *HMPImporter::GetInfo() const {
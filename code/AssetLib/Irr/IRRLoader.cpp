@@ -82,7 +82,7 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 IRRImporter::IRRImporter() :
-		fps(), configSpeedFlag() {
+		fps(), configSpeedFlag(), configNumThreads() {
 	// empty
 }
 
@@ -129,6 +129,9 @@ void IRRImporter::SetupProperties(const Importer *pImp) {
 
 	// AI_CONFIG_FAVOUR_SPEED
 	configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 0));
+
+	// AI_CONFIG_GLOB_MULTITHREADING
+	configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -888,6 +891,7 @@ void IRRImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
 	// Batch loader used to load external models
 	BatchLoader batch(pIOHandler);
+	batch.setNumThreads(configNumThreads);
 	//  batch.SetBasePath(pFile);
 
 	cameras.reserve(5);
@@ -278,6 +278,9 @@ private:
 
     /// Configuration option: speed flag was set?
     bool configSpeedFlag;
+
+    /// Configuration option: threads used to load external meshes
+    int configNumThreads;
 };
 
 } // end of namespace Assimp
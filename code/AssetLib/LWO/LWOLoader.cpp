@@ -78,6 +78,14 @@ static const aiImporterDesc desc = {
     "lwo lxo"
 };
 
+static const uint32_t magicTokenData[] = {
+    AI_LWO_FOURCC_LWOB,
+    AI_LWO_FOURCC_LWO2,
+    AI_LWO_FOURCC_LXOB
+};
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 3, 8, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 LWOImporter::LWOImporter() :
@@ -113,15 +121,17 @@ bool LWOImporter::CanRead(const std::string &file, IOSystem *pIOHandler, bool ch
 
     // if check for extension is not enough, check for the magic tokens
     if (!extension.length() || checkSig) {
-        uint32_t tokens[3];
-        tokens[0] = AI_LWO_FOURCC_LWOB;
-        tokens[1] = AI_LWO_FOURCC_LWO2;
-        tokens[2] = AI_LWO_FOURCC_LXOB;
-        return CheckMagicToken(pIOHandler, file, tokens, 3, 8);
+        return CheckMagicTokens(pIOHandler, file);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *LWOImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void LWOImporter::SetupProperties(const Importer *pImp) {
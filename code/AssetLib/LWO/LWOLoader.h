@@ -83,6 +83,11 @@ public:
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler,
         bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format.
+     * See BaseImporter::GetMagicTokens() for details. */
+    const MagicTokenInfo *GetMagicTokens() const;
+
     // -------------------------------------------------------------------
     /** Called prior to ReadFile().
     * The function is a request to the importer to update its configuration
@@ -76,6 +76,10 @@ static const aiImporterDesc desc = {
     "lws mot"
 };
 
+static const uint32_t magicTokenData[] = { AI_MAKE_MAGIC("LWSC"), AI_MAKE_MAGIC("LWMO") };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 2, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Recursive parsing of LWS files
 void LWS::Element::Parse(const char *&buffer) {
@@ -135,7 +139,8 @@ LWSImporter::LWSImporter() :
         first(),
         last(),
         fps(),
-        noSkeletonMesh() {
+        noSkeletonMesh(),
+        configNumThreads() {
     // nothing to do here
 }
 
@@ -155,14 +160,17 @@ bool LWSImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
 
     // if check for extension is not enough, check for the magic tokens LWSC and LWMO
     if (!extension.length() || checkSig) {
-        uint32_t tokens[2];
-        tokens[0] = AI_MAKE_MAGIC("LWSC");
-        tokens[1] = AI_MAKE_MAGIC("LWMO");
-        return CheckMagicToken(pIOHandler, pFile, tokens, 2);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *LWSImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get list of file extensions
 const aiImporterDesc *LWSImporter::GetInfo() const {
@@ -188,6 +196,9 @@ void LWSImporter::SetupProperties(const Importer *pImp) {
     }
 
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, 0) != 0;
+
+    // AI_CONFIG_GLOB_MULTITHREADING
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -516,6 +527,7 @@ void LWSImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     // Construct a Batch-importer to read more files recursively
     BatchLoader batch(pIOHandler);
+    batch.setNumThreads(configNumThreads);
 
     // Construct an array to receive the flat output graph
     std::list<LWS::NodeDesc> nodes;
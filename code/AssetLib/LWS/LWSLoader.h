@@ -179,6 +179,11 @@ public:
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler,
             bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format.
+     * See BaseImporter::GetMagicTokens() for details. */
+    const MagicTokenInfo *GetMagicTokens() const;
+
 protected:
     // -------------------------------------------------------------------
     // Get list of supported extensions
@@ -230,6 +235,8 @@ private:
     double first, last, fps;
 
     bool noSkeletonMesh;
+
+    int configNumThreads;
 };
 
 } // end of namespace Assimp
@@ -57,6 +57,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 
 #include "M3DImporter.h"
+#include "Common/FileHeaderCache.h"
 #include "M3DMaterials.h"
 #include "M3DWrapper.h"
 
@@ -129,9 +130,8 @@ bool M3DImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
         const char* tokens[] = {"3DMO", "3dmo"};
         return CheckMagicToken(pIOHandler,pFile,tokens,2,0,4);
         */
-        std::unique_ptr<IOStream> pStream(pIOHandler->Open(pFile, "rb"));
         unsigned char data[4];
-        if (!pStream || 4 != pStream->Read(data, 1, 4)) {
+        if (4 != FileHeaderCache::ReadHeader(pIOHandler, pFile, data, 4)) {
             return false;
         }
         return !memcmp(data, "3DMO", 4) /* bin */
@@ -78,6 +78,10 @@ static const aiImporterDesc desc = {
     "md2"
 };
 
+static const uint32_t magicTokenData[] = { AI_MD2_MAGIC_NUMBER_LE };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 1, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Helper function to lookup a normal in Quake 2's precalculated table
 void MD2::LookupNormalIndex(uint8_t iNormalIndex,aiVector3D& vOut)
@@ -115,13 +119,17 @@ bool MD2Importer::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
     // if check for extension is not enough, check for the magic tokens
     if (!extension.length() || checkSig) {
-        uint32_t tokens[1];
-        tokens[0] = AI_MD2_MAGIC_NUMBER_LE;
-        return CheckMagicToken(pIOHandler,pFile,tokens,1);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *MD2Importer::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a list of all extensions supported by this loader
 const aiImporterDesc* MD2Importer::GetInfo () const
@@ -83,6 +83,10 @@ static const aiImporterDesc desc = {
     "md3"
 };
 
+static const uint32_t magicTokenData[] = { AI_MD3_MAGIC_NUMBER_LE };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 1, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Convert a Q3 shader blend function to the appropriate enum value
 Q3Shader::BlendFunc StringToBlendFunc(const std::string &m) {
@@ -341,7 +345,7 @@ void Q3Shader::ConvertShaderToMaterial(aiMaterial *out, const ShaderDataBlock &s
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 MD3Importer::MD3Importer() :
-        configFrameID(0), configHandleMP(true), configSpeedFlag(), pcHeader(), mBuffer(), fileSize(), mScene(), mIOHandler() {}
+        configFrameID(0), configHandleMP(true), configSpeedFlag(), configNumThreads(), pcHeader(), mBuffer(), fileSize(), mScene(), mIOHandler() {}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -356,13 +360,17 @@ bool MD3Importer::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
 
     // if check for extension is not enough, check for the magic tokens
     if (!extension.length() || checkSig) {
-        uint32_t tokens[1];
-        tokens[0] = AI_MD3_MAGIC_NUMBER_LE;
-        return CheckMagicToken(pIOHandler, pFile, tokens, 1);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *MD3Importer::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 void MD3Importer::ValidateHeaderOffsets() {
     // Check magic number
@@ -458,6 +466,9 @@ void MD3Importer::SetupProperties(const Importer *pImp) {
 
     // AI_CONFIG_FAVOUR_SPEED
     configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 0));
+
+    // AI_CONFIG_GLOB_MULTITHREADING
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -557,6 +568,7 @@ bool MD3Importer::ReadMultipartFile() {
 
         // now read these three files
         BatchLoader batch(mIOHandler);
+        batch.setNumThreads(configNumThreads);
         const unsigned int _lower = batch.AddLoadRequest(lower, 0, &props);
         const unsigned int _upper = batch.AddLoadRequest(upper, 0, &props);
         const unsigned int _head = batch.AddLoadRequest(head, 0, &props);
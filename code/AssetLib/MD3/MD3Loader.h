@@ -230,6 +230,11 @@ public:
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler,
         bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format.
+     * See BaseImporter::GetMagicTokens() for details. */
+    const MagicTokenInfo *GetMagicTokens() const;
+
 
     // -------------------------------------------------------------------
     /** Called prior to ReadFile().
@@ -306,6 +311,9 @@ protected:
     /** Configuration option: speed flag was set? */
     bool configSpeedFlag;
 
+    /** Configuration option: threads used to load the parts */
+    int configNumThreads;
+
     /** Header of the MD3 file */
     BE_NCONST MD3::Header* pcHeader;
 
@@ -73,6 +73,10 @@ static const aiImporterDesc desc = {
     "mdc"
 };
 
+static const uint32_t magicTokenData[] = { AI_MDC_MAGIC_NUMBER_LE };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 1, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 void MDC::BuildVertex(const Frame &frame,
         const BaseVertex &bvert,
@@ -119,13 +123,17 @@ bool MDCImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
 
     // if check for extension is not enough, check for the magic tokens
     if (!extension.length() || checkSig) {
-        uint32_t tokens[1];
-        tokens[0] = AI_MDC_MAGIC_NUMBER_LE;
-        return CheckMagicToken(pIOHandler, pFile, tokens, 1);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *MDCImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *MDCImporter::GetInfo() const {
     return &desc;
@@ -78,6 +78,19 @@ static const aiImporterDesc desc = {
     "mdl"
 };
 
+static const uint32_t magicTokenData[] = {
+    AI_MDL_MAGIC_NUMBER_LE_HL2a,
+    AI_MDL_MAGIC_NUMBER_LE_HL2b,
+    AI_MDL_MAGIC_NUMBER_LE_GS7,
+    AI_MDL_MAGIC_NUMBER_LE_GS5b,
+    AI_MDL_MAGIC_NUMBER_LE_GS5a,
+    AI_MDL_MAGIC_NUMBER_LE_GS4,
+    AI_MDL_MAGIC_NUMBER_LE_GS3,
+    AI_MDL_MAGIC_NUMBER_LE
+};
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 8, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Ugly stuff ... nevermind
 #define _AI_MDL7_ACCESS(_data, _index, _limit, _type) \
@@ -109,20 +122,17 @@ bool MDLImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
 
     // if check for extension is not enough, check for the magic tokens
     if (extension == "mdl" || !extension.length() || checkSig) {
-        uint32_t tokens[8];
-        tokens[0] = AI_MDL_MAGIC_NUMBER_LE_HL2a;
-        tokens[1] = AI_MDL_MAGIC_NUMBER_LE_HL2b;
-        tokens[2] = AI_MDL_MAGIC_NUMBER_LE_GS7;
-        tokens[3] = AI_MDL_MAGIC_NUMBER_LE_GS5b;
-        tokens[4] = AI_MDL_MAGIC_NUMBER_LE_GS5a;
-        tokens[5] = AI_MDL_MAGIC_NUMBER_LE_GS4;
-        tokens[6] = AI_MDL_MAGIC_NUMBER_LE_GS3;
-        tokens[7] = AI_MDL_MAGIC_NUMBER_LE;
-        return CheckMagicToken(pIOHandler, pFile, tokens, 8, 0);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *MDLImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void MDLImporter::SetupProperties(const Importer *pImp) {
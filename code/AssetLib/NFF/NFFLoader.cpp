@@ -1013,7 +1013,7 @@ void NFFImporter::InternReadFile(const std::string &pFile,
             *ppcChildren = nd;
             nd->mParent = root;
 
-            nd->mName.length = ::ai_snprintf(nd->mName.data, 1024, "<NFF_Light%u>", i);
+            nd->mName.length = ::ai_snprintf(nd->mName.data, MAXLEN, "<NFF_Light%u>", i);
 
             // allocate the light in the scene data structure
             aiLight *out = pScene->mLights[i] = new aiLight();
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileParser.h"
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/IOStreamBuffer.h>
+#include <assimp/Profiler.h>
 #include <assimp/ai_assert.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
@@ -143,10 +144,22 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
     }
 
     // parse the file into a temporary representation
+    if (m_profiler) {
+        m_profiler->BeginRegion("parse");
+    }
     ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    if (m_profiler) {
+        m_profiler->EndRegion("parse");
+    }
 
     // And create the proper return structures out of it
+    if (m_profiler) {
+        m_profiler->BeginRegion("convert");
+    }
     CreateDataFromImport(parser.GetModel(), pScene);
+    if (m_profiler) {
+        m_profiler->EndRegion("convert");
+    }
 
     streamedBuffer.close();
 
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <utility>
@@ -101,8 +102,8 @@ ObjFileParser::~ObjFileParser() {
 }
 
 void ObjFileParser::setBuffer(std::vector<char> &buffer) {
-    m_DataIt = buffer.begin();
-    m_DataItEnd = buffer.end();
+    m_DataIt = buffer.data();
+    m_DataItEnd = buffer.data() + buffer.size();
 }
 
 ObjFile::Model *ObjFileParser::GetModel() const {
@@ -118,10 +119,11 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     unsigned int processed = 0;
     size_t lastFilePos(0);
 
-    std::vector<char> buffer;
-    while (streamBuffer.getNextDataLine(buffer, '\\')) {
-        m_DataIt = buffer.begin();
-        m_DataItEnd = buffer.end();
+    // The lines are parsed in place, the line end is part of the range
+    char *lineBegin = nullptr, *lineEnd = nullptr;
+    while (streamBuffer.getNextDataLine(lineBegin, lineEnd, '\\')) {
+        m_DataIt = lineBegin;
+        m_DataItEnd = lineEnd + 1;
 
         // Handle progress reporting
         const size_t filePos(streamBuffer.getFilePos());
@@ -249,6 +251,15 @@ void ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
     pBuffer[index] = '\0';
 }
 
+void ObjFileParser::getRealValues(ai_real *values, size_t count) {
+    // The last character of the buffer is the line end. Unparsable values throw,
+    // missing trailing values default to zero.
+    const char *pCur = m_DataIt;
+    const size_t numParsed = fast_atoreal_array<ai_real>(&pCur, m_DataItEnd - 1, values, count);
+    std::fill(values + numParsed, values + count, static_cast<ai_real>(0.0));
+    m_DataIt += pCur - m_DataIt;
+}
+
 static bool isDataDefinitionEnd(const char *tmp) {
     if (*tmp == '\\') {
         tmp++;
@@ -292,114 +303,58 @@ size_t ObjFileParser::getNumComponentsInDataDefinition() {
 
 size_t ObjFileParser::getTexCoordVector(std::vector<aiVector3D> &point3d_array) {
     size_t numComponents = getNumComponentsInDataDefinition();
-    ai_real x, y, z;
-    if (2 == numComponents) {
-        copyNextWord(m_buffer, Buffersize);
-        x = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        y = (ai_real)fast_atof(m_buffer);
-        z = 0.0;
-    } else if (3 == numComponents) {
-        copyNextWord(m_buffer, Buffersize);
-        x = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        y = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        z = (ai_real)fast_atof(m_buffer);
+    ai_real v[3] = { 0.0, 0.0, 0.0 };
+    if (2 == numComponents || 3 == numComponents) {
+        getRealValues(v, numComponents);
     } else {
         throw DeadlyImportError("OBJ: Invalid number of components");
     }
 
     // Coerce nan and inf to 0 as is the OBJ default value
-    if (!std::isfinite(x))
-        x = 0;
-
-    if (!std::isfinite(y))
-        y = 0;
-
-    if (!std::isfinite(z))
-        z = 0;
+    for (ai_real &value : v) {
+        if (!std::isfinite(value))
+            value = 0;
+    }
 
-    point3d_array.emplace_back(x, y, z);
+    point3d_array.emplace_back(v[0], v[1], v[2]);
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
     return numComponents;
 }
 
 void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array) {
-    ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
+    ai_real v[3];
+    getRealValues(v, 3);
 
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
-
-    point3d_array.emplace_back(x, y, z);
+    point3d_array.emplace_back(v[0], v[1], v[2]);
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
 void ObjFileParser::getHomogeneousVector3(std::vector<aiVector3D> &point3d_array) {
-    ai_real x, y, z, w;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    w = (ai_real)fast_atof(m_buffer);
+    ai_real v[4];
+    getRealValues(v, 4);
 
-    if (w == 0)
+    if (v[3] == 0)
         throw DeadlyImportError("OBJ: Invalid component in homogeneous vector (Division by zero)");
 
-    point3d_array.emplace_back(x / w, y / w, z / w);
+    point3d_array.emplace_back(v[0] / v[3], v[1] / v[3], v[2] / v[3]);
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
 void ObjFileParser::getTwoVectors3(std::vector<aiVector3D> &point3d_array_a, std::vector<aiVector3D> &point3d_array_b) {
-    ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
+    ai_real v[6];
+    getRealValues(v, 6);
 
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
-
-    point3d_array_a.emplace_back(x, y, z);
-
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
-
-    point3d_array_b.emplace_back(x, y, z);
+    point3d_array_a.emplace_back(v[0], v[1], v[2]);
+    point3d_array_b.emplace_back(v[3], v[4], v[5]);
 
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
 void ObjFileParser::getVector2(std::vector<aiVector2D> &point2d_array) {
-    ai_real x, y;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
+    ai_real v[2];
+    getRealValues(v, 2);
 
-    point2d_array.emplace_back(x, y);
+    point2d_array.emplace_back(v[0], v[1]);
 
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
@@ -653,7 +608,10 @@ void ObjFileParser::getNewMaterial() {
     }
 
     char *pStart = &(*m_DataIt);
-    std::string strMat(pStart, *m_DataIt);
+    while (m_DataIt != m_DataItEnd && !IsSpaceOrNewLine(*m_DataIt)) {
+        ++m_DataIt;
+    }
+    std::string strMat(pStart, m_DataIt);
     while (m_DataIt != m_DataItEnd && IsSpaceOrNewLine(*m_DataIt)) {
         ++m_DataIt;
     }
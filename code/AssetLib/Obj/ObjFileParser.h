@@ -70,8 +70,8 @@ class ASSIMP_API ObjFileParser {
 public:
     static const size_t Buffersize = 4096;
     typedef std::vector<char> DataArray;
-    typedef std::vector<char>::iterator DataArrayIt;
-    typedef std::vector<char>::const_iterator ConstDataArrayIt;
+    typedef char *DataArrayIt;
+    typedef const char *ConstDataArrayIt;
 
 public:
     /// @brief  The default constructor.
@@ -93,6 +93,8 @@ protected:
     void parseFile(IOStreamBuffer<char> &streamBuffer);
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
+    /// Parses the following count reals on the line.
+    void getRealValues(ai_real *values, size_t count);
     /// Method to copy the new line.
     //    void copyNextLine(char *pBuffer, size_t length);
     /// Get the number of components in a line.
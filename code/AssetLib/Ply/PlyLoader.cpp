@@ -48,9 +48,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "PlyLoader.h"
 #include <assimp/IOStreamBuffer.h>
+#include <assimp/config.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <climits>
 #include <memory>
 
 using namespace ::Assimp;
@@ -88,7 +91,8 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mContiguousFaces(false) {
     // empty
 }
 
@@ -120,6 +124,11 @@ bool PLYImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::SetupProperties(const Importer *pImp) {
+    mContiguousFaces = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *PLYImporter::GetInfo() const {
     return &desc;
@@ -160,6 +169,9 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("File ", pFile, " is empty.");
     }
 
+    mFaceIndices.clear();
+    mFaceOffsets.clear();
+
     IOStreamBuffer<char> streamedBuffer(1024 * 1024);
     streamedBuffer.open(fileStream.get());
 
@@ -239,6 +251,10 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("Invalid .ply file: Unable to extract mesh data ");
     }
 
+    if (mContiguousFaces) {
+        StoreContiguousFaces();
+    }
+
     // if no face list is existing we assume that the vertex
     // list is containing a list of points
     bool pointsOnly = mGeneratedMesh->mFaces == nullptr ? true : false;
@@ -274,6 +290,27 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::StoreContiguousFaces() {
+    if (nullptr == mGeneratedMesh->mFaces || mFaceIndices.empty()) {
+        return;
+    }
+
+    mGeneratedMesh->mIndexBufferSize = static_cast<unsigned int>(mFaceIndices.size());
+    mGeneratedMesh->mIndexBuffer = new unsigned int[mFaceIndices.size()];
+    ::memcpy(mGeneratedMesh->mIndexBuffer, mFaceIndices.data(), mFaceIndices.size() * sizeof(unsigned int));
+    for (unsigned int i = 0; i < mFaceOffsets.size(); ++i) {
+        aiFace &face = mGeneratedMesh->mFaces[i];
+        if (UINT_MAX != mFaceOffsets[i] && nullptr == face.mIndices) {
+            face.mIndices = mGeneratedMesh->mIndexBuffer + mFaceOffsets[i];
+        }
+    }
+
+    mFaceIndices.clear();
+    mFaceOffsets.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
 void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos) {
     ai_assert(nullptr != pcElement);
     ai_assert(nullptr != instElement);
@@ -587,17 +624,32 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
         }
 
         if (!bIsTriStrip) {
+            unsigned int *faceIndices = mGeneratedMesh->mFaces[pos].mIndices;
+
             // parse the list of vertex indices
             if (0xFFFFFFFF != iProperty) {
                 const unsigned int iNum = (unsigned int)GetProperty(instElement->alProperties, iProperty).avList.size();
-                mGeneratedMesh->mFaces[pos].mNumIndices = iNum;
-                mGeneratedMesh->mFaces[pos].mIndices = new unsigned int[iNum];
+                aiFace &face = mGeneratedMesh->mFaces[pos];
+                delete[] face.mIndices;
+                face.mNumIndices = iNum;
+
+                // in contiguous mode the indices are collected and moved
+                // into the index buffer of the mesh once all faces are read
+                if (mContiguousFaces) {
+                    face.mIndices = nullptr;
+                    mFaceOffsets.resize(mGeneratedMesh->mNumFaces, UINT_MAX);
+                    mFaceOffsets[pos] = static_cast<unsigned int>(mFaceIndices.size());
+                    mFaceIndices.resize(mFaceIndices.size() + iNum);
+                    faceIndices = mFaceIndices.data() + mFaceOffsets[pos];
+                } else {
+                    faceIndices = face.mIndices = new unsigned int[iNum];
+                }
 
                 std::vector<PLY::PropertyInstance::ValueUnion>::const_iterator p =
                         GetProperty(instElement->alProperties, iProperty).avList.begin();
 
                 for (unsigned int a = 0; a < iNum; ++a, ++p) {
-                    mGeneratedMesh->mFaces[pos].mIndices[a] = PLY::PropertyInstance::ConvertTo<unsigned int>(*p, eType);
+                    faceIndices[a] = PLY::PropertyInstance::ConvertTo<unsigned int>(*p, eType);
                 }
             }
 
@@ -609,7 +661,7 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
             GetProperty(instElement->alProperties, iMaterialIndex).avList.front(), eType2);
         }*/
 
-            if (0xFFFFFFFF != iTextureCoord) {
+            if (0xFFFFFFFF != iTextureCoord && nullptr != faceIndices) {
                 const unsigned int iNum = (unsigned int)GetProperty(instElement->alProperties, iTextureCoord).avList.size();
 
                 //should be 6 coords
@@ -619,7 +671,7 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
                 if ((iNum / 3) == 2) // X Y coord
                 {
                     for (unsigned int a = 0; a < iNum; ++a, ++p) {
-                        unsigned int vindex = mGeneratedMesh->mFaces[pos].mIndices[a / 2];
+                        unsigned int vindex = faceIndices[a / 2];
                         if (vindex < mGeneratedMesh->mNumVertices) {
                             if (mGeneratedMesh->mTextureCoords[0] == nullptr) {
                                 mGeneratedMesh->mNumUVComponents[0] = 2;
@@ -73,6 +73,12 @@ public:
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler,
             bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+     * See BaseImporter::SetupProperties() for details.
+     */
+    void SetupProperties(const Importer *pImp);
+
     // -------------------------------------------------------------------
     /** Extract a vertex from the DOM
     */
@@ -97,6 +103,12 @@ protected:
     void InternReadFile(const std::string &pFile, aiScene *pScene,
             IOSystem *pIOHandler);
 
+    // -------------------------------------------------------------------
+    /** Move the face indices collected in contiguous mode into the
+     *  index buffer of the generated mesh
+     */
+    void StoreContiguousFaces();
+
     // -------------------------------------------------------------------
     /** Extract a material list from the DOM
     */
@@ -127,6 +139,17 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Store the face indices in one buffer,
+     *  see #AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES */
+    bool mContiguousFaces;
+
+    /** Face indices collected in contiguous mode */
+    std::vector<unsigned int> mFaceIndices;
+
+    /** Offset of the indices of each face in mFaceIndices,
+     *  UINT_MAX for faces with an index array of their own */
+    std::vector<unsigned int> mFaceOffsets;
 };
 
 } // end of namespace Assimp
@@ -556,13 +556,16 @@ bool PLY::ElementInstanceList::ParseInstanceList(
         }
     } else {
         const char *pCur = (const char *)&buffer[0];
+        std::vector<char>::const_iterator bufferLineEnd = std::find(buffer.begin(), buffer.end(), '\n');
+        const char *pEnd = bufferLineEnd != buffer.end() ? pCur + (bufferLineEnd - buffer.begin()) : nullptr;
+        char *lineBegin = nullptr, *lineEnd = nullptr;
         // be sure to have enough storage
         for (unsigned int i = 0; i < pcElement->NumOccur; ++i) {
             if (p_pcOut)
-                PLY::ElementInstance::ParseInstance(pCur, pcElement, &p_pcOut->alInstances[i]);
+                PLY::ElementInstance::ParseInstance(pCur, pEnd, pcElement, &p_pcOut->alInstances[i]);
             else {
                 ElementInstance elt;
-                PLY::ElementInstance::ParseInstance(pCur, pcElement, &elt);
+                PLY::ElementInstance::ParseInstance(pCur, pEnd, pcElement, &elt);
 
                 // Create vertex or face
                 if (pcElement->eSemantic == EEST_Vertex) {
@@ -577,8 +580,20 @@ bool PLY::ElementInstanceList::ParseInstanceList(
                 }
             }
 
-            streamBuffer.getNextLine(buffer);
-            pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            // Instance lines are parsed in place, only the line following
+            // the element is copied as it is handed over to the next one
+            if (i + 1 < pcElement->NumOccur) {
+                // missing lines of a truncated file are parsed as empty ones
+                if (streamBuffer.getNextLine(lineBegin, lineEnd)) {
+                    pCur = lineBegin;
+                    pEnd = lineEnd;
+                } else {
+                    pCur = pEnd = "\n";
+                }
+            } else {
+                streamBuffer.getNextLine(buffer);
+                pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            }
         }
     }
     return true;
@@ -625,13 +640,40 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
 
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstance::ParseInstance(const char *&pCur,
+        const char *end,
         const PLY::Element *pcElement,
         PLY::ElementInstance *p_pcOut) {
     ai_assert(nullptr != pcElement);
     ai_assert(nullptr != p_pcOut);
 
     // allocate enough storage
-    p_pcOut->alProperties.resize(pcElement->alProperties.size());
+    const size_t numProperties = pcElement->alProperties.size();
+    p_pcOut->alProperties.resize(numProperties);
+
+    // Vertices mostly consist of float properties only, these are parsed in one go
+    static const size_t MaxBulkProperties = 16;
+    if (nullptr != end && numProperties <= MaxBulkProperties) {
+        bool floatsOnly = true;
+        for (const PLY::Property &prop : pcElement->alProperties) {
+            if (prop.bIsList || EDT_Float != prop.eType) {
+                floatsOnly = false;
+                break;
+            }
+        }
+
+        ai_real values[MaxBulkProperties];
+        const char *c = pCur;
+        if (floatsOnly && fast_atoreal_array<ai_real>(&c, end, values, numProperties) == numProperties) {
+            for (size_t i = 0; i < numProperties; ++i) {
+                PLY::PropertyInstance::ValueUnion v;
+                v.fFloat = values[i];
+                p_pcOut->alProperties[i].avList.push_back(v);
+            }
+            pCur = c;
+            SkipSpacesAndLineEnd(&pCur);
+            return true;
+        }
+    }
 
     std::vector<PLY::PropertyInstance>::iterator i = p_pcOut->alProperties.begin();
     std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
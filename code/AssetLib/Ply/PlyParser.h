@@ -369,8 +369,8 @@ public:
     std::vector< PropertyInstance > alProperties;
 
     // -------------------------------------------------------------------
-    //! Parse an element instance
-    static bool ParseInstance(const char* &pCur,
+    //! Parse an element instance, end is the line end if known
+    static bool ParseInstance(const char* &pCur, const char* end,
         const Element* pcElement, ElementInstance* p_pcOut);
 
     // -------------------------------------------------------------------
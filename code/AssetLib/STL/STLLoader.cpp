@@ -46,9 +46,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "STLLoader.h"
 #include <assimp/ParsingUtils.h>
+#include <assimp/config.h>
 #include <assimp/fast_atof.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
 #include <memory>
@@ -122,6 +124,15 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Reads the three components of a normal or vertex position.
+static void ReadVector(const char **sz, const char *bufferEnd, aiVector3D &v) {
+    ai_real values[3];
+    if (fast_atoreal_array<ai_real>(sz, bufferEnd, values, 3) != 3) {
+        throw DeadlyImportError("STL: unexpected EOF while parsing facet");
+    }
+    v.Set(values[0], values[1], values[2]);
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -129,7 +140,8 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mContiguousFaces(false) {
    // empty
 }
 
@@ -157,12 +169,27 @@ bool STLImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mContiguousFaces = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh *pMesh) {
+// STL stores unindexed triangles, face i uses the vertices 3i, 3i+1 and 3i+2
+void addFacesToMesh(aiMesh *pMesh, bool contiguous) {
+    if (contiguous) {
+        const unsigned int numFaces = pMesh->mNumFaces;
+        unsigned int *indices = pMesh->AllocateContiguousFaces(numFaces, 3);
+        for (unsigned int p = 0; p < numFaces * 3; ++p) {
+            indices[p] = p;
+        }
+        return;
+    }
+
     pMesh->mFaces = new aiFace[pMesh->mNumFaces];
     for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
 
@@ -308,12 +335,7 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
                         throw DeadlyImportError("STL: unexpected EOF while parsing facet");
                     }
                     sz += 7;
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->x);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->y);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->z);
+                    ReadVector(&sz, bufferEnd, *vn);
                     normalBuffer.push_back(*vn);
                     normalBuffer.push_back(*vn);
                 }
@@ -326,14 +348,8 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
                         throw DeadlyImportError("STL: unexpected EOF while parsing facet");
                     }
                     sz += 7;
-                    SkipSpaces(&sz);
                     positionBuffer.push_back(aiVector3D());
-                    aiVector3D *vn = &positionBuffer.back();
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->x);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->y);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->z);
+                    ReadVector(&sz, bufferEnd, positionBuffer.back());
                     faceVertexCounter++;
                 }
             } else if (!::strncmp(sz, "endsolid", 8)) {
@@ -389,7 +405,7 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
         }
 
         // now copy faces
-        addFacesToMesh(pMesh);
+        addFacesToMesh(pMesh, mContiguousFaces);
 
         // assign the meshes to the current node
         pushMeshesToNode(meshIndices, node);
@@ -544,7 +560,7 @@ bool STLImporter::LoadBinaryFile() {
     }
 
     // now copy faces
-    addFacesToMesh(pMesh);
+    addFacesToMesh(pMesh, mContiguousFaces);
 
     aiNode *root = mScene->mRootNode;
 
@@ -76,6 +76,12 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /**
+     * @brief   Called prior to ReadFile().
+     *  See BaseImporter::SetupProperties() for details.
+     */
+    void SetupProperties(const Importer* pImp);
+
 protected:
 
     /**
@@ -117,6 +123,10 @@ protected:
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Store the face indices of a mesh in one buffer,
+     *  see #AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES */
+    bool mContiguousFaces;
 };
 
 } // end of namespace Assimp
@@ -74,6 +74,10 @@ static const aiImporterDesc desc = {
     "x"
 };
 
+static const uint32_t magicTokenData[] = { AI_MAKE_MAGIC("xof ") };
+
+static const MagicTokenInfo magicTokens = { magicTokenData, 1, 0, 4 };
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 XFileImporter::XFileImporter()
@@ -95,13 +99,17 @@ bool XFileImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, boo
         return true;
     }
     if (!extension.length() || checkSig) {
-        uint32_t token[1];
-        token[0] = AI_MAKE_MAGIC("xof ");
-        return CheckMagicToken(pIOHandler,pFile,token,1,0);
+        return CheckMagicTokens(pIOHandler, pFile);
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens identifying the format
+const MagicTokenInfo *XFileImporter::GetMagicTokens() const {
+    return &magicTokens;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get file extension list
 const aiImporterDesc* XFileImporter::GetInfo () const {
@@ -77,6 +77,11 @@ public:
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler,
         bool CheckSig) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format.
+     * See BaseImporter::GetMagicTokens() for details. */
+    const MagicTokenInfo *GetMagicTokens() const;
+
 protected:
 
     // -------------------------------------------------------------------
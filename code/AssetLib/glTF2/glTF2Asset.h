@@ -58,6 +58,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <list>
 #include <map>
 #include <set>
@@ -547,6 +549,15 @@ struct Accessor : public Object {
     template <class T>
     void ExtractData(T *&outData);
 
+    //! Copies the count elements into outData, which must hold count values of T
+    template <class T>
+    void ExtractData(T *outData, size_t outCount);
+
+    //! Decodes the count elements into outData as outComponents values each,
+    //! integer components are normalized to [0,1] or [-1,1] as the spec defines
+    //! for normalized accessors. Missing components are set to fill.
+    void ExtractNormalizedData(ai_real *outData, unsigned int outComponents, ai_real fill);
+
     void WriteData(size_t count, const void *src_buffer, size_t src_stride);
     void WriteSparseValues(size_t count, const void *src_data, size_t src_dataStride);
     void WriteSparseIndices(size_t count, const void *src_idx, size_t src_idxStride);
@@ -576,6 +587,10 @@ struct Accessor : public Object {
             return GetValue<unsigned int>(i);
         }
 
+        //! Reads the first count values into out, in one copy if the
+        //! indices are tightly packed 32 bit values
+        void GetUInts(unsigned int *out, size_t count);
+
         inline bool IsValid() const {
             return data != nullptr;
         }
@@ -585,6 +600,40 @@ struct Accessor : public Object {
         return Indexer(*this);
     }
 
+    //! Read-only view of the elements as T, reading straight from the buffer
+    template <class T>
+    class View {
+        friend struct Accessor;
+
+        const uint8_t *data;
+        size_t elemSize, stride, count;
+
+        View(const uint8_t *d, size_t e, size_t s, size_t c) :
+                data(d), elemSize(e), stride(s), count(c) {}
+
+    public:
+        inline size_t Size() const {
+            return count;
+        }
+
+        //! Accesses the i-th element, i must be less than Size()
+        inline T operator[](size_t i) const {
+            T value = T();
+            // Assume platform endianness matches GLTF binary data (which is little-endian).
+            memcpy(&value, data + i * stride, elemSize);
+            return value;
+        }
+    };
+
+    //! Returns a view of the elements, the range is checked once here
+    template <class T>
+    View<T> GetView();
+
+private:
+    uint8_t *GetCheckedPointer(size_t targetElemSize);
+
+public:
+
     Accessor() {}
     void Read(Value &obj, Asset &r);
 
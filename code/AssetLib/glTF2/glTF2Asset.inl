@@ -1044,32 +1044,43 @@ inline void CopyData(size_t count,
 
 } // namespace
 
-template <class T>
-void Accessor::ExtractData(T *&outData) {
+inline uint8_t *Accessor::GetCheckedPointer(size_t targetElemSize) {
     uint8_t *data = GetPointer();
     if (!data) {
         throw DeadlyImportError("GLTF2: data is null when extracting data from ", getContextForErrorMessages(id, name));
     }
 
     const size_t elemSize = GetElementSize();
-    const size_t totalSize = elemSize * count;
-
-    const size_t stride = GetStride();
-
-    const size_t targetElemSize = sizeof(T);
-
     if (elemSize > targetElemSize) {
         throw DeadlyImportError("GLTF: elemSize ", elemSize, " > targetElemSize ", targetElemSize, " in ", getContextForErrorMessages(id, name));
     }
 
+    const size_t stride = GetStride();
     const size_t maxSize = GetMaxByteSize();
     if (count * stride > maxSize) {
         throw DeadlyImportError("GLTF: count*stride ", (count * stride), " > maxSize ", maxSize, " in ", getContextForErrorMessages(id, name));
     }
 
-    outData = new T[count];
-    if (stride == elemSize && targetElemSize == elemSize) {
-        memcpy(outData, data, totalSize);
+    return data;
+}
+
+template <class T>
+Accessor::View<T> Accessor::GetView() {
+    const uint8_t *data = GetCheckedPointer(sizeof(T));
+    return View<T>(data, GetElementSize(), GetStride(), count);
+}
+
+template <class T>
+void Accessor::ExtractData(T *outData, size_t outCount) {
+    const uint8_t *data = GetCheckedPointer(sizeof(T));
+    if (outCount < count) {
+        throw DeadlyImportError("GLTF: ", count, " elements do not fit into ", outCount, " in ", getContextForErrorMessages(id, name));
+    }
+
+    const size_t elemSize = GetElementSize();
+    const size_t stride = GetStride();
+    if (stride == elemSize && sizeof(T) == elemSize) {
+        memcpy(outData, data, elemSize * count);
     } else {
         for (size_t i = 0; i < count; ++i) {
             memcpy(outData + i, data + i * stride, elemSize);
@@ -1077,6 +1088,93 @@ void Accessor::ExtractData(T *&outData) {
     }
 }
 
+template <class T>
+void Accessor::ExtractData(T *&outData) {
+    // check the range before allocating
+    GetCheckedPointer(sizeof(T));
+    std::unique_ptr<T[]> out(new T[count]);
+    ExtractData(out.get(), count);
+    outData = out.release();
+}
+
+namespace {
+
+template <class TSrc>
+inline ai_real NormalizedComponent(const uint8_t *src) {
+    TSrc value;
+    memcpy(&value, src, sizeof(TSrc));
+    const ai_real max = static_cast<ai_real>(std::numeric_limits<TSrc>::max());
+    return std::max(static_cast<ai_real>(value) / max, static_cast<ai_real>(-1));
+}
+
+template <>
+inline ai_real NormalizedComponent<float>(const uint8_t *src) {
+    float value;
+    memcpy(&value, src, sizeof(float));
+    return static_cast<ai_real>(value);
+}
+
+template <>
+inline ai_real NormalizedComponent<uint32_t>(const uint8_t *src) {
+    // 32 bit integers are never normalized
+    uint32_t value;
+    memcpy(&value, src, sizeof(uint32_t));
+    return static_cast<ai_real>(value);
+}
+
+template <class TSrc>
+void DecodeNormalized(const uint8_t *data, size_t stride, size_t count, unsigned int numComponents,
+        ai_real *out, unsigned int outComponents, ai_real fill) {
+    const unsigned int n = std::min(numComponents, outComponents);
+    for (size_t i = 0; i < count; ++i, data += stride, out += outComponents) {
+        for (unsigned int c = 0; c < n; ++c) {
+            out[c] = NormalizedComponent<TSrc>(data + c * sizeof(TSrc));
+        }
+        for (unsigned int c = n; c < outComponents; ++c) {
+            out[c] = fill;
+        }
+    }
+}
+
+} // namespace
+
+inline void Accessor::ExtractNormalizedData(ai_real *outData, unsigned int outComponents, ai_real fill) {
+    const uint8_t *data = GetCheckedPointer(GetElementSize());
+    const size_t stride = GetStride();
+    const unsigned int numComponents = GetNumComponents();
+    if (componentType == ComponentType_FLOAT && sizeof(ai_real) == sizeof(float) && numComponents == outComponents) {
+        const size_t elemSize = GetElementSize();
+        if (stride == elemSize) {
+            memcpy(outData, data, elemSize * count);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(outData + i * outComponents, data + i * stride, elemSize);
+        }
+        return;
+    }
+    switch (componentType) {
+    case ComponentType_BYTE:
+        DecodeNormalized<int8_t>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    case ComponentType_UNSIGNED_BYTE:
+        DecodeNormalized<uint8_t>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    case ComponentType_SHORT:
+        DecodeNormalized<int16_t>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    case ComponentType_UNSIGNED_SHORT:
+        DecodeNormalized<uint16_t>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    case ComponentType_UNSIGNED_INT:
+        DecodeNormalized<uint32_t>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    case ComponentType_FLOAT:
+        DecodeNormalized<float>(data, stride, count, numComponents, outData, outComponents, fill);
+        break;
+    }
+}
+
 inline void Accessor::WriteData(size_t _count, const void *src_buffer, size_t src_stride) {
     uint8_t *buffer_ptr = bufferView->buffer->GetPointer();
     size_t offset = byteOffset + bufferView->byteOffset;
@@ -1139,6 +1237,27 @@ T Accessor::Indexer::GetValue(int i) {
     return value;
 }
 
+inline void Accessor::Indexer::GetUInts(unsigned int *out, size_t count) {
+    ai_assert(data);
+    if (0 == count) {
+        return;
+    }
+    if ((count - 1) * stride >= accessor.GetMaxByteSize()) {
+        throw DeadlyImportError("GLTF: Invalid count ", count, ", out of range for buffer with stride ", stride, " and size ", accessor.GetMaxByteSize(), ".");
+    }
+    if (elemSize == sizeof(unsigned int) && stride == sizeof(unsigned int)) {
+        memcpy(out, data, count * sizeof(unsigned int));
+        return;
+    }
+    // Ensure that the memcpy doesn't overwrite the local.
+    const size_t sizeToCopy = std::min(elemSize, sizeof(unsigned int));
+    for (size_t i = 0; i < count; ++i) {
+        unsigned int value = 0;
+        memcpy(&value, data + i * stride, sizeToCopy);
+        out[i] = value;
+    }
+}
+
 inline Image::Image() :
         width(0),
         height(0),
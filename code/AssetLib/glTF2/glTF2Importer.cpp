@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF2_IMPORTER)
 
 #include "AssetLib/glTF2/glTF2Importer.h"
+#include "Common/ThreadPool.h"
 #include "PostProcessing/MakeVerboseFormat.h"
 #include "AssetLib/glTF2/glTF2Asset.h"
 #if !defined(ASSIMP_BUILD_NO_EXPORT)
@@ -52,12 +53,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/StringComparison.h>
 #include <assimp/StringUtils.h>
 #include <assimp/ai_assert.h>
+#include <assimp/config.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Profiler.h>
 #include <assimp/Importer.hpp>
 #include <assimp/commonMetaData.h>
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 
@@ -97,7 +101,8 @@ glTF2Importer::glTF2Importer() :
         BaseImporter(),
         meshOffsets(),
         embeddedTexIdxs(),
-        mScene(nullptr) {
+        mScene(nullptr),
+        mContiguousFaces(false) {
     // empty
 }
 
@@ -126,6 +131,10 @@ bool glTF2Importer::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool
     return false;
 }
 
+void glTF2Importer::SetupProperties(const Importer *pImp) {
+    mContiguousFaces = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, false);
+}
+
 static aiTextureMapMode ConvertWrappingMode(SamplerWrap gltfWrapMode) {
     switch (gltfWrapMode) {
         case SamplerWrap::Mirrored_Repeat:
@@ -385,20 +394,15 @@ static inline bool CheckValidFacesIndices(aiFace *faces, unsigned nFaces, unsign
 }
 #endif // ASSIMP_BUILD_DEBUG
 
-template<typename T>
-aiColor4D* GetVertexColorsForType(glTF2::Ref<glTF2::Accessor> input) {
-    float max = std::numeric_limits<T>::max();
-    aiColor4t<T>* colors;
-    input->ExtractData(colors);
-    auto output = new aiColor4D[input->count];
-    for (size_t i = 0; i < input->count; i++) {
-        output[i] = aiColor4D(
-            colors[i].r / max, colors[i].g / max,
-            colors[i].b / max, colors[i].a / max
-        );
+// runs the decodes of independent accessors, concurrently if a pool is given
+static void RunDecodes(ThreadPool *pool, const std::vector<std::function<void()>> &decodes) {
+    if (nullptr != pool && decodes.size() > 1) {
+        pool->ParallelFor(decodes.size(), [&decodes](size_t i) { decodes[i](); });
+        return;
+    }
+    for (const std::function<void()> &decode : decodes) {
+        decode();
     }
-    delete[] colors;
-    return output;
 }
 
 void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
@@ -448,38 +452,52 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
             Mesh::Primitive::Attributes &attr = prim.attributes;
 
+            // the output arrays are allocated here, the accessors are then decoded
+            // straight into them and independently of each other
+            std::vector<std::function<void()>> decodes;
+
             if (attr.position.size() > 0 && attr.position[0]) {
                 aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-                attr.position[0]->ExtractData(aim->mVertices);
+                aim->mVertices = new aiVector3D[aim->mNumVertices];
+                Accessor *position = &*attr.position[0];
+                decodes.push_back([position, aim]() {
+                    position->ExtractData(aim->mVertices, aim->mNumVertices);
+                });
             }
 
             if (attr.normal.size() > 0 && attr.normal[0]) {
                 if (attr.normal[0]->count != aim->mNumVertices) {
                     DefaultLogger::get()->warn("Normal count in mesh \"", mesh.name, "\" does not match the vertex count, normals ignored.");
                 } else {
-                    attr.normal[0]->ExtractData(aim->mNormals);
+                    aim->mNormals = new aiVector3D[aim->mNumVertices];
+                    Accessor *normal = &*attr.normal[0];
+                    Accessor *tangent = nullptr;
 
                     // only extract tangents if normals are present
                     if (attr.tangent.size() > 0 && attr.tangent[0]) {
                         if (attr.tangent[0]->count != aim->mNumVertices) {
                             DefaultLogger::get()->warn("Tangent count in mesh \"", mesh.name, "\" does not match the vertex count, tangents ignored.");
                         } else {
-                            // generate bitangents from normals and tangents according to spec
-                            Tangent *tangents = nullptr;
-
-                            attr.tangent[0]->ExtractData(tangents);
-
+                            tangent = &*attr.tangent[0];
                             aim->mTangents = new aiVector3D[aim->mNumVertices];
                             aim->mBitangents = new aiVector3D[aim->mNumVertices];
+                        }
+                    }
 
-                            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                                aim->mTangents[i] = tangents[i].xyz;
-                                aim->mBitangents[i] = (aim->mNormals[i] ^ tangents[i].xyz) * tangents[i].w;
-                            }
+                    decodes.push_back([normal, tangent, aim]() {
+                        normal->ExtractData(aim->mNormals, aim->mNumVertices);
+                        if (nullptr == tangent) {
+                            return;
+                        }
 
-                            delete[] tangents;
+                        // generate bitangents from normals and tangents according to spec
+                        const Accessor::View<Tangent> tangents = tangent->GetView<Tangent>();
+                        for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                            const Tangent t = tangents[i];
+                            aim->mTangents[i] = t.xyz;
+                            aim->mBitangents[i] = (aim->mNormals[i] ^ t.xyz) * t.w;
                         }
-                    }
+                    });
                 }
             }
 
@@ -489,17 +507,13 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                                                "\" does not match the vertex count");
                     continue;
                 }
-                
-                auto componentType = attr.color[c]->componentType;
-                if (componentType == glTF2::ComponentType_FLOAT) {
-                    attr.color[c]->ExtractData(aim->mColors[c]);
-                } else {
-                    if (componentType == glTF2::ComponentType_UNSIGNED_BYTE) {
-                        aim->mColors[c] = GetVertexColorsForType<unsigned char>(attr.color[c]);
-                    } else if (componentType == glTF2::ComponentType_UNSIGNED_SHORT) {
-                        aim->mColors[c] = GetVertexColorsForType<unsigned short>(attr.color[c]);
-                    }
-                }
+
+                // integer colors are normalized, RGB colors are opaque
+                aiColor4D *colors = aim->mColors[c] = new aiColor4D[aim->mNumVertices];
+                Accessor *color = &*attr.color[c];
+                decodes.push_back([color, colors]() {
+                    color->ExtractNormalizedData(&colors[0].r, 4, 1);
+                });
             }
             for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
                 if (!attr.texcoord[tc]) {
@@ -513,15 +527,20 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     continue;
                 }
 
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
                 aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
-
-                aiVector3D *values = aim->mTextureCoords[tc];
-                for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                    values[i].y = 1 - values[i].y; // Flip Y coords
-                }
+                aiVector3D *values = aim->mTextureCoords[tc] = new aiVector3D[aim->mNumVertices];
+                Accessor *texcoord = &*attr.texcoord[tc];
+                decodes.push_back([texcoord, values]() {
+                    texcoord->ExtractNormalizedData(&values[0].x, 3, 0);
+                    for (size_t i = 0; i < texcoord->count; ++i) {
+                        values[i].y = 1 - values[i].y; // Flip Y coords
+                    }
+                });
             }
 
+            RunDecodes(m_threadPool, decodes);
+            decodes.clear();
+
             std::vector<Mesh::Primitive::Target> &targets = prim.targets;
             if (targets.size() > 0) {
                 aim->mNumAnimMeshes = (unsigned int)targets.size();
@@ -534,59 +553,70 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     // GLTF morph does not support colors and texCoords
                     aim->mAnimMeshes[i] = aiCreateAnimMesh(aim,
                             needPositions, needNormals, needTangents, false, false);
-                    aiAnimMesh &aiAnimMesh = *(aim->mAnimMeshes[i]);
+                    aiAnimMesh *animMesh = aim->mAnimMeshes[i];
                     Mesh::Primitive::Target &target = targets[i];
 
+                    // the differences are added to the copies of the base attributes
+                    Accessor *positionDiff = nullptr;
+                    Accessor *normalDiff = nullptr;
+                    Accessor *tangentDiff = nullptr;
                     if (needPositions) {
                         if (target.position[0]->count != aim->mNumVertices) {
                             ASSIMP_LOG_WARN("Positions of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
                         } else {
-                            aiVector3D *positionDiff = nullptr;
-                            target.position[0]->ExtractData(positionDiff);
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                                aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
-                            }
-                            delete[] positionDiff;
+                            positionDiff = &*target.position[0];
                         }
                     }
                     if (needNormals) {
                         if (target.normal[0]->count != aim->mNumVertices) {
                             ASSIMP_LOG_WARN("Normals of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
                         } else {
-                            aiVector3D *normalDiff = nullptr;
-                            target.normal[0]->ExtractData(normalDiff);
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                                aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
-                            }
-                            delete[] normalDiff;
+                            normalDiff = &*target.normal[0];
                         }
                     }
                     if (needTangents) {
                         if (target.tangent[0]->count != aim->mNumVertices) {
                             ASSIMP_LOG_WARN("Tangents of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
                         } else {
-                            Tangent *tangent = nullptr;
-                            attr.tangent[0]->ExtractData(tangent);
-
-                            aiVector3D *tangentDiff = nullptr;
-                            target.tangent[0]->ExtractData(tangentDiff);
-
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
-                                tangent[vertexId].xyz += tangentDiff[vertexId];
-                                aiAnimMesh.mTangents[vertexId] = tangent[vertexId].xyz;
-                                aiAnimMesh.mBitangents[vertexId] = (aiAnimMesh.mNormals[vertexId] ^ tangent[vertexId].xyz) * tangent[vertexId].w;
-                            }
-                            delete[] tangent;
-                            delete[] tangentDiff;
+                            tangentDiff = &*target.tangent[0];
                         }
                     }
+                    Accessor *tangent = tangentDiff ? &*attr.tangent[0] : nullptr;
+
+                    decodes.push_back([positionDiff, normalDiff, tangentDiff, tangent, animMesh]() {
+                        const unsigned int numVertices = animMesh->mNumVertices;
+                        if (nullptr != positionDiff) {
+                            const Accessor::View<aiVector3D> diff = positionDiff->GetView<aiVector3D>();
+                            for (unsigned int vertexId = 0; vertexId < numVertices; vertexId++) {
+                                animMesh->mVertices[vertexId] += diff[vertexId];
+                            }
+                        }
+                        if (nullptr != normalDiff) {
+                            const Accessor::View<aiVector3D> diff = normalDiff->GetView<aiVector3D>();
+                            for (unsigned int vertexId = 0; vertexId < numVertices; vertexId++) {
+                                animMesh->mNormals[vertexId] += diff[vertexId];
+                            }
+                        }
+                        if (nullptr != tangentDiff) {
+                            const Accessor::View<Tangent> tangents = tangent->GetView<Tangent>();
+                            const Accessor::View<aiVector3D> diff = tangentDiff->GetView<aiVector3D>();
+                            for (unsigned int vertexId = 0; vertexId < numVertices; ++vertexId) {
+                                Tangent t = tangents[vertexId];
+                                t.xyz += diff[vertexId];
+                                animMesh->mTangents[vertexId] = t.xyz;
+                                animMesh->mBitangents[vertexId] = (animMesh->mNormals[vertexId] ^ t.xyz) * t.w;
+                            }
+                        }
+                    });
+
                     if (mesh.weights.size() > i) {
-                        aiAnimMesh.mWeight = mesh.weights[i];
+                        animMesh->mWeight = mesh.weights[i];
                     }
                     if (mesh.targetNames.size() > i) {
-                        aiAnimMesh.mName = mesh.targetNames[i];
+                        animMesh->mName = mesh.targetNames[i];
                     }
                 }
+                RunDecodes(m_threadPool, decodes);
             }
 
             aiFace *faces = nullptr;
@@ -645,6 +675,26 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                             count = nFaces * 3;
                         }
                         facePtr = faces = new aiFace[nFaces];
+                        if (mContiguousFaces) {
+                            // read all indices at once and drop the out-of-range triangles in place
+                            unsigned int *indices = aim->mIndexBuffer = new unsigned int[count];
+                            aim->mIndexBufferSize = static_cast<unsigned int>(count);
+                            data.GetUInts(indices, count);
+                            unsigned int *out = indices;
+                            for (size_t i = 0; i < count; i += 3) {
+                                if (indices[i] >= aim->mNumVertices || indices[i + 1] >= aim->mNumVertices || indices[i + 2] >= aim->mNumVertices) {
+                                    continue;
+                                }
+                                out[0] = indices[i];
+                                out[1] = indices[i + 1];
+                                out[2] = indices[i + 2];
+                                facePtr->mNumIndices = 3;
+                                facePtr->mIndices = out;
+                                ++facePtr;
+                                out += 3;
+                            }
+                            break;
+                        }
                         for (unsigned int i = 0; i < count; i += 3) {
                             SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
                         }
@@ -1523,16 +1573,25 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     this->mScene = pScene;
 
     // read the asset file
+    if (m_profiler) {
+        m_profiler->BeginRegion("parse");
+    }
     glTF2::Asset asset(pIOHandler);
     asset.Load(pFile, GetExtension(pFile) == "glb");
     if (asset.scene) {
         pScene->mName = asset.scene->name;
     }
+    if (m_profiler) {
+        m_profiler->EndRegion("parse");
+    }
 
     //
     // Copy the data out
     //
 
+    if (m_profiler) {
+        m_profiler->BeginRegion("convert");
+    }
     ImportEmbeddedTextures(asset);
     ImportMaterials(asset);
 
@@ -1546,6 +1605,9 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     ImportAnimations(asset);
 
     ImportCommonMetadata(asset);
+    if (m_profiler) {
+        m_profiler->EndRegion("convert");
+    }
 
     if (pScene->mNumMeshes == 0) {
         pScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
@@ -64,6 +64,7 @@ public:
     glTF2Importer();
     virtual ~glTF2Importer();
     virtual bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig ) const;
+    virtual void SetupProperties( const Importer* pImp );
 
 protected:
     virtual const aiImporterDesc* GetInfo() const;
@@ -77,6 +78,8 @@ private:
 
     aiScene* mScene;
 
+    bool mContiguousFaces;
+
     void ImportEmbeddedTextures(glTF2::Asset& a);
     void ImportMaterials(glTF2::Asset& a);
     void ImportMeshes(glTF2::Asset& a);
@@ -53,12 +53,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/Profiler.h>
 
 #include "CApi/CInterfaceIOWrapper.h"
 #include "Importer.h"
 #include "ScenePrivate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <list>
+#include <memory>
 
 // ------------------------------------------------------------------------------------------------
 #ifndef ASSIMP_BUILD_SINGLETHREADED
@@ -143,6 +150,35 @@ private:
     aiLogStream stream;
 };
 
+// ------------------------------------------------------------------------------------------------
+// Progress handler for the C-API, keeps the last reported progress for polling
+class ProgressRecorder : public ProgressHandler {
+public:
+    ProgressRecorder() :
+            progress(0.f) {
+        // empty
+    }
+
+    /** @copydoc ProgressHandler::Update */
+    bool Update(float percentage) override {
+        if (percentage >= 0.f) {
+            progress = std::min(percentage, 1.f);
+        }
+        return false;
+    }
+
+    std::atomic<float> progress;
+};
+
+// ------------------------------------------------------------------------------------------------
+// underlying structure for aiImportHandle
+struct aiImportHandle {
+    // declared first, the future waits for the import when it is destroyed
+    std::unique_ptr<Importer> importer;
+    ProgressRecorder *progress;
+    std::future<const aiScene *> result;
+};
+
 // ------------------------------------------------------------------------------------------------
 void ReportSceneNotFoundError() {
     ASSIMP_LOG_ERROR("Unable to find the Assimp::Importer for this aiScene. "
@@ -206,6 +242,87 @@ const aiScene *aiImportFileExWithProperties(const char *pFile, unsigned int pFla
     return scene;
 }
 
+// ------------------------------------------------------------------------------------------------
+aiImportHandle *aiImportFileAsync(const char *pFile, unsigned int pFlags, const aiPropertyStore *props) {
+    ai_assert(nullptr != pFile);
+
+    aiImportHandle *handle = nullptr;
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    // create an Importer for this file, it takes the ownership of the progress handler
+    std::unique_ptr<Importer> imp(new Importer());
+    ProgressRecorder *progress = new ProgressRecorder();
+    imp->SetProgressHandler(progress);
+
+    // copy properties
+    if (props) {
+        const PropertyMap *pp = reinterpret_cast<const PropertyMap *>(props);
+        ImporterPimpl *pimpl = imp->Pimpl();
+        pimpl->mIntProperties = pp->ints;
+        pimpl->mFloatProperties = pp->floats;
+        pimpl->mStringProperties = pp->strings;
+        pimpl->mMatrixProperties = pp->matrices;
+    }
+
+    std::unique_ptr<aiImportHandle> newHandle(new aiImportHandle);
+    newHandle->progress = progress;
+    newHandle->result = imp->ReadFileAsync(pFile, pFlags);
+    newHandle->importer = std::move(imp);
+    handle = newHandle.release();
+
+    ASSIMP_END_EXCEPTION_REGION(aiImportHandle *);
+
+    return handle;
+}
+
+// ------------------------------------------------------------------------------------------------
+float aiGetImportProgress(const aiImportHandle *pHandle) {
+    ai_assert(nullptr != pHandle);
+
+    return pHandle->progress->progress;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBool aiIsImportFinished(const aiImportHandle *pHandle) {
+    ai_assert(nullptr != pHandle);
+
+    // A deferred import (no threading support) only runs when it is waited for,
+    // report it as finished so callers polling for it don't wait forever.
+    const std::future_status status = pHandle->result.wait_for(std::chrono::seconds(0));
+    return status != std::future_status::timeout ? AI_TRUE : AI_FALSE;
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiCancelImport(aiImportHandle *pHandle) {
+    ai_assert(nullptr != pHandle);
+
+    pHandle->importer->CancelReadFile();
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene *aiWaitForImport(aiImportHandle *pHandle) {
+    ai_assert(nullptr != pHandle);
+
+    const aiScene *scene = nullptr;
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    std::unique_ptr<aiImportHandle> handle(pHandle);
+    scene = handle->result.get();
+
+    // if succeeded, store the importer in the scene and keep it alive
+    if (scene) {
+        ScenePrivateData *priv = const_cast<ScenePrivateData *>(ScenePriv(scene));
+        priv->mOrigImporter = handle->importer.release();
+    } else {
+        // if failed, extract error code, the import is destroyed with the handle
+        gLastErrorString = handle->importer->GetErrorString();
+    }
+
+    ASSIMP_END_EXCEPTION_REGION(const aiScene *);
+
+    return scene;
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiScene *aiImportFileFromMemory(
         const char *pBuffer,
@@ -496,6 +613,54 @@ void aiGetMemoryRequirements(const C_STRUCT aiScene *pIn,
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the timing report of a particular import.
+const aiImportStatistics *aiGetImportStatistics(const C_STRUCT aiScene *pIn) {
+    // find the importer associated with this data
+    const ScenePrivateData *priv = ScenePriv(pIn);
+    if (!priv || !priv->mOrigImporter) {
+        ReportSceneNotFoundError();
+        return nullptr;
+    }
+
+    return priv->mOrigImporter->GetImportStatistics();
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiSetAllocationCounter(aiAllocationCounter counter) {
+    Assimp::Profiling::Profiler::SetAllocationCounter(counter);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int aiGetMeshletCount(const C_STRUCT aiMesh *pMesh) {
+    if (nullptr == pMesh || nullptr == pMesh->mMeshlets) {
+        return 0;
+    }
+    return pMesh->mMeshlets->mNumMeshlets;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMeshlet *aiGetMeshlet(const C_STRUCT aiMesh *pMesh, unsigned int index) {
+    if (index >= aiGetMeshletCount(pMesh)) {
+        return nullptr;
+    }
+    return &pMesh->mMeshlets->mMeshlets[index];
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn aiGetMeshletTriangle(const C_STRUCT aiMesh *pMesh, unsigned int meshlet, unsigned int triangle, unsigned int *indices) {
+    const aiMeshlet *m = aiGetMeshlet(pMesh, meshlet);
+    if (nullptr == m || triangle >= m->mNumTriangles || nullptr == indices) {
+        return aiReturn_FAILURE;
+    }
+    const aiMeshlets *meshlets = pMesh->mMeshlets;
+    const unsigned char *local = &meshlets->mTriangles[(m->mTriangleOffset + triangle) * 3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        indices[i] = meshlets->mVertices[m->mVertexOffset + local[i]];
+    }
+    return aiReturn_SUCCESS;
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiPropertyStore *aiCreatePropertyStore(void) {
     return reinterpret_cast<aiPropertyStore *>(new PropertyMap());
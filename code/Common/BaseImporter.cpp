@@ -43,8 +43,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  @brief Implementation of BaseImporter
  */
 
+#include "CancellableProgressHandler.h"
+#include "FileHeaderCache.h"
 #include "FileSystemFilter.h"
 #include "Importer.h"
+#include "ThreadPool.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/ByteSwapper.h>
 #include <assimp/ParsingUtils.h>
@@ -58,13 +61,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <list>
 #include <memory>
 #include <sstream>
+#include <vector>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
 
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-        : m_progress() {
+        : m_progress(),
+          m_profiler(),
+          m_threadPool() {
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -90,12 +100,16 @@ void BaseImporter::UpdateImporterScale(Importer *pImp) {
 // Imports the given file and returns the imported data.
 aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSystem *pIOHandler) {
 
-    m_progress = pImp->GetProgressHandler();
-    if (nullptr == m_progress) {
+    ProgressHandler *progress = pImp->GetProgressHandler();
+    if (nullptr == progress) {
         return nullptr;
     }
 
-    ai_assert(m_progress);
+    // Route all progress reports through the cancellation check
+    CancellableProgressHandler cancellable(progress, pImp->Pimpl()->mCancelRequested);
+    m_progress = &cancellable;
+    m_profiler = pImp->Pimpl()->mProfiler;
+    m_threadPool = pImp->Pimpl()->GetThreadPool(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0));
 
     // Gather configuration properties for this run
     SetupProperties(pImp);
@@ -108,6 +122,7 @@ aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSyst
 
     // dispatch importing
     try {
+        cancellable.ThrowIfCancelled();
         InternReadFile(pFile, sc.get(), &filter);
 
         // Calculate import scale hook - required because pImp not available anywhere else
@@ -119,13 +134,25 @@ aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSyst
         m_ErrorText = err.what();
         ASSIMP_LOG_ERROR(err.what());
         m_Exception = std::current_exception();
+        m_progress = progress;
+        m_profiler = nullptr;
+        m_threadPool = nullptr;
         return nullptr;
     }
+    m_progress = progress;
+    m_profiler = nullptr;
+    m_threadPool = nullptr;
 
     // return what we gathered from the import.
     return sc.release();
 }
 
+// ------------------------------------------------------------------------------------------------
+const MagicTokenInfo *BaseImporter::GetMagicTokens() const {
+    // the default implementation declares none
+    return nullptr;
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseImporter::SetupProperties(const Importer *) {
     // the default implementation does nothing
@@ -168,56 +195,68 @@ void BaseImporter::GetExtensionList(std::set<std::string> &extensions) {
         return false;
     }
 
-    std::unique_ptr<IOStream> pStream(pIOHandler->Open(pFile));
-    if (pStream) {
-        // read 200 characters from the file
-        std::unique_ptr<char[]> _buffer(new char[searchBytes + 1 /* for the '\0' */]);
-        char *buffer(_buffer.get());
-        const size_t read(pStream->Read(buffer, 1, searchBytes));
-        if (0 == read) {
+    // read 200 characters from the file, or take them from the header
+    // shared by all checks during format detection
+    std::unique_ptr<char[]> _buffer(new char[searchBytes + 1 /* for the '\0' */]);
+    char *buffer(_buffer.get());
+    size_t read = 0;
+    const char *header = nullptr;
+    FileHeaderCache *cache = FileHeaderCache::Get(pIOHandler, pFile);
+    if (nullptr != cache && cache->Peek(0, searchBytes, header, read)) {
+        if (read > 0) {
+            ::memcpy(buffer, header, read);
+        }
+    } else {
+        std::unique_ptr<IOStream> pStream(pIOHandler->Open(pFile));
+        if (!pStream) {
             return false;
         }
+        read = pStream->Read(buffer, 1, searchBytes);
+    }
 
-        for (size_t i = 0; i < read; ++i) {
-            buffer[i] = static_cast<char>(::tolower((unsigned char)buffer[i]));
-        }
+    if (0 == read) {
+        return false;
+    }
 
-        // It is not a proper handling of unicode files here ...
-        // ehm ... but it works in most cases.
-        char *cur = buffer, *cur2 = buffer, *end = &buffer[read];
-        while (cur != end) {
-            if (*cur) {
-                *cur2++ = *cur;
-            }
-            ++cur;
+    for (size_t i = 0; i < read; ++i) {
+        buffer[i] = static_cast<char>(::tolower((unsigned char)buffer[i]));
+    }
+
+    // It is not a proper handling of unicode files here ...
+    // ehm ... but it works in most cases.
+    char *cur = buffer, *cur2 = buffer, *end = &buffer[read];
+    while (cur != end) {
+        if (*cur) {
+            *cur2++ = *cur;
         }
-        *cur2 = '\0';
-
-        std::string token;
-        for (unsigned int i = 0; i < numTokens; ++i) {
-            ai_assert(nullptr != tokens[i]);
-            const size_t len(strlen(tokens[i]));
-            token.clear();
-            const char *ptr(tokens[i]);
-            for (size_t tokIdx = 0; tokIdx < len; ++tokIdx) {
-                token.push_back(static_cast<char>(tolower(static_cast<unsigned char>(*ptr))));
-                ++ptr;
-            }
-            const char *r = strstr(buffer, token.c_str());
-            if (!r) {
-                continue;
-            }
-            // We need to make sure that we didn't accidentially identify the end of another token as our token,
-            // e.g. in a previous version the "gltf " present in some gltf files was detected as "f "
-            if (noAlphaBeforeTokens && (r != buffer && isalpha(static_cast<unsigned char>(r[-1])))) {
-                continue;
-            }
-            // We got a match, either we don't care where it is, or it happens to
-            // be in the beginning of the file / line
-            if (!tokensSol || r == buffer || r[-1] == '\r' || r[-1] == '\n') {
-                ASSIMP_LOG_DEBUG("Found positive match for header keyword: ", tokens[i]);
-                return true;
-            }
+        ++cur;
+    }
+    *cur2 = '\0';
+
+    std::string token;
+    for (unsigned int i = 0; i < numTokens; ++i) {
+        ai_assert(nullptr != tokens[i]);
+        const size_t len(strlen(tokens[i]));
+        token.clear();
+        const char *ptr(tokens[i]);
+        for (size_t tokIdx = 0; tokIdx < len; ++tokIdx) {
+            token.push_back(static_cast<char>(tolower(static_cast<unsigned char>(*ptr))));
+            ++ptr;
+        }
+        const char *r = strstr(buffer, token.c_str());
+        if (!r) {
+            continue;
+        }
+        // We need to make sure that we didn't accidentially identify the end of another token as our token,
+        // e.g. in a previous version the "gltf " present in some gltf files was detected as "f "
+        if (noAlphaBeforeTokens && (r != buffer && isalpha(static_cast<unsigned char>(r[-1])))) {
+            continue;
+        }
+        // We got a match, either we don't care where it is, or it happens to
+        // be in the beginning of the file / line
+        if (!tokensSol || r == buffer || r[-1] == '\r' || r[-1] == '\n') {
+            ASSIMP_LOG_DEBUG("Found positive match for header keyword: ", tokens[i]);
+            return true;
         }
     }
 
@@ -283,50 +322,72 @@ std::string BaseImporter::GetExtension(const std::string &file) {
         const uint32_t *magic_u32;
     };
     magic = reinterpret_cast<const char *>(_magic);
-    std::unique_ptr<IOStream> pStream(pIOHandler->Open(pFile));
-    if (pStream) {
+
+    // read 'size' characters from the file, or take them from the header
+    // shared by all checks during format detection
+    union {
+        char data[16];
+        uint16_t data_u16[8];
+        uint32_t data_u32[4];
+    };
+    size_t read = 0;
+    const char *header = nullptr;
+    FileHeaderCache *cache = FileHeaderCache::Get(pIOHandler, pFile);
+    if (nullptr != cache && cache->Peek(offset, size, header, read)) {
+        if (size != read) {
+            return false;
+        }
+        ::memcpy(data, header, size);
+    } else {
+        std::unique_ptr<IOStream> pStream(pIOHandler->Open(pFile));
+        if (!pStream) {
+            return false;
+        }
 
         // skip to offset
         pStream->Seek(offset, aiOrigin_SET);
-
-        // read 'size' characters from the file
-        union {
-            char data[16];
-            uint16_t data_u16[8];
-            uint32_t data_u32[4];
-        };
         if (size != pStream->Read(data, 1, size)) {
             return false;
         }
+    }
 
-        for (unsigned int i = 0; i < num; ++i) {
-            // also check against big endian versions of tokens with size 2,4
-            // that's just for convenience, the chance that we cause conflicts
-            // is quite low and it can save some lines and prevent nasty bugs
-            if (2 == size) {
-                uint16_t rev = *magic_u16;
-                ByteSwap::Swap(&rev);
-                if (data_u16[0] == *magic_u16 || data_u16[0] == rev) {
-                    return true;
-                }
-            } else if (4 == size) {
-                uint32_t rev = *magic_u32;
-                ByteSwap::Swap(&rev);
-                if (data_u32[0] == *magic_u32 || data_u32[0] == rev) {
-                    return true;
-                }
-            } else {
-                // any length ... just compare
-                if (!memcmp(magic, data, size)) {
-                    return true;
-                }
+    for (unsigned int i = 0; i < num; ++i) {
+        // also check against big endian versions of tokens with size 2,4
+        // that's just for convenience, the chance that we cause conflicts
+        // is quite low and it can save some lines and prevent nasty bugs
+        if (2 == size) {
+            uint16_t rev = *magic_u16;
+            ByteSwap::Swap(&rev);
+            if (data_u16[0] == *magic_u16 || data_u16[0] == rev) {
+                return true;
+            }
+        } else if (4 == size) {
+            uint32_t rev = *magic_u32;
+            ByteSwap::Swap(&rev);
+            if (data_u32[0] == *magic_u32 || data_u32[0] == rev) {
+                return true;
+            }
+        } else {
+            // any length ... just compare
+            if (!memcmp(magic, data, size)) {
+                return true;
             }
-            magic += size;
         }
+        magic += size;
     }
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Check for the magic bytes declared by the importer.
+bool BaseImporter::CheckMagicTokens(IOSystem *pIOHandler, const std::string &pFile) const {
+    const MagicTokenInfo *info = GetMagicTokens();
+    if (nullptr == info) {
+        return false;
+    }
+    return CheckMagicToken(pIOHandler, pFile, info->tokens, info->num, info->offset, info->size);
+}
+
 #ifdef ASSIMP_USE_HUNTER
 #include <utf8.h>
 #else
@@ -485,7 +546,7 @@ struct LoadRequest {
 // BatchLoader::pimpl data structure
 struct Assimp::BatchData {
     BatchData(IOSystem *pIO, bool validate) :
-            pIOSystem(pIO), pImporter(nullptr), next_id(0xffff), validate(validate) {
+            pIOSystem(pIO), pImporter(nullptr), next_id(0xffff), validate(validate), numThreads(0) {
         ai_assert(nullptr != pIO);
 
         pImporter = new Importer();
@@ -514,10 +575,119 @@ struct Assimp::BatchData {
 
     // Validation enabled state
     bool validate;
+
+    // Multithreading policy, see AI_CONFIG_GLOB_MULTITHREADING
+    int numThreads;
 };
 
 typedef std::list<LoadRequest>::iterator LoadReqIt;
 
+namespace {
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+// ------------------------------------------------------------------------------------------------
+// Gives each parallel import its own view of the shared IOSystem. Calls into the
+// wrapped system are serialized, the directory stack is kept per import.
+class SynchronizedIOSystem : public IOSystem {
+public:
+    SynchronizedIOSystem(IOSystem *wrapped, std::mutex &mutex) :
+            mWrapped(wrapped), mMutex(mutex) {
+        ai_assert(nullptr != mWrapped);
+    }
+
+    bool Exists(const char *pFile) const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->Open(pFile, pMode);
+    }
+
+    void Close(IOStream *pFile) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWrapped->Close(pFile);
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->ComparePaths(one, second);
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mWrapped->DeleteFile(file);
+    }
+
+private:
+    IOSystem *mWrapped;
+    std::mutex &mMutex;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Lends an IOSystem to an importer and takes it back before the importer is
+// destroyed, also when the import throws.
+class ScopedIOHandler {
+public:
+    ScopedIOHandler(Importer &importer, IOSystem *io) :
+            mImporter(importer) {
+        mImporter.SetIOHandler(io);
+    }
+
+    ~ScopedIOHandler() {
+        mImporter.SetIOHandler(nullptr); /* get pointer back into our possession */
+    }
+
+private:
+    Importer &mImporter;
+};
+#endif // ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+// Imports a single request using the given importer
+void LoadSingleRequest(Importer *importer, LoadRequest &request, bool validate) {
+    // force validation in debug builds
+    unsigned int pp = request.flags;
+    if (validate) {
+        pp |= aiProcess_ValidateDataStructure;
+    }
+
+    // setup config properties if necessary
+    ImporterPimpl *pimpl = importer->Pimpl();
+    pimpl->mFloatProperties = request.map.floats;
+    pimpl->mIntProperties = request.map.ints;
+    pimpl->mStringProperties = request.map.strings;
+    pimpl->mMatrixProperties = request.map.matrices;
+
+    if (!DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_INFO("%%% BEGIN EXTERNAL FILE %%%");
+        ASSIMP_LOG_INFO("File: ", request.file);
+    }
+    importer->ReadFile(request.file, pp);
+    request.scene = importer->GetOrphanedScene();
+    request.loaded = true;
+
+    ASSIMP_LOG_INFO("%%% END EXTERNAL FILE %%%");
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 BatchLoader::BatchLoader(IOSystem *pIO, bool validate) {
     ai_assert(nullptr != pIO);
@@ -544,6 +714,16 @@ bool BatchLoader::getValidation() const {
     return m_data->validate;
 }
 
+// ------------------------------------------------------------------------------------------------
+void BatchLoader::setNumThreads(int numThreads) {
+    m_data->numThreads = numThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+int BatchLoader::getNumThreads() const {
+    return m_data->numThreads;
+}
+
 // ------------------------------------------------------------------------------------------------
 unsigned int BatchLoader::AddLoadRequest(const std::string &file,
         unsigned int steps /*= 0*/, const PropertyMap *map /*= nullptr*/) {
@@ -587,29 +767,33 @@ aiScene *BatchLoader::GetImport(unsigned int which) {
 
 // ------------------------------------------------------------------------------------------------
 void BatchLoader::LoadAll() {
-    // no threaded implementation for the moment
-    for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
-        // force validation in debug builds
-        unsigned int pp = (*it).flags;
-        if (m_data->validate) {
-            pp |= aiProcess_ValidateDataStructure;
-        }
-
-        // setup config properties if necessary
-        ImporterPimpl *pimpl = m_data->pImporter->Pimpl();
-        pimpl->mFloatProperties = (*it).map.floats;
-        pimpl->mIntProperties = (*it).map.ints;
-        pimpl->mStringProperties = (*it).map.strings;
-        pimpl->mMatrixProperties = (*it).map.matrices;
+    int numThreads = m_data->numThreads;
+    if (numThreads < 0) {
+        numThreads = static_cast<int>(ThreadPool::GetHardwareConcurrency());
+    }
 
-        if (!DefaultLogger::isNullLogger()) {
-            ASSIMP_LOG_INFO("%%% BEGIN EXTERNAL FILE %%%");
-            ASSIMP_LOG_INFO("File: ", (*it).file);
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    if (numThreads > 1 && m_data->requests.size() > 1) {
+        std::vector<LoadRequest *> requests;
+        requests.reserve(m_data->requests.size());
+        for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
+            requests.push_back(&(*it));
         }
-        m_data->pImporter->ReadFile((*it).file, pp);
-        (*it).scene = m_data->pImporter->GetOrphanedScene();
-        (*it).loaded = true;
 
-        ASSIMP_LOG_INFO("%%% END EXTERNAL FILE %%%");
+        // Every request gets its own importer, the calling thread takes part
+        std::mutex ioMutex;
+        ThreadPool pool(static_cast<unsigned int>(numThreads - 1));
+        pool.ParallelFor(requests.size(), [&](size_t i) {
+            SynchronizedIOSystem io(m_data->pIOSystem, ioMutex);
+            Importer importer;
+            ScopedIOHandler ioGuard(importer, &io);
+            LoadSingleRequest(&importer, *requests[i], m_data->validate);
+        });
+        return;
+    }
+#endif // ASSIMP_BUILD_SINGLETHREADED
+
+    for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
+        LoadSingleRequest(m_data->pImporter, *it, m_data->validate);
     }
 }
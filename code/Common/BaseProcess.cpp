@@ -42,10 +42,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** @file Implementation of BaseProcess */
 
 #include "BaseProcess.h"
+#include "CancellableProgressHandler.h"
 #include "Importer.h"
+#include "ThreadPool.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/config.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Profiler.h>
 
 using namespace Assimp;
 
@@ -53,7 +57,9 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          progress(),
+          threadPool(),
+          profiler() {
     // empty
 }
 
@@ -68,8 +74,14 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     ai_assert( nullptr != pImp );
     ai_assert( nullptr != pImp->Pimpl()->mScene);
 
-    progress = pImp->GetProgressHandler();
-    ai_assert(nullptr != progress);
+    ai_assert(nullptr != pImp->GetProgressHandler());
+
+    // Route all progress reports through the cancellation check
+    CancellableProgressHandler cancellable(pImp->GetProgressHandler(), pImp->Pimpl()->mCancelRequested);
+    progress = &cancellable;
+
+    threadPool = pImp->Pimpl()->GetThreadPool(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0));
+    profiler = pImp->Pimpl()->mProfiler;
 
     SetupProperties(pImp);
 
@@ -77,6 +89,11 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     try {
         Execute(pImp->Pimpl()->mScene);
 
+        // drop the cached mesh data which is stale now
+        if (nullptr != shared) {
+            const aiScene *scene = pImp->Pimpl()->mScene;
+            shared->InvalidateMeshData(GetMutatedMeshAttributes(), scene->mMeshes, scene->mNumMeshes);
+        }
     } catch (const std::exception &err) {
 
         // extract error description
@@ -86,7 +103,15 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
         // and kill the partially imported data
         delete pImp->Pimpl()->mScene;
         pImp->Pimpl()->mScene = nullptr;
+
+        if (nullptr != shared) {
+            shared->InvalidateMeshData(MeshAttr_All, nullptr, 0);
+        }
     }
+
+    threadPool = nullptr;
+    profiler = nullptr;
+    progress = cancellable.GetWrapped();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -98,3 +123,29 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BaseProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_All;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ParallelFor(unsigned int count, const std::function<void(unsigned int)> &job) {
+    if (nullptr == threadPool || count < 2) {
+        for (unsigned int i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    threadPool->ParallelFor(count, [&job](size_t i) {
+        job(static_cast<unsigned int>(i));
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::AddMetric(const char *name, double value) {
+    if (nullptr != profiler) {
+        profiler->AddMetric(name, value);
+    }
+}
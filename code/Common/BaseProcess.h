@@ -45,13 +45,64 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/GenericProperty.h>
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#include <mutex>
+#endif
 
 struct aiScene;
+struct aiMesh;
 
 namespace Assimp {
 
 class Importer;
+class ThreadPool;
+
+namespace Profiling {
+class Profiler;
+}
+
+// ---------------------------------------------------------------------------
+/** Mesh attributes a post processing step may modify, see
+ *  BaseProcess::GetMutatedMeshAttributes().
+ */
+enum MeshAttributes {
+    MeshAttr_Positions = 0x1,
+    MeshAttr_Normals = 0x2,
+    MeshAttr_TangentsAndBitangents = 0x4,
+    MeshAttr_TexCoords = 0x8,
+    MeshAttr_Colors = 0x10,
+    MeshAttr_Bones = 0x20,
+    MeshAttr_Faces = 0x40,
+
+    //! Meshes were added to, removed from or replaced in the scene
+    MeshAttr_Meshes = 0x80,
+
+    MeshAttr_All = 0xff
+};
+
+// ---------------------------------------------------------------------------
+/** Kinds of data derived from a single mesh which are cached in the
+ *  SharedPostProcessInfo. ProcessHelper.h provides typed accessors.
+ */
+enum MeshDataKind {
+    //! SharedSpatialIndex, depends on the positions
+    MeshData_SpatialIndex,
+
+    //! VertexTriangleAdjacency, depends on the positions and faces
+    MeshData_Adjacency,
+
+    //! std::vector<aiVector3D> with one normal per face, depends on the
+    //! positions and faces
+    MeshData_FaceNormals,
+
+    //! uint64_t hash of the index buffer, depends on the faces
+    MeshData_FaceHash,
+
+    MeshData_Max
+};
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -59,6 +110,11 @@ class Importer;
  *  The class maintains a simple property list that can be used by pp-steps
  *  to provide additional information to other steps. This is primarily
  *  intended for cross-step optimizations.
+ *
+ *  In addition it caches data derived from single meshes, such as spatial
+ *  indices or adjacency tables, so subsequent steps needn't recompute them.
+ *  Cached entries are dropped once a step modifies an attribute they depend
+ *  on, see BaseProcess::GetMutatedMeshAttributes().
  */
 class SharedPostProcessInfo {
 public:
@@ -92,6 +148,7 @@ public:
     // some typedefs for cleaner code
     typedef unsigned int KeyType;
     typedef std::map<KeyType, Base *> PropertyMap;
+    typedef std::map<std::pair<const aiMesh *, unsigned int>, Base *> MeshDataMap;
 
 public:
     //! Destructor
@@ -99,7 +156,7 @@ public:
         Clean();
     }
 
-    //! Remove all stored properties from the table
+    //! Remove all stored properties and cached mesh data from the table
     void Clean() {
         // invoke the virtual destructor for all stored properties
         for (PropertyMap::iterator it = pmap.begin(), end = pmap.end();
@@ -107,6 +164,96 @@ public:
             delete (*it).second;
         }
         pmap.clear();
+        InvalidateMeshData(MeshAttr_All, nullptr, 0);
+    }
+
+    //! Get the mesh attributes a kind of cached mesh data depends on
+    static unsigned int GetMeshDataDependencies(MeshDataKind kind) {
+        switch (kind) {
+        case MeshData_SpatialIndex:
+            return MeshAttr_Positions;
+        case MeshData_Adjacency:
+        case MeshData_FaceNormals:
+            return MeshAttr_Positions | MeshAttr_Faces;
+        case MeshData_FaceHash:
+            return MeshAttr_Faces;
+        default:
+            return MeshAttr_All;
+        }
+    }
+
+    //! Get cached data of a mesh, nullptr if there is none. T must match
+    //! the type the data was stored with. Safe to call from ParallelFor().
+    template <typename T>
+    T *GetMeshData(const aiMesh *mesh, MeshDataKind kind) const {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(meshDataMutex);
+#endif
+        MeshDataMap::const_iterator it = meshData.find(std::make_pair(mesh, (unsigned int)kind));
+        return it == meshData.end() ? nullptr : static_cast<THeapData<T> *>((*it).second)->data;
+    }
+
+    //! Store data derived from a mesh, the cache takes ownership. If there
+    //! is already data for the mesh it is kept and the new data deleted.
+    //! Safe to call from ParallelFor().
+    //! @return The cached data
+    template <typename T>
+    T *AddMeshData(const aiMesh *mesh, MeshDataKind kind, T *data) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(meshDataMutex);
+#endif
+        Base *&entry = meshData[std::make_pair(mesh, (unsigned int)kind)];
+        if (nullptr == entry) {
+            entry = new THeapData<T>(data);
+            return data;
+        }
+        delete data;
+        return static_cast<THeapData<T> *>(entry)->data;
+    }
+
+    //! Remove all cached data of a specific kind
+    void RemoveMeshData(MeshDataKind kind) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(meshDataMutex);
+#endif
+        for (MeshDataMap::iterator it = meshData.begin(); it != meshData.end();) {
+            if ((*it).first.second == (unsigned int)kind) {
+                delete (*it).second;
+                it = meshData.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    //! Drop all cached data which depends on the given attributes, see
+    //! #MeshAttributes, and the data of all meshes which are not in the
+    //! given list anymore.
+    void InvalidateMeshData(unsigned int mutated, const aiMesh *const *meshes, unsigned int numMeshes) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(meshDataMutex);
+#endif
+        if (mutated & MeshAttr_Meshes) {
+            // mesh pointers may have been reused, so nothing can be trusted
+            mutated = MeshAttr_All;
+        }
+        for (MeshDataMap::iterator it = meshData.begin(); it != meshData.end();) {
+            const unsigned int deps = GetMeshDataDependencies((MeshDataKind)(*it).first.second);
+            if ((deps & mutated) || meshes + numMeshes == std::find(meshes, meshes + numMeshes, (*it).first.first)) {
+                delete (*it).second;
+                it = meshData.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    //! Get the number of cached mesh data entries
+    size_t GetMeshDataCount() const {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(meshDataMutex);
+#endif
+        return meshData.size();
     }
 
     //! Add a heap property to the list
@@ -161,9 +308,13 @@ private:
 private:
     //! Map of all stored properties
     PropertyMap pmap;
-};
 
-#define AI_SPP_SPATIAL_SORT "$Spat"
+    //! Data derived from meshes, keyed by mesh and #MeshDataKind
+    MeshDataMap meshData;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    mutable std::mutex meshDataMutex;
+#endif
+};
 
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
@@ -214,6 +365,13 @@ public:
     */
     virtual void SetupProperties(const Importer *pImp);
 
+    // -------------------------------------------------------------------
+    /** Returns the mesh attributes the step may modify, a combination of
+    *  #MeshAttributes. Cached mesh data depending on them is dropped
+    *  after the step ran. The default is #MeshAttr_All.
+    */
+    virtual unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * A process should throw an ImportErrorException* if it fails.
@@ -238,12 +396,36 @@ public:
         return shared;
     }
 
+protected:
+    // -------------------------------------------------------------------
+    /** Calls job(i) for all i in [0,count), typically once per mesh.
+     *  If multithreading is enabled via #AI_CONFIG_GLOB_MULTITHREADING the
+     *  calls are distributed over the importer's thread pool, otherwise
+     *  they are executed in order. A job must only modify data owned by
+     *  its index, results which depend on other indices must be merged
+     *  afterwards to keep the output deterministic.
+     */
+    void ParallelFor(unsigned int count, const std::function<void(unsigned int)> &job);
+
+    // -------------------------------------------------------------------
+    /** Reports a named value to the import statistics, see #aiProfileMetric.
+     *  Does nothing unless #AI_CONFIG_GLOB_MEASURE_TIME is set. Must not be
+     *  called from within ParallelFor().
+     */
+    void AddMetric(const char *name, double value);
+
 protected:
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo *shared;
 
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Worker threads for ParallelFor(), nullptr to run serially */
+    ThreadPool *threadPool;
+
+    /** Profiler of the running import, nullptr if no statistics are gathered */
+    Profiling::Profiler *profiler;
 };
 
 } // end of namespace Assimp
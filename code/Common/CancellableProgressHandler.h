@@ -0,0 +1,107 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file CancellableProgressHandler.h
+ *  @brief Progress handler which aborts an import once it was cancelled.
+ */
+#ifndef INCLUDED_AI_CANCELLABLEPROGRESSHANDLER_H
+#define INCLUDED_AI_CANCELLABLEPROGRESSHANDLER_H
+
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/Exceptional.h>
+
+#include <atomic>
+
+namespace Assimp    {
+
+// ------------------------------------------------------------------------------------
+/** @brief Internal wrapper around the progress handler of an #Importer.
+ *
+ *  All reports are forwarded to the wrapped handler. Once the cancellation flag
+ *  is set, the next report throws a #DeadlyImportError instead, which aborts the
+ *  loader or post-processing step that made it. */
+class CancellableProgressHandler : public ProgressHandler    {
+public:
+    CancellableProgressHandler(ProgressHandler *wrapped, const std::atomic<bool> &cancelled) :
+            mWrapped(wrapped), mCancelled(cancelled) {
+        // empty
+    }
+
+    bool Update(float percentage) override {
+        ThrowIfCancelled();
+        return mWrapped->Update(percentage);
+    }
+
+    void UpdateFileRead(int currentStep, int numberOfSteps) override {
+        ThrowIfCancelled();
+        mWrapped->UpdateFileRead(currentStep, numberOfSteps);
+    }
+
+    void UpdatePostProcess(int currentStep, int numberOfSteps) override {
+        ThrowIfCancelled();
+        mWrapped->UpdatePostProcess(currentStep, numberOfSteps);
+    }
+
+    void UpdateFileWrite(int currentStep, int numberOfSteps) override {
+        ThrowIfCancelled();
+        mWrapped->UpdateFileWrite(currentStep, numberOfSteps);
+    }
+
+    /// @brief  Throws if the import was cancelled.
+    void ThrowIfCancelled() const {
+        if (mCancelled) {
+            throw DeadlyImportError("Import cancelled");
+        }
+    }
+
+    /// @brief  Returns the handler of the application.
+    ProgressHandler *GetWrapped() const {
+        return mWrapped;
+    }
+
+private:
+    ProgressHandler *mWrapped;
+    const std::atomic<bool> &mCancelled;
+}; // !class CancellableProgressHandler
+} // Namespace Assimp
+
+#endif
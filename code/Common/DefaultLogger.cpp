@@ -62,6 +62,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <mutex>
 #include <thread>
 std::mutex loggerMutex;
+std::mutex loggerStreamMutex;
 #endif
 
 namespace Assimp {
@@ -387,6 +388,11 @@ DefaultLogger::~DefaultLogger() {
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev) {
     ai_assert(nullptr != message);
 
+    // post-processing steps may log from several worker threads
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(loggerStreamMutex);
+#endif
+
     // Check whether this is a repeated message
     if (!::strncmp(message, lastMsg, lastLen - 1)) {
         if (!noRepeatMsg) {
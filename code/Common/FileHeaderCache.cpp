@@ -0,0 +1,152 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file FileHeaderCache.cpp
+ *  @brief Implementation of the file header cache used by format detection.
+ */
+
+#include "FileHeaderCache.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using namespace Assimp;
+
+namespace {
+
+// innermost cache installed by the calling thread
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+thread_local
+#endif
+FileHeaderCache *gCurrentCache = nullptr;
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+FileHeaderCache::FileHeaderCache(IOSystem *pIOHandler, const std::string &pFile) :
+        mIOHandler(pIOHandler),
+        mFile(pFile),
+        mData(),
+        mLoaded(false),
+        mComplete(false),
+        mPrevious(gCurrentCache) {
+    ai_assert(nullptr != pIOHandler);
+    gCurrentCache = this;
+}
+
+// ------------------------------------------------------------------------------------------------
+FileHeaderCache::~FileHeaderCache() {
+    ai_assert(gCurrentCache == this);
+    gCurrentCache = mPrevious;
+}
+
+// ------------------------------------------------------------------------------------------------
+FileHeaderCache *FileHeaderCache::Get(const IOSystem *pIOHandler, const std::string &pFile) {
+    for (FileHeaderCache *cache = gCurrentCache; nullptr != cache; cache = cache->mPrevious) {
+        if (cache->mIOHandler == pIOHandler && cache->mFile == pFile) {
+            return cache;
+        }
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t FileHeaderCache::ReadHeader(IOSystem *pIOHandler, const std::string &pFile, void *buffer, size_t size) {
+    FileHeaderCache *cache = Get(pIOHandler, pFile);
+    const char *data = nullptr;
+    size_t numRead = 0;
+    if (nullptr != cache && cache->Peek(0, size, data, numRead)) {
+        if (numRead > 0) {
+            ::memcpy(buffer, data, numRead);
+        }
+        return numRead;
+    }
+
+    std::unique_ptr<IOStream> stream(pIOHandler->Open(pFile));
+    if (!stream) {
+        return 0;
+    }
+    return stream->Read(buffer, 1, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FileHeaderCache::Peek(size_t offset, size_t size, const char *&data, size_t &numRead) {
+    Load();
+
+    if (offset + size > mData.size() && !mComplete) {
+        return false;
+    }
+
+    numRead = offset < mData.size() ? std::min(size, mData.size() - offset) : 0;
+    data = numRead > 0 ? &mData[offset] : nullptr;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FileHeaderCache::IsLoaded() const {
+    return mLoaded;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FileHeaderCache::Load() {
+    if (mLoaded) {
+        return;
+    }
+    mLoaded = true;
+
+    // a file which can't be opened behaves like an empty one
+    mComplete = true;
+    std::unique_ptr<IOStream> stream(mIOHandler->Open(mFile));
+    if (!stream) {
+        return;
+    }
+
+    mData.resize(HeaderSize);
+    const size_t read = stream->Read(mData.data(), 1, HeaderSize);
+    mData.resize(read);
+    mComplete = read < HeaderSize;
+}
@@ -0,0 +1,117 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file FileHeaderCache.h
+ *  @brief Shares the leading bytes of a file between the signature checks
+ *  of format auto-detection.
+ */
+#pragma once
+#ifndef AI_FILEHEADERCACHE_H_INC
+#define AI_FILEHEADERCACHE_H_INC
+
+#include <assimp/defs.h>
+
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+class IOSystem;
+
+// ---------------------------------------------------------------------------
+/** Holds the first bytes of a file while its format is detected.
+ *
+ *  While an instance is alive, BaseImporter::SearchFileHeaderForToken() and
+ *  BaseImporter::CheckMagicToken() calls made by the same thread for the same
+ *  file and IOSystem are answered from this buffer instead of opening the file
+ *  again. The header is read lazily, at most once. Instances nest, so
+ *  imports started during detection are not affected.
+ */
+class ASSIMP_API FileHeaderCache {
+public:
+    /// Number of bytes read from the start of the file.
+    static const size_t HeaderSize = 4096;
+
+    /// @brief  Installs the cache for the calling thread.
+    FileHeaderCache(IOSystem *pIOHandler, const std::string &pFile);
+
+    /// @brief  Uninstalls the cache again.
+    ~FileHeaderCache();
+
+    /// @brief  Looks up the cache installed by the calling thread.
+    /// @return The cache for the file, nullptr if there is none.
+    static FileHeaderCache *Get(const IOSystem *pIOHandler, const std::string &pFile);
+
+    /// @brief  Reads the first bytes of a file, from the installed cache if there is one.
+    /// @param  buffer   Receives the bytes.
+    /// @param  size     The number of bytes to read.
+    /// @return The number of bytes read, 0 if the file could not be opened.
+    static size_t ReadHeader(IOSystem *pIOHandler, const std::string &pFile, void *buffer, size_t size);
+
+    /// @brief  Provides up to size bytes starting at offset, reading the header on first use.
+    /// @param  data     Receives a pointer to the bytes.
+    /// @param  numRead  Receives the number of bytes available. This is less than size
+    ///                  only if the file ends early or could not be opened.
+    /// @return false if the range exceeds the header, the caller needs to read the
+    ///         file itself in this case.
+    bool Peek(size_t offset, size_t size, const char *&data, size_t &numRead);
+
+    /// @brief  Returns whether the header was read from the file already.
+    bool IsLoaded() const;
+
+private:
+    FileHeaderCache(const FileHeaderCache &) = delete;
+    FileHeaderCache &operator=(const FileHeaderCache &) = delete;
+
+    void Load();
+
+    IOSystem *mIOHandler;
+    std::string mFile;
+    std::vector<char> mData;
+    bool mLoaded;
+    bool mComplete;
+    FileHeaderCache *mPrevious;
+};
+
+} // namespace Assimp
+
+#endif // AI_FILEHEADERCACHE_H_INC
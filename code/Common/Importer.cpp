@@ -65,9 +65,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/Importer.h"
 #include "Common/BaseProcess.h"
 #include "Common/DefaultProgressHandler.h"
+#include "Common/CancellableProgressHandler.h"
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/SceneArena.h"
+#include "Common/ThreadPool.h"
+#include "Common/FileHeaderCache.h"
+#include "Common/ProfilingIOSystem.h"
 
 #include <assimp/BaseImporter.h>
 #include <assimp/GenericProperty.h>
@@ -75,13 +80,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Profiler.h>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
 
 #include <exception>
+#include <future>
 #include <set>
+#include <system_error>
 #include <memory>
 #include <cctype>
+#include <cstdlib>
+#include <typeinfo>
+
+#ifdef __GNUC__
+#   include <cxxabi.h>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -105,6 +117,118 @@ namespace Assimp {
 using namespace Assimp;
 using namespace Assimp::Intern;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Returns the profiler to record into, created on demand. nullptr if no statistics are gathered.
+Profiler *GetProfiler(const Importer *importer, ImporterPimpl *pimpl) {
+    if (!importer->GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0)) {
+        return nullptr;
+    }
+    if (nullptr == pimpl->mProfiler) {
+        pimpl->mProfiler = new Profiler();
+    }
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Drops the hierarchy built by aiProcess_GenBoundingBoxes before other steps change the scene,
+// it points to its nodes and meshes. That step runs last and builds a new one if requested.
+void ResetSceneBVH(aiScene *scene) {
+    ScenePrivateData *priv = ScenePriv(scene);
+    if (nullptr != priv) {
+        priv->mBVH.reset();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Region name of a post-processing step, i.e. its unqualified class name
+std::string GetProcessName(const BaseProcess *process) {
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+    std::string name = typeid(*process).name();
+#ifdef __GNUC__
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (0 == status && nullptr != demangled) {
+        name = demangled;
+    }
+    free(demangled);
+#endif
+    // strip namespaces and the 'class ' prefix msvc adds
+    const std::string::size_type pos = name.find_last_of(": ");
+    if (pos != std::string::npos) {
+        name = name.substr(pos + 1);
+    }
+    return name;
+#else
+    (void)process;
+    return "PostProcessStep";
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Opens the top-level region of a ReadFile() call and counts the bytes read
+// through the IOSystem while it is alive.
+class ProfilingSession {
+public:
+    ProfilingSession(ImporterPimpl *pimpl, Profiler *profiler) :
+            mPimpl(pimpl), mProfiler(profiler) {
+        if (nullptr == mProfiler) {
+            return;
+        }
+        mIOHandler.reset(new ProfilingIOSystem(mPimpl->mIOHandler, mProfiler));
+        mPimpl->mIOHandler = mIOHandler.get();
+        mProfiler->BeginRegion("total");
+    }
+
+    ~ProfilingSession() {
+        if (nullptr == mProfiler) {
+            return;
+        }
+        mProfiler->EndRegion("total");
+        mPimpl->mIOHandler = mIOHandler->GetWrapped();
+    }
+
+private:
+    ImporterPimpl *mPimpl;
+    Profiler *mProfiler;
+    std::unique_ptr<ProfilingIOSystem> mIOHandler;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Marks an import as running, a pending cancellation request is consumed when it ends
+class ImportRunningScope {
+public:
+    explicit ImportRunningScope(ImporterPimpl *pimpl) :
+            mPimpl(pimpl) {
+        mPimpl->mImportRunning = true;
+    }
+
+    ~ImportRunningScope() {
+        mPimpl->mImportRunning = false;
+        mPimpl->mCancelRequested = false;
+    }
+
+private:
+    ImporterPimpl *mPimpl;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Drops the scene if the import was cancelled meanwhile
+bool IsCancelled(ImporterPimpl *pimpl) {
+    if (!pimpl->mCancelRequested) {
+        return false;
+    }
+
+    pimpl->mErrorString = "Import cancelled";
+    ASSIMP_LOG_INFO(pimpl->mErrorString);
+    delete pimpl->mScene;
+    pimpl->mScene = nullptr;
+    return true;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Intern::AllocateFromAssimpHeap serves as abstract base class. It overrides
 // new and delete (and their array counterparts) of public API classes (e.g. Logger) to
@@ -144,6 +268,33 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)    {
     return ::operator delete[](data);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reports strings which exceed the aiString capacity, see ASSIMP_AISTRING_MAXLEN
+void Assimp::Intern::ReportStringTruncation(const char *str, size_t length) {
+    ASSIMP_LOG_WARN("String of ", length, " bytes exceeds the aiString capacity of ", MAXLEN - 1,
+            " bytes and is cropped: \"", std::string(str, 32), "...\"");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the pool of worker threads, (re)created if the requested thread count changed.
+ThreadPool* ImporterPimpl::GetThreadPool(int numThreads) {
+    if (numThreads < 0) {
+        numThreads = static_cast<int>(ThreadPool::GetHardwareConcurrency());
+    }
+
+    // the calling thread always takes part in the work
+    const unsigned int numWorkers = numThreads > 1 ? static_cast<unsigned int>(numThreads - 1) : 0u;
+    if (0 == numWorkers) {
+        return nullptr;
+    }
+
+    if (nullptr == mThreadPool || mThreadPool->GetNumThreads() != numWorkers) {
+        delete mThreadPool;
+        mThreadPool = new ThreadPool(numWorkers);
+    }
+    return mThreadPool;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor.
 Importer::Importer()
@@ -193,6 +344,11 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Stop the worker threads
+    delete pimpl->mThreadPool;
+
+    delete pimpl->mProfiler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -408,6 +564,26 @@ const std::exception_ptr& Importer::GetException() const {
     return pimpl->mException;
 }
 
+// ------------------------------------------------------------------------------------------------
+const aiImportStatistics* Importer::GetImportStatistics() const {
+    ai_assert(nullptr != pimpl);
+
+    if (nullptr == pimpl->mProfiler || 0 == pimpl->mProfiler->GetStatistics()->mNumRegions) {
+        return nullptr;
+    }
+    return pimpl->mProfiler->GetStatistics();
+}
+
+// ------------------------------------------------------------------------------------------------
+const SceneBVH *Importer::GetSceneBVH() const {
+    ai_assert(nullptr != pimpl);
+
+    if (nullptr == pimpl->mScene || nullptr == ScenePriv(pimpl->mScene)) {
+        return nullptr;
+    }
+    return ScenePriv(pimpl->mScene)->mBVH.get();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Enable extra-verbose mode
 void Importer::SetExtraVerbose(bool bDo) {
@@ -591,6 +767,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
     //-----------------------------------------------------------------------
 
     WriteLogOpening(pFile);
+    ImportRunningScope running(pimpl);
 
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
     try
@@ -604,6 +781,10 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             FreeScene();
         }
 
+        // Statistics always refer to the last call
+        delete pimpl->mProfiler;
+        pimpl->mProfiler = nullptr;
+
         // First check if the file is accessible at all
         if( !pimpl->mIOHandler->Exists( pFile)) {
 
@@ -612,11 +793,15 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             return nullptr;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+        Profiler *profiler = GetProfiler(this, pimpl);
+        ProfilingSession session(pimpl, profiler);
         if (profiler) {
-            profiler->BeginRegion("total");
+            profiler->BeginRegion("detection");
         }
 
+        // Signature checks share a single read of the file header
+        std::unique_ptr<FileHeaderCache> header(new FileHeaderCache(pimpl->mIOHandler, pFile));
+
         // Find an worker class which can handle the file
         BaseImporter* imp = nullptr;
         SetPropertyInteger("importerIndex", -1);
@@ -635,8 +820,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             if (s != std::string::npos) {
                 ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
                 for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-                    if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-                        imp = pimpl->mImporter[a];
+                    // formats with declared magic tokens are matched against the header directly
+                    BaseImporter *candidate = pimpl->mImporter[a];
+                    const MagicTokenInfo *magic = candidate->GetMagicTokens();
+                    const bool found = nullptr != magic ?
+                            BaseImporter::CheckMagicToken(pimpl->mIOHandler, pFile, magic->tokens, magic->num, magic->offset, magic->size) :
+                            candidate->CanRead( pFile, pimpl->mIOHandler, true);
+                    if( found) {
+                        imp = candidate;
                         SetPropertyInteger("importerIndex", a);
                         break;
                     }
@@ -650,6 +841,16 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             }
         }
 
+        header.reset();
+
+        if (profiler) {
+            profiler->EndRegion("detection");
+        }
+
+        if (IsCancelled(pimpl)) {
+            return nullptr;
+        }
+
         // Get file size for progress handler
         IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
         uint32_t fileSize = 0;
@@ -681,6 +882,11 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
         SetPropertyString("sourceFilePath", pFile);
 
+        // A loader which doesn't report progress can't be interrupted, drop its result
+        if (IsCancelled(pimpl)) {
+            return nullptr;
+        }
+
         // If successful, apply all active post processing steps to the imported data
         if( pimpl->mScene)  {
             if (!pimpl->mScene->mMetaData || !pimpl->mScene->mMetaData->HasKey(AI_METADATA_SOURCE_FORMAT)) {
@@ -693,11 +899,23 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure) {
+                if (profiler) {
+                    profiler->BeginRegion("validate");
+                }
+
                 ValidateDSProcess ds;
                 ds.ExecuteOnScene (this);
                 if (!pimpl->mScene) {
                     return nullptr;
                 }
+
+                if (profiler) {
+                    profiler->EndRegion("validate");
+                }
+
+                if (IsCancelled(pimpl)) {
+                    return nullptr;
+                }
             }
 #endif // no validation
 
@@ -715,6 +933,15 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+            // The last step may have been running when the import was cancelled
+            if (IsCancelled(pimpl)) {
+                return nullptr;
+            }
+
+            if (pimpl->mScene && GetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, false)) {
+                PackSceneIntoArena(pimpl->mScene);
+            }
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -724,10 +951,6 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
         // clear any data allocated by post-process steps
         pimpl->mPPShared->Clean();
-
-        if (profiler) {
-            profiler->EndRegion("total");
-        }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
     catch (std::exception &e) {
@@ -749,6 +972,36 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
     return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reads the given file on a worker thread
+std::future<const aiScene*> Importer::ReadFileAsync(const std::string &pFile, unsigned int pFlags) {
+    // Mark the import as running right away, so a cancellation issued before the
+    // worker got scheduled isn't lost.
+    pimpl->mCancelRequested = false;
+    pimpl->mImportRunning = true;
+
+    auto job = [this, pFile, pFlags]() {
+        return ReadFile(pFile.c_str(), pFlags);
+    };
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    try {
+        return std::async(std::launch::async, job);
+    } catch (const std::system_error &e) {
+        // no thread available, the import runs when the result is requested
+        ASSIMP_LOG_WARN("Unable to start the import thread, deferring the import: ", e.what());
+    }
+#endif
+    return std::async(std::launch::deferred, job);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Requests the running import to stop
+void Importer::CancelReadFile() {
+    if (pimpl->mImportRunning) {
+        pimpl->mCancelRequested = true;
+    }
+}
 
 // ------------------------------------------------------------------------------------------------
 // Apply post-processing to the currently bound scene
@@ -770,12 +1023,25 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     ai_assert(_ValidateFlags(pFlags));
     ASSIMP_LOG_INFO("Entering post processing pipeline");
 
+    // The steps replace arrays of the scene, move it out of its arena first
+    const bool packed = UnpackSceneFromArena(pimpl->mScene);
+
+    Profiler *profiler = GetProfiler(this, pimpl);
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
     if (pFlags & aiProcess_ValidateDataStructure) {
+        if (profiler) {
+            profiler->BeginRegion("validate");
+        }
+
         ValidateDSProcess ds;
         ds.ExecuteOnScene (this);
+
+        if (profiler) {
+            profiler->EndRegion("validate");
+        }
         if (!pimpl->mScene) {
             return nullptr;
         }
@@ -795,19 +1061,31 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    if (pFlags & ~aiProcess_ValidateDataStructure) {
+        ResetSceneBVH(pimpl->mScene);
+    }
+
+    if (profiler) {
+        profiler->BeginRegion("postprocess");
+    }
+
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
+        if (IsCancelled(pimpl)) {
+            break;
+        }
+
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
+            const std::string name = profiler ? GetProcessName(process) : std::string();
             if (profiler) {
-                profiler->BeginRegion("postprocess");
+                profiler->BeginRegion(name);
             }
 
             process->ExecuteOnScene ( this );
 
             if (profiler) {
-                profiler->EndRegion("postprocess");
+                profiler->EndRegion(name);
             }
         }
         if( !pimpl->mScene) {
@@ -835,9 +1113,16 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()), 
         static_cast<int>(pimpl->mPostProcessingSteps.size()) );
 
+    if (profiler) {
+        profiler->EndRegion("postprocess");
+    }
+
     // update private scene flags
     if( pimpl->mScene ) {
       ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+      if (packed) {
+          PackSceneIntoArena(pimpl->mScene);
+      }
     }
 
     // clear any data allocated by post-process steps
@@ -868,6 +1153,9 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     // In debug builds: run basic flag validation
     ASSIMP_LOG_INFO( "Entering customized post processing pipeline" );
 
+    // The step replaces arrays of the scene, move it out of its arena first
+    const bool packed = UnpackSceneFromArena( pimpl->mScene );
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
@@ -893,12 +1181,14 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    Profiler *profiler = GetProfiler( this, pimpl );
 
     if ( profiler ) {
         profiler->BeginRegion( "postprocess" );
+        profiler->BeginRegion( GetProcessName( rootProcess ) );
     }
 
+    ResetSceneBVH( pimpl->mScene );
     rootProcess->ExecuteOnScene( this );
 
     if ( profiler ) {
@@ -916,6 +1206,10 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
         }
     }
 
+    if ( packed && pimpl->mScene ) {
+        PackSceneIntoArena( pimpl->mScene );
+    }
+
     // clear any data allocated by post-process steps
     pimpl->mPPShared->Clean();
     ASSIMP_LOG_INFO( "Leaving customized post processing pipeline" );
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_IMPORTER_H
 #define INCLUDED_AI_IMPORTER_H
 
+#include <atomic>
 #include <exception>
 #include <map>
 #include <vector>
@@ -58,6 +59,11 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ThreadPool;
+
+    namespace Profiling {
+        class Profiler;
+    }
 
 
 //! @cond never
@@ -123,8 +129,25 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Worker threads for post-processing, created on demand */
+    ThreadPool* mThreadPool;
+
+    /** Statistics of the last import, nullptr unless #AI_CONFIG_GLOB_MEASURE_TIME is set */
+    Profiling::Profiler* mProfiler;
+
+    /** Set while ReadFile() runs or an asynchronous import is pending */
+    std::atomic<bool> mImportRunning;
+
+    /** Set by Importer::CancelReadFile(), checked by loaders and between post-processing steps */
+    std::atomic<bool> mCancelRequested;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
+
+    /// @brief  Returns the thread pool for the given multithreading policy.
+    /// @param  numThreads  Value of #AI_CONFIG_GLOB_MULTITHREADING.
+    /// @return The pool, nullptr if the work shall be done serially.
+    ThreadPool* GetThreadPool(int numThreads);
 };
 
 inline
@@ -143,7 +166,11 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mStringProperties(),
         mMatrixProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mThreadPool( nullptr ),
+        mProfiler( nullptr ),
+        mImportRunning( false ),
+        mCancelRequested( false ) {
     // empty
 }
 //! @endcond
@@ -154,8 +181,9 @@ struct BatchData;
 /** FOR IMPORTER PLUGINS ONLY: A helper class to the pleasure of importers
  *  that need to load many external meshes recursively.
  *
- *  The class uses several threads to load these meshes (or at least it
- *  could, this has not yet been implemented at the moment).
+ *  If enabled with setNumThreads(), the class uses several threads to load
+ *  these meshes. Each request is then imported by its own Importer instance,
+ *  calls into the shared IOSystem are serialized.
  *
  *  @note The class may not be used by more than one thread*/
 class ASSIMP_API BatchLoader {
@@ -203,6 +231,21 @@ public:
      *  @return The current validation step.
      */
     bool getValidation() const;
+
+    // -------------------------------------------------------------------
+    /** Sets the number of threads used by LoadAll().
+     *  @param  numThreads  0 or 1 to load all requests serially (the
+     *    default), -1 to use one thread per hardware thread or any
+     *    number larger than 1. Same semantics as
+     *    #AI_CONFIG_GLOB_MULTITHREADING.
+     */
+    void setNumThreads( int numThreads );
+
+    // -------------------------------------------------------------------
+    /** Returns the number of threads used by LoadAll().
+     *  @return The current multithreading policy.
+     */
+    int getNumThreads() const;
     
     // -------------------------------------------------------------------
     /** Add a new file to the list of files to be loaded.
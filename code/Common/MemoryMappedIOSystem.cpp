@@ -0,0 +1,266 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file  MemoryMappedIOSystem.cpp
+ *  @brief Implementation of the memory-mapped IOSystem / IOStream.
+ */
+
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/ai_assert.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Only pure read modes can be served by a read-only mapping
+bool IsReadOnlyMode(const char *mode) {
+    return nullptr != mode && mode[0] == 'r' && nullptr == strchr(mode, '+');
+}
+
+#ifdef _WIN32
+// ------------------------------------------------------------------------------------------------
+std::wstring Utf8ToWide(const char *in) {
+    const int size = MultiByteToWideChar(CP_UTF8, 0, in, -1, nullptr, 0);
+    if (size <= 0) {
+        return std::wstring();
+    }
+    std::wstring out(static_cast<size_t>(size) - 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, in, -1, &out[0], size);
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Maps the file, returns the view and the mapping handle or nullptr on failure.
+const uint8_t *MapFile(const char *file, size_t &size, void *&handle) {
+    HANDLE hFile = ::CreateFileW(Utf8ToWide(file).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (INVALID_HANDLE_VALUE == hFile) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(hFile, &fileSize) || 0 == fileSize.QuadPart ||
+            static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX) {
+        ::CloseHandle(hFile);
+        return nullptr;
+    }
+
+    HANDLE hMapping = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(hFile);
+    if (nullptr == hMapping) {
+        return nullptr;
+    }
+
+    void *view = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (nullptr == view) {
+        ::CloseHandle(hMapping);
+        return nullptr;
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    handle = hMapping;
+    return static_cast<const uint8_t *>(view);
+}
+
+// ------------------------------------------------------------------------------------------------
+void UnmapFile(const uint8_t *data, size_t, void *handle) {
+    ::UnmapViewOfFile(data);
+    ::CloseHandle(static_cast<HANDLE>(handle));
+}
+#else
+// ------------------------------------------------------------------------------------------------
+// Maps the file, returns the view or nullptr on failure. No handle is needed
+// on POSIX systems, the mapping stays valid after closing the descriptor.
+const uint8_t *MapFile(const char *file, size_t &size, void *&handle) {
+    const int fd = ::open(file, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat) || !S_ISREG(fileStat.st_mode) || 0 == fileStat.st_size ||
+            static_cast<unsigned long long>(fileStat.st_size) > SIZE_MAX) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t len = static_cast<size_t>(fileStat.st_size);
+    void *view = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == view) {
+        return nullptr;
+    }
+
+#ifdef POSIX_MADV_SEQUENTIAL
+    // importers typically scan the whole file front to back
+    ::posix_madvise(view, len, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    size = len;
+    handle = nullptr;
+    return static_cast<const uint8_t *>(view);
+}
+
+// ------------------------------------------------------------------------------------------------
+void UnmapFile(const uint8_t *data, size_t size, void *) {
+    ::munmap(const_cast<uint8_t *>(data), size);
+}
+#endif
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::MemoryMappedIOStream(const uint8_t *data, size_t size, void *handle, const std::string &filename) :
+        mData(data),
+        mSize(size),
+        mPos(0),
+        mHandle(handle),
+        mFilename(filename) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::~MemoryMappedIOStream() {
+    if (nullptr != mData) {
+        UnmapFile(mData, mSize, mHandle);
+        mData = nullptr;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    if (0 == pCount) {
+        return 0;
+    }
+    ai_assert(nullptr != pvBuffer);
+    ai_assert(0 != pSize);
+
+    const size_t cnt = std::min(pCount, (mSize - mPos) / pSize);
+    const size_t ofs = pSize * cnt;
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+
+    return cnt;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Write(const void *, size_t, size_t) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MemoryMappedIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    if (aiOrigin_SET == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = mSize - pOffset;
+    } else {
+        if (pOffset + mPos > mSize) {
+            return AI_FAILURE;
+        }
+        mPos += pOffset;
+    }
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryMappedIOStream::Flush() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+const uint8_t *MemoryMappedIOStream::GetReadOnlyView() const {
+    return mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Open a new file with a given path.
+IOStream *MemoryMappedIOSystem::Open(const char *strFile, const char *strMode) {
+    ai_assert(strFile != nullptr);
+    ai_assert(strMode != nullptr);
+
+    if (IsReadOnlyMode(strMode)) {
+        size_t size = 0;
+        void *handle = nullptr;
+        const uint8_t *data = MapFile(strFile, size, handle);
+        if (nullptr != data) {
+            return new MemoryMappedIOStream(data, size, handle, strFile);
+        }
+        ASSIMP_LOG_VERBOSE_DEBUG("Unable to map ", strFile, ", falling back to buffered reading");
+    }
+
+    return DefaultIOSystem::Open(strFile, strMode);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Closes the given file and releases all resources associated with it.
+void MemoryMappedIOSystem::Close(IOStream *pFile) {
+    delete pFile;
+}
@@ -56,6 +56,9 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_JOINVERTICES_PROCESS
 #   include "PostProcessing/JoinVerticesProcess.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+#   include "PostProcessing/SimplifyProcess.h"
+#endif
 #if !(defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS && defined ASSIMP_BUILD_NO_FLIPUVS_PROCESS && defined ASSIMP_BUILD_NO_FLIPWINDINGORDER_PROCESS)
 #   include "PostProcessing/ConvertToLHProcess.h"
 #endif
@@ -134,6 +137,9 @@ corresponding preprocessor flag to selectively disable steps.
 #if (!defined ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS)
 #   include "PostProcessing/ArmaturePopulate.h"
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+#   include "PostProcessing/GenMeshletsProcess.h"
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
 #   include "PostProcessing/GenBoundingBoxesProcess.h"
 #endif
@@ -150,7 +156,7 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
     // of sequence it is executed. Steps that are added here are not
     // validated - as RegisterPPStep() does - all dependencies must be given.
     // ----------------------------------------------------------------------------
-    out.reserve(31);
+    out.reserve(40);
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
     out.push_back( new MakeLeftHandedProcess());
 #endif
@@ -245,6 +251,10 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
     out.push_back( new DestroySpatialSortProcess());
     // .........................................................................
 
+#if (!defined ASSIMP_BUILD_NO_SIMPLIFY_PROCESS)
+    out.push_back( new SimplifyProcess());
+#endif
+
 #if (!defined ASSIMP_BUILD_NO_SPLITLARGEMESHES_PROCESS)
     out.push_back( new SplitLargeMeshesProcess_Vertex());
 #endif
@@ -257,6 +267,9 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+    out.push_back( new GenMeshletsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
     out.push_back(new GenBoundingBoxesProcess);
 #endif
@@ -0,0 +1,94 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file Profiler.cpp
+ *  @brief Process-wide state of the import profiler.
+ */
+
+#include <assimp/Profiler.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <time.h>
+#endif
+#include <ctime>
+
+using namespace Assimp::Profiling;
+
+namespace {
+
+// Installed through aiSetAllocationCounter, shared by all profilers of the library
+std::atomic<aiAllocationCounter> gAllocationCounter(nullptr);
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::SetAllocationCounter(aiAllocationCounter counter) {
+    gAllocationCounter = counter;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t Profiler::CountAllocations() {
+    const aiAllocationCounter counter = gAllocationCounter;
+    return nullptr != counter ? counter() : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+double Profiler::GetThreadCpuTime() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        const uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+        const uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+        // FILETIME counts 100 ns intervals
+        return static_cast<double>(k + u) * 1e-7;
+    }
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (0 == ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) {
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+#endif
+    // no per thread clock, fall back to the processor time of the process
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
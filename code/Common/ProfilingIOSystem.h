@@ -0,0 +1,181 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ProfilingIOSystem.h
+ *  @brief IOSystem proxy which accounts the bytes read by an import to a Profiler
+ */
+#pragma once
+#ifndef AI_PROFILINGIOSYSTEM_H_INCLUDED
+#define AI_PROFILINGIOSYSTEM_H_INCLUDED
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/Profiler.h>
+#include <assimp/ai_assert.h>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Stream wrapper which reports every successful read to a profiler.
+ *  Taking a read-only view of the stream counts as reading all of it. */
+class ProfilingIOStream : public IOStream {
+public:
+    ProfilingIOStream(IOStream *wrapped, Profiling::Profiler *profiler) :
+            mWrapped(wrapped), mProfiler(profiler) {
+        ai_assert(nullptr != mWrapped);
+    }
+
+    /** Streams may be deleted directly instead of being closed */
+    ~ProfilingIOStream() override {
+        delete mWrapped;
+    }
+
+    /** Give up ownership of the wrapped stream */
+    IOStream *Release() {
+        IOStream *wrapped = mWrapped;
+        mWrapped = nullptr;
+        return wrapped;
+    }
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override {
+        const size_t read = mWrapped->Read(pvBuffer, pSize, pCount);
+        mProfiler->AddBytesRead(static_cast<uint64_t>(read) * pSize);
+        return read;
+    }
+
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        return mWrapped->Write(pvBuffer, pSize, pCount);
+    }
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
+        return mWrapped->Seek(pOffset, pOrigin);
+    }
+
+    size_t Tell() const override {
+        return mWrapped->Tell();
+    }
+
+    size_t FileSize() const override {
+        return mWrapped->FileSize();
+    }
+
+    void Flush() override {
+        mWrapped->Flush();
+    }
+
+    const uint8_t *GetReadOnlyView() const override {
+        const uint8_t *view = mWrapped->GetReadOnlyView();
+        if (nullptr != view) {
+            mProfiler->AddBytesRead(mWrapped->FileSize());
+        }
+        return view;
+    }
+
+private:
+    IOStream *mWrapped;
+    Profiling::Profiler *mProfiler;
+};
+
+// ---------------------------------------------------------------------------
+/** IOSystem proxy installed by the Importer while statistics are gathered.
+ *  It keeps its own directory stack and forwards everything else. */
+class ProfilingIOSystem : public IOSystem {
+public:
+    ProfilingIOSystem(IOSystem *wrapped, Profiling::Profiler *profiler) :
+            mWrapped(wrapped), mProfiler(profiler) {
+        ai_assert(nullptr != mWrapped);
+        ai_assert(nullptr != mProfiler);
+    }
+
+    IOSystem *GetWrapped() const {
+        return mWrapped;
+    }
+
+    bool Exists(const char *pFile) const override {
+        return mWrapped->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mWrapped->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        IOStream *stream = mWrapped->Open(pFile, pMode);
+        if (nullptr == stream) {
+            return nullptr;
+        }
+        return new ProfilingIOStream(stream, mProfiler);
+    }
+
+    void Close(IOStream *pFile) override {
+        if (nullptr == pFile) {
+            return;
+        }
+        ProfilingIOStream *stream = static_cast<ProfilingIOStream *>(pFile);
+        mWrapped->Close(stream->Release());
+        delete stream;
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        return mWrapped->ComparePaths(one, second);
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        return mWrapped->DeleteFile(file);
+    }
+
+private:
+    IOSystem *mWrapped;
+    Profiling::Profiler *mProfiler;
+};
+
+} // Namespace Assimp
+
+#endif // AI_PROFILINGIOSYSTEM_H_INCLUDED
@@ -0,0 +1,390 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneArena.cpp
+ *  @brief Implementation of the scene arena and of packing scenes into it.
+ */
+
+#include "SceneArena.h"
+#include "ScenePrivate.h"
+
+#include <assimp/anim.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+using namespace Assimp;
+
+const size_t SceneArena::Alignment;
+const size_t SceneArena::DefaultBlockSize;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+inline size_t AlignUp(size_t size) {
+    return (size + SceneArena::Alignment - 1) & ~(SceneArena::Alignment - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts the indices of all faces of a mesh
+size_t CountIndices(const aiMesh *mesh) {
+    size_t numIndices = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        numIndices += mesh->mFaces[i].mIndices ? mesh->mFaces[i].mNumIndices : 0;
+    }
+    return numIndices;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Passes every array of the scene which can live in the arena to the visitor
+template <class Visitor>
+void VisitSceneArrays(aiScene *scene, Visitor &visitor) {
+    if (scene->mNumMeshes && scene->mMeshes) {
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            aiMesh *mesh = scene->mMeshes[i];
+            if (nullptr == mesh) {
+                continue;
+            }
+
+            visitor.Visit(mesh->mVertices, mesh->mNumVertices);
+            visitor.Visit(mesh->mNormals, mesh->mNumVertices);
+            visitor.Visit(mesh->mTangents, mesh->mNumVertices);
+            visitor.Visit(mesh->mBitangents, mesh->mNumVertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                visitor.Visit(mesh->mColors[c], mesh->mNumVertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                visitor.Visit(mesh->mTextureCoords[c], mesh->mNumVertices);
+            }
+            if (mesh->mNumBones && mesh->mBones) {
+                for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+                    if (mesh->mBones[b]) {
+                        visitor.Visit(mesh->mBones[b]->mWeights, mesh->mBones[b]->mNumWeights);
+                    }
+                }
+            }
+            visitor.VisitFaces(mesh);
+        }
+    }
+
+    if (scene->mNumAnimations && scene->mAnimations) {
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+            aiAnimation *anim = scene->mAnimations[i];
+            if (nullptr == anim) {
+                continue;
+            }
+
+            if (anim->mNumChannels && anim->mChannels) {
+                for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+                    aiNodeAnim *channel = anim->mChannels[c];
+                    if (channel) {
+                        visitor.Visit(channel->mPositionKeys, channel->mNumPositionKeys);
+                        visitor.Visit(channel->mRotationKeys, channel->mNumRotationKeys);
+                        visitor.Visit(channel->mScalingKeys, channel->mNumScalingKeys);
+                    }
+                }
+            }
+            if (anim->mNumMeshChannels && anim->mMeshChannels) {
+                for (unsigned int c = 0; c < anim->mNumMeshChannels; ++c) {
+                    aiMeshAnim *channel = anim->mMeshChannels[c];
+                    if (channel) {
+                        visitor.Visit(channel->mKeys, channel->mNumKeys);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sums up the arena size needed for a scene
+struct SizeCounter {
+    size_t mSize = 0;
+
+    template <class T>
+    void Visit(T *&array, unsigned int num) {
+        if (array && num) {
+            mSize += AlignUp(sizeof(T) * num);
+        }
+    }
+
+    void VisitFaces(aiMesh *mesh) {
+        if (!mesh->mFaces || !mesh->mNumFaces) {
+            return;
+        }
+        mSize += AlignUp(sizeof(aiFace) * mesh->mNumFaces) + AlignUp(sizeof(unsigned int) * CountIndices(mesh));
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Moves arrays into the arena
+struct Packer {
+    SceneArena &mArena;
+
+    explicit Packer(SceneArena &arena) :
+            mArena(arena) {}
+
+    template <class T>
+    void Visit(T *&array, unsigned int num) {
+        if (!array || !num) {
+            return;
+        }
+        T *dest = mArena.AllocateArray<T>(num);
+        ::memcpy(static_cast<void *>(dest), array, sizeof(T) * num);
+        delete[] array;
+        array = dest;
+    }
+
+    void VisitFaces(aiMesh *mesh) {
+        const unsigned int num = mesh->mNumFaces;
+        aiFace *faces = mesh->mFaces;
+        if (!faces || !num) {
+            return;
+        }
+        const size_t numIndices = CountIndices(mesh);
+
+        // all indices of the mesh are stored back to back
+        aiFace *dest = mArena.AllocateArray<aiFace>(num);
+        unsigned int *indices = numIndices ? mArena.AllocateArray<unsigned int>(numIndices) : nullptr;
+        for (unsigned int i = 0; i < num; ++i) {
+            aiFace *face = new (dest + i) aiFace();
+            face->mNumIndices = faces[i].mNumIndices;
+            if (faces[i].mIndices) {
+                ::memcpy(indices, faces[i].mIndices, sizeof(unsigned int) * face->mNumIndices);
+                face->mIndices = indices;
+                indices += face->mNumIndices;
+            }
+        }
+
+        // also releases the index buffer of meshes with contiguous face indices
+        mesh->DeleteFaces();
+        mesh->mFaces = dest;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Copies arena-owned arrays back into individual allocations
+struct Unpacker {
+    const SceneArena &mArena;
+
+    explicit Unpacker(const SceneArena &arena) :
+            mArena(arena) {}
+
+    template <class T>
+    void Visit(T *&array, unsigned int num) {
+        if (!mArena.Owns(array)) {
+            return;
+        }
+        T *dest = new T[num];
+        ::memcpy(static_cast<void *>(dest), array, sizeof(T) * num);
+        array = dest;
+    }
+
+    void VisitFaces(aiMesh *mesh) {
+        const aiFace *faces = mesh->mFaces;
+        const unsigned int num = mesh->mNumFaces;
+        if (!mArena.Owns(faces)) {
+            return;
+        }
+        aiFace *dest = new aiFace[num];
+        for (unsigned int i = 0; i < num; ++i) {
+            dest[i].mNumIndices = faces[i].mNumIndices;
+            if (faces[i].mIndices) {
+                dest[i].mIndices = new unsigned int[faces[i].mNumIndices];
+                ::memcpy(dest[i].mIndices, faces[i].mIndices, sizeof(unsigned int) * faces[i].mNumIndices);
+            }
+        }
+        mesh->mFaces = dest;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Clears pointers into the arena
+struct Detacher {
+    const SceneArena &mArena;
+
+    explicit Detacher(const SceneArena &arena) :
+            mArena(arena) {}
+
+    template <class T>
+    void Visit(T *&array, unsigned int) {
+        if (mArena.Owns(array)) {
+            array = nullptr;
+        }
+    }
+
+    void VisitFaces(aiMesh *mesh) {
+        if (mArena.Owns(mesh->mFaces)) {
+            mesh->mFaces = nullptr;
+        }
+    }
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::SceneArena() :
+        mBlocks(), mAllocated(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::~SceneArena() {
+    // the blocks are released by their owners
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::AddBlock(size_t size) {
+    Block block;
+    block.mData.reset(new char[size + Alignment]);
+    block.mSize = size + Alignment;
+
+    // operator new[] only guarantees the alignment of the fundamental types
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block.mData.get());
+    block.mUsed = static_cast<size_t>(AlignUp(address) - address);
+    mBlocks.push_back(std::move(block));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::Reserve(size_t size) {
+    size = AlignUp(size);
+    if (!mBlocks.empty() && mBlocks.back().mSize - mBlocks.back().mUsed >= size) {
+        return;
+    }
+    AddBlock(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void *SceneArena::Allocate(size_t size) {
+    size = AlignUp(std::max(size, static_cast<size_t>(1)));
+    if (mBlocks.empty() || mBlocks.back().mSize - mBlocks.back().mUsed < size) {
+        AddBlock(std::max(size, DefaultBlockSize));
+    }
+
+    Block &block = mBlocks.back();
+    void *ptr = block.mData.get() + block.mUsed;
+    block.mUsed += size;
+    mAllocated += size;
+    return ptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneArena::Owns(const void *ptr) const {
+    if (nullptr == ptr) {
+        return false;
+    }
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    for (const Block &block : mBlocks) {
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(block.mData.get());
+        if (address >= begin && address < begin + block.mSize) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t SceneArena::GetAllocatedSize() const {
+    return mAllocated;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t SceneArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (const Block &block : mBlocks) {
+        capacity += block.mSize;
+    }
+    return capacity;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::PackSceneIntoArena(aiScene *scene) {
+    ScenePrivateData *priv = ScenePriv(scene);
+    if (nullptr == priv || priv->mArena) {
+        return;
+    }
+
+    SizeCounter counter;
+    VisitSceneArrays(scene, counter);
+    if (0 == counter.mSize) {
+        return;
+    }
+
+    // a single block, so packing doesn't fail halfway
+    std::unique_ptr<SceneArena> arena(new SceneArena());
+    arena->Reserve(counter.mSize);
+
+    Packer packer(*arena);
+    VisitSceneArrays(scene, packer);
+    priv->mArena = std::move(arena);
+
+    ASSIMP_LOG_DEBUG("Packed ", counter.mSize, " bytes of scene data into the arena");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Assimp::UnpackSceneFromArena(aiScene *scene) {
+    ScenePrivateData *priv = ScenePriv(scene);
+    if (nullptr == priv || !priv->mArena) {
+        return false;
+    }
+
+    Unpacker unpacker(*priv->mArena);
+    VisitSceneArrays(scene, unpacker);
+    priv->mArena.reset();
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::DetachArenaBuffers(aiScene *scene) {
+    ScenePrivateData *priv = ScenePriv(scene);
+    if (nullptr == priv || !priv->mArena) {
+        return;
+    }
+
+    Detacher detacher(*priv->mArena);
+    VisitSceneArrays(scene, detacher);
+}
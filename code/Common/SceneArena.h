@@ -0,0 +1,143 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file SceneArena.h
+ *  @brief Block allocator holding the bulk data of an imported scene.
+ */
+#pragma once
+#ifndef AI_SCENEARENA_H_INC
+#define AI_SCENEARENA_H_INC
+
+#include <assimp/defs.h>
+
+#include <memory>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Bump allocator owned by the private data of a scene.
+ *
+ *  Memory handed out by the arena is never freed individually, all of it is
+ *  released at once when the arena is destroyed. Objects placed into the arena
+ *  don't get their destructors called.
+ */
+class ASSIMP_API SceneArena {
+public:
+    /// Alignment of all allocations.
+    static const size_t Alignment = 16;
+
+    /// Size of the blocks requested from the system unless a larger one is needed.
+    static const size_t DefaultBlockSize = 1024 * 1024;
+
+    SceneArena();
+    ~SceneArena();
+
+    /// @brief  Makes sure the next allocations totaling up to size bytes fit into one block.
+    void Reserve(size_t size);
+
+    /// @brief  Allocates size bytes, aligned to #Alignment.
+    void *Allocate(size_t size);
+
+    /// @brief  Allocates an uninitialized array of num elements of a trivially copyable type.
+    template <class T>
+    T *AllocateArray(size_t num) {
+        return static_cast<T *>(Allocate(sizeof(T) * num));
+    }
+
+    /// @brief  Returns whether the given pointer was allocated from this arena.
+    bool Owns(const void *ptr) const;
+
+    /// @brief  Returns the number of bytes handed out so far.
+    size_t GetAllocatedSize() const;
+
+    /// @brief  Returns the number of bytes requested from the system.
+    size_t GetCapacity() const;
+
+private:
+    SceneArena(const SceneArena &) = delete;
+    SceneArena &operator=(const SceneArena &) = delete;
+
+    struct Block {
+        std::unique_ptr<char[]> mData;
+        size_t mSize;
+        size_t mUsed;
+    };
+
+    void AddBlock(size_t size);
+
+    std::vector<Block> mBlocks;
+    size_t mAllocated;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief  Moves the vertex, face, bone weight and animation key arrays of a
+ *  scene into an arena owned by the private data of the scene.
+ *
+ *  The individually allocated arrays are freed. Afterwards, releasing the scene
+ *  frees all of them at once. Does nothing if the scene was packed already.
+ */
+ASSIMP_API void PackSceneIntoArena(aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** @brief  Moves all arena-owned arrays of a scene back into individually
+ *  allocated arrays and releases the arena.
+ *
+ *  This must be done before code which replaces or frees arrays of the scene
+ *  touches it, i.e. post-processing or merging scenes.
+ *  @return true if the scene was packed.
+ */
+ASSIMP_API bool UnpackSceneFromArena(aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** @brief  Clears all pointers of a scene into its arena, so the destructors
+ *  of its meshes and animations don't free them.
+ *
+ *  Called when a packed scene is destroyed.
+ */
+ASSIMP_API void DetachArenaBuffers(aiScene *scene);
+
+} // namespace Assimp
+
+#endif // AI_SCENEARENA_H_INC
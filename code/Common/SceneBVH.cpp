@@ -0,0 +1,620 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneBVH.cpp
+ *  @brief Implementation of the scene bounding volume hierarchy.
+ *
+ *  The build is a top-down binned SAH build as described by Wald in "On fast Construction of
+ *  SAH-based Bounding Volume Hierarchies". Large ranges near the root are split one after another
+ *  with the binning done in parallel, the subtrees below them are then built in parallel.
+ */
+
+#include <assimp/SceneBVH.h>
+#include <assimp/scene.h>
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+
+using namespace Assimp;
+
+namespace {
+
+// Number of bins per axis
+static const unsigned int NumBins = 16;
+
+// Ranges with more primitives are binned in parallel, smaller ones become subtree jobs
+static const unsigned int ParallelThreshold = 1 << 13;
+
+// Number of primitives handled by one job of the parallel binning
+static const size_t ChunkSize = 1 << 12;
+
+// Leaves are split regardless of the cost if they have more primitives
+static const unsigned int MaxLeafSize = 32;
+
+// ------------------------------------------------------------------------------------------------
+// Runs job(begin, end) over all chunks of [begin,end), in parallel if worth it
+template <class Job>
+void ForEachChunk(ThreadPool *pool, size_t begin, size_t end, const Job &job) {
+    const size_t numChunks = (end - begin + ChunkSize - 1) / ChunkSize;
+    if (nullptr == pool || numChunks < 2) {
+        job(begin, end);
+        return;
+    }
+
+    pool->ParallelFor(numChunks, [&job, begin, end](size_t chunk) {
+        job(begin + chunk * ChunkSize, std::min(end, begin + (chunk + 1) * ChunkSize));
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+inline aiAABB EmptyBox() {
+    const ai_real big = std::numeric_limits<ai_real>::max();
+    return aiAABB(aiVector3D(big, big, big), aiVector3D(-big, -big, -big));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void Grow(aiAABB &box, const aiVector3D &p) {
+    box.mMin.x = std::min(box.mMin.x, p.x);
+    box.mMin.y = std::min(box.mMin.y, p.y);
+    box.mMin.z = std::min(box.mMin.z, p.z);
+    box.mMax.x = std::max(box.mMax.x, p.x);
+    box.mMax.y = std::max(box.mMax.y, p.y);
+    box.mMax.z = std::max(box.mMax.z, p.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void Grow(aiAABB &box, const aiAABB &other) {
+    box.mMin.x = std::min(box.mMin.x, other.mMin.x);
+    box.mMin.y = std::min(box.mMin.y, other.mMin.y);
+    box.mMin.z = std::min(box.mMin.z, other.mMin.z);
+    box.mMax.x = std::max(box.mMax.x, other.mMax.x);
+    box.mMax.y = std::max(box.mMax.y, other.mMax.y);
+    box.mMax.z = std::max(box.mMax.z, other.mMax.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline ai_real HalfArea(const aiAABB &box) {
+    const aiVector3D d = box.mMax - box.mMin;
+    return d.x < 0 ? 0 : d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool Overlaps(const aiAABB &a, const aiAABB &b) {
+    return a.mMin.x <= b.mMax.x && a.mMax.x >= b.mMin.x &&
+           a.mMin.y <= b.mMax.y && a.mMax.y >= b.mMin.y &&
+           a.mMin.z <= b.mMax.z && a.mMax.z >= b.mMin.z;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Intersects a ray with a box, returns the entry distance or a negative value on a miss
+inline ai_real IntersectBox(const aiVector3D &origin, const aiVector3D &invDir, ai_real maxDistance,
+        const aiVector3D &min, const aiVector3D &max) {
+    ai_real tx0 = (min.x - origin.x) * invDir.x, tx1 = (max.x - origin.x) * invDir.x;
+    ai_real ty0 = (min.y - origin.y) * invDir.y, ty1 = (max.y - origin.y) * invDir.y;
+    ai_real tz0 = (min.z - origin.z) * invDir.z, tz1 = (max.z - origin.z) * invDir.z;
+    const ai_real tNear = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), ai_real(0)));
+    const ai_real tFar = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+    return tNear <= tFar ? tNear : ai_real(-1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Intersects a ray with a triangle (Moeller-Trumbore), returns false on a miss
+inline bool IntersectTriangle(const aiVector3D &origin, const aiVector3D &dir, const aiVector3D *v,
+        ai_real &t, ai_real &u, ai_real &w) {
+    const aiVector3D e1 = v[1] - v[0], e2 = v[2] - v[0];
+    const aiVector3D p = dir ^ e2;
+    const ai_real det = e1 * p;
+    if (det == 0) {
+        return false;
+    }
+    const ai_real invDet = 1 / det;
+    const aiVector3D s = origin - v[0];
+    u = (s * p) * invDet;
+    if (u < 0 || u > 1) {
+        return false;
+    }
+    const aiVector3D q = s ^ e1;
+    w = (dir * q) * invDet;
+    if (w < 0 || u + w > 1) {
+        return false;
+    }
+    t = (e2 * q) * invDet;
+    return t >= 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collects all mesh instances of the node graph with their world transformation
+void CollectInstances(const aiNode *node, const aiMatrix4x4 &parent,
+        std::vector<std::pair<const aiNode *, aiMatrix4x4>> &instances) {
+    const aiMatrix4x4 transform = parent * node->mTransformation;
+    if (node->mNumMeshes > 0) {
+        instances.emplace_back(node, transform);
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectInstances(node->mChildren[i], transform, instances);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Splits index ranges with the binned surface area heuristic
+class Builder {
+public:
+    Builder(const std::vector<aiAABB> &bounds, std::vector<unsigned int> &indices, unsigned int maxLeafSize) :
+            mBounds(bounds), mIndices(indices), mMaxLeafSize(maxLeafSize) {
+        // empty
+    }
+
+    // Computes the bounds of a range and decides whether to split it. Returns the
+    // end of the left half, or end if the range becomes a leaf.
+    unsigned int Split(unsigned int begin, unsigned int end, aiAABB &nodeBounds, ThreadPool *pool) const {
+        const unsigned int count = end - begin;
+
+        // bounds of the primitives and of their centroids, per chunk
+        const size_t numChunks = (count + ChunkSize - 1) / ChunkSize;
+        std::vector<aiAABB> chunkBounds(numChunks * 2, EmptyBox());
+        ForEachChunk(pool, begin, end, [&](size_t first, size_t last) {
+            aiAABB *box = &chunkBounds[(first - begin) / ChunkSize * 2];
+            for (size_t i = first; i < last; ++i) {
+                const aiAABB &b = mBounds[mIndices[i]];
+                Grow(box[0], b);
+                Grow(box[1], (b.mMin + b.mMax) * ai_real(0.5));
+            }
+        });
+        aiAABB centroidBounds = EmptyBox();
+        nodeBounds = EmptyBox();
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            Grow(nodeBounds, chunkBounds[chunk * 2]);
+            Grow(centroidBounds, chunkBounds[chunk * 2 + 1]);
+        }
+        if (count <= mMaxLeafSize) {
+            return end;
+        }
+
+        const aiVector3D extent = centroidBounds.mMax - centroidBounds.mMin;
+        if (extent.x <= 0 && extent.y <= 0 && extent.z <= 0) {
+            // all centroids coincide, no split helps but huge leaves are even worse
+            return count <= MaxLeafSize ? end : begin + count / 2;
+        }
+
+        // bin the centroids along all three axes, per chunk
+        std::vector<Bin> chunkBins(numChunks * 3 * NumBins);
+        ForEachChunk(pool, begin, end, [&](size_t first, size_t last) {
+            Bin *local = &chunkBins[(first - begin) / ChunkSize * 3 * NumBins];
+            for (size_t i = first; i < last; ++i) {
+                const aiAABB &b = mBounds[mIndices[i]];
+                const aiVector3D c = (b.mMin + b.mMax) * ai_real(0.5);
+                for (unsigned int axis = 0; axis < 3; ++axis) {
+                    Bin &bin = local[axis * NumBins + BinOf(c[axis], centroidBounds, extent, axis)];
+                    Grow(bin.mBounds, b);
+                    ++bin.mCount;
+                }
+            }
+        });
+        Bin bins[3][NumBins];
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            const Bin *local = &chunkBins[chunk * 3 * NumBins];
+            for (unsigned int axis = 0; axis < 3; ++axis) {
+                for (unsigned int i = 0; i < NumBins; ++i) {
+                    Grow(bins[axis][i].mBounds, local[axis * NumBins + i].mBounds);
+                    bins[axis][i].mCount += local[axis * NumBins + i].mCount;
+                }
+            }
+        }
+
+        // sweep over the planes between the bins to find the cheapest split
+        ai_real bestCost = std::numeric_limits<ai_real>::max();
+        unsigned int bestAxis = 0, bestPlane = 0;
+        for (unsigned int axis = 0; axis < 3; ++axis) {
+            if (extent[axis] <= 0) {
+                continue;
+            }
+            ai_real rightCost[NumBins];
+            aiAABB box = EmptyBox();
+            unsigned int n = 0;
+            for (unsigned int i = NumBins - 1; i > 0; --i) {
+                Grow(box, bins[axis][i].mBounds);
+                n += bins[axis][i].mCount;
+                rightCost[i] = n ? HalfArea(box) * n : 0;
+            }
+            box = EmptyBox();
+            n = 0;
+            for (unsigned int i = 1; i < NumBins; ++i) {
+                Grow(box, bins[axis][i - 1].mBounds);
+                n += bins[axis][i - 1].mCount;
+                const ai_real cost = (n ? HalfArea(box) * n : 0) + rightCost[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestPlane = i;
+                }
+            }
+        }
+
+        // traversal and intersection are assumed to cost the same
+        const ai_real area = HalfArea(nodeBounds);
+        const ai_real splitCost = 1 + (area > 0 ? bestCost / area : count);
+        if (splitCost >= count && count <= MaxLeafSize) {
+            return end;
+        }
+
+        const unsigned int *mid = std::partition(&mIndices[begin], &mIndices[0] + end, [&](unsigned int index) {
+            const aiAABB &b = mBounds[index];
+            return BinOf((b.mMin[bestAxis] + b.mMax[bestAxis]) * ai_real(0.5), centroidBounds, extent, bestAxis) < bestPlane;
+        });
+        const unsigned int split = static_cast<unsigned int>(mid - &mIndices[0]);
+        return split == begin || split == end ? begin + count / 2 : split;
+    }
+
+private:
+    struct Bin {
+        aiAABB mBounds = EmptyBox();
+        unsigned int mCount = 0;
+    };
+
+    static unsigned int BinOf(ai_real c, const aiAABB &centroidBounds, const aiVector3D &extent, unsigned int axis) {
+        const ai_real scale = NumBins * (1 - ai_real(1e-5)) / extent[axis];
+        const int bin = static_cast<int>((c - centroidBounds.mMin[axis]) * scale);
+        return static_cast<unsigned int>(std::min(std::max(bin, 0), static_cast<int>(NumBins) - 1));
+    }
+
+    const std::vector<aiAABB> &mBounds;
+    std::vector<unsigned int> &mIndices;
+    const unsigned int mMaxLeafSize;
+};
+
+// ------------------------------------------------------------------------------------------------
+// A range of primitives to turn into the subtree below a node
+struct Job {
+    unsigned int mNode;
+    unsigned int mBegin, mEnd;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Builds the subtree for a job into nodes, the first entry being the root
+void BuildSubtree(const Builder &builder, const Job &root, std::vector<SceneBVH::Node> &nodes) {
+    std::vector<Job> stack(1, Job{ 0, root.mBegin, root.mEnd });
+    nodes.resize(1);
+    while (!stack.empty()) {
+        const Job job = stack.back();
+        stack.pop_back();
+
+        aiAABB box;
+        const unsigned int mid = builder.Split(job.mBegin, job.mEnd, box, nullptr);
+        SceneBVH::Node &node = nodes[job.mNode];
+        node.mMin = box.mMin;
+        node.mMax = box.mMax;
+        if (mid == job.mEnd) {
+            node.mFirst = job.mBegin;
+            node.mCount = job.mEnd - job.mBegin;
+            continue;
+        }
+        const unsigned int child = static_cast<unsigned int>(nodes.size());
+        node.mFirst = child;
+        node.mCount = 0;
+        nodes.resize(nodes.size() + 2);
+        stack.push_back(Job{ child + 1, mid, job.mEnd });
+        stack.push_back(Job{ child, job.mBegin, mid });
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SceneBVH::SceneBVH() :
+        mGranularity(Triangles),
+        mMaxDepth(0),
+        mNodes(),
+        mPrimitives(),
+        mBounds(),
+        mVertices() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneBVH::~SceneBVH() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneBVH::Build(const aiScene *pScene, Granularity pGranularity, unsigned int pMaxLeafSize, ThreadPool *pThreadPool) {
+    mGranularity = pGranularity;
+    mMaxDepth = 0;
+    mNodes.clear();
+    mPrimitives.clear();
+    mBounds.clear();
+    mVertices.clear();
+    if (nullptr == pScene || nullptr == pScene->mRootNode) {
+        return;
+    }
+    pMaxLeafSize = std::max(pMaxLeafSize, 1u);
+
+    std::vector<std::pair<const aiNode *, aiMatrix4x4>> instances;
+    CollectInstances(pScene->mRootNode, aiMatrix4x4(), instances);
+
+    // assign each mesh instance its range of primitives
+    std::vector<unsigned int> offsets(instances.size() + 1, 0);
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const aiNode *node = instances[i].first;
+        unsigned int count = 0;
+        for (unsigned int m = 0; m < node->mNumMeshes; ++m) {
+            const aiMesh *mesh = pScene->mMeshes[node->mMeshes[m]];
+            if (pGranularity == MeshInstances) {
+                count += mesh->mNumVertices > 0 ? 1 : 0;
+                continue;
+            }
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                count += mesh->mFaces[f].mNumIndices == 3 ? 1 : 0;
+            }
+        }
+        offsets[i + 1] = offsets[i] + count;
+    }
+    const unsigned int numPrimitives = offsets.back();
+    if (0 == numPrimitives) {
+        return;
+    }
+
+    // gather the primitives in world space
+    std::vector<Primitive> primitives(numPrimitives);
+    std::vector<aiAABB> bounds(numPrimitives);
+    std::vector<aiVector3D> vertices(pGranularity == Triangles ? numPrimitives * 3 : 0);
+    auto gather = [&](size_t i) {
+        const aiNode *node = instances[i].first;
+        const aiMatrix4x4 &transform = instances[i].second;
+        unsigned int out = offsets[i];
+        for (unsigned int m = 0; m < node->mNumMeshes; ++m) {
+            const aiMesh *mesh = pScene->mMeshes[node->mMeshes[m]];
+            if (pGranularity == MeshInstances) {
+                if (mesh->mNumVertices == 0) {
+                    continue;
+                }
+                aiAABB local = EmptyBox();
+                for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+                    Grow(local, mesh->mVertices[v]);
+                }
+                aiAABB &box = bounds[out] = EmptyBox();
+                for (unsigned int corner = 0; corner < 8; ++corner) {
+                    Grow(box, transform * aiVector3D(corner & 1 ? local.mMax.x : local.mMin.x,
+                            corner & 2 ? local.mMax.y : local.mMin.y, corner & 4 ? local.mMax.z : local.mMin.z));
+                }
+                primitives[out++] = Primitive{ node, node->mMeshes[m], UINT_MAX };
+                continue;
+            }
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                const aiFace &face = mesh->mFaces[f];
+                if (face.mNumIndices != 3) {
+                    continue;
+                }
+                aiAABB &box = bounds[out] = EmptyBox();
+                for (unsigned int k = 0; k < 3; ++k) {
+                    vertices[out * 3 + k] = transform * mesh->mVertices[face.mIndices[k]];
+                    Grow(box, vertices[out * 3 + k]);
+                }
+                primitives[out++] = Primitive{ node, node->mMeshes[m], f };
+            }
+        }
+    };
+    if (nullptr != pThreadPool) {
+        pThreadPool->ParallelFor(instances.size(), gather);
+    } else {
+        for (size_t i = 0; i < instances.size(); ++i) {
+            gather(i);
+        }
+    }
+
+    // split the large ranges near the root one by one, with parallel binning
+    std::vector<unsigned int> indices(numPrimitives);
+    for (unsigned int i = 0; i < numPrimitives; ++i) {
+        indices[i] = i;
+    }
+    Builder builder(bounds, indices, pMaxLeafSize);
+    std::vector<Job> stack(1, Job{ 0, 0, numPrimitives }), jobs;
+    mNodes.resize(1);
+    while (!stack.empty()) {
+        const Job job = stack.back();
+        stack.pop_back();
+        if (nullptr == pThreadPool || job.mEnd - job.mBegin <= ParallelThreshold) {
+            jobs.push_back(job);
+            continue;
+        }
+
+        aiAABB box;
+        const unsigned int mid = builder.Split(job.mBegin, job.mEnd, box, pThreadPool);
+        Node &node = mNodes[job.mNode];
+        node.mMin = box.mMin;
+        node.mMax = box.mMax;
+        if (mid == job.mEnd) {
+            node.mFirst = job.mBegin;
+            node.mCount = job.mEnd - job.mBegin;
+            continue;
+        }
+        const unsigned int child = static_cast<unsigned int>(mNodes.size());
+        node.mFirst = child;
+        node.mCount = 0;
+        mNodes.resize(mNodes.size() + 2);
+        stack.push_back(Job{ child + 1, mid, job.mEnd });
+        stack.push_back(Job{ child, job.mBegin, mid });
+    }
+
+    // build the remaining subtrees in parallel and append them to the node array
+    std::vector<std::vector<Node>> subtrees(jobs.size());
+    auto buildSubtree = [&](size_t i) {
+        BuildSubtree(builder, jobs[i], subtrees[i]);
+    };
+    if (nullptr != pThreadPool) {
+        pThreadPool->ParallelFor(jobs.size(), buildSubtree);
+    } else {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            buildSubtree(i);
+        }
+    }
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const std::vector<Node> &subtree = subtrees[i];
+        // the root of the subtree replaces the placeholder, the other nodes move by offset
+        const unsigned int offset = static_cast<unsigned int>(mNodes.size()) - 1;
+        for (size_t n = 0; n < subtree.size(); ++n) {
+            Node node = subtree[n];
+            if (!node.IsLeaf()) {
+                node.mFirst += offset;
+            }
+            if (n == 0) {
+                mNodes[jobs[i].mNode] = node;
+            } else {
+                mNodes.push_back(node);
+            }
+        }
+    }
+
+    // children always follow their parent, which gives the depth in a single pass
+    std::vector<unsigned int> depth(mNodes.size(), 0);
+    for (size_t n = 0; n < mNodes.size(); ++n) {
+        if (!mNodes[n].IsLeaf()) {
+            depth[mNodes[n].mFirst] = depth[mNodes[n].mFirst + 1] = depth[n] + 1;
+            mMaxDepth = std::max(mMaxDepth, depth[n] + 1);
+        }
+    }
+
+    // store the primitives in leaf order
+    mPrimitives.resize(numPrimitives);
+    mBounds.resize(numPrimitives);
+    mVertices.resize(vertices.size());
+    for (unsigned int i = 0; i < numPrimitives; ++i) {
+        mPrimitives[i] = primitives[indices[i]];
+        mBounds[i] = bounds[indices[i]];
+        if (pGranularity == Triangles) {
+            std::copy(&vertices[indices[i] * 3], &vertices[indices[i] * 3] + 3, &mVertices[i * 3]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneBVH::Raycast(const aiVector3D &pOrigin, const aiVector3D &pDirection, ai_real pMaxDistance, Hit &poHit) const {
+    if (mNodes.empty()) {
+        return false;
+    }
+
+    // infinities for zero components are intended
+    const aiVector3D invDir(1 / pDirection.x, 1 / pDirection.y, 1 / pDirection.z);
+    ai_real closest = pMaxDistance;
+    bool found = false;
+
+    // the traversal stack never holds more than one entry per level
+    unsigned int fixedStack[64];
+    std::vector<unsigned int> dynamicStack;
+    unsigned int *stack = fixedStack;
+    if (mMaxDepth >= 64) {
+        dynamicStack.resize(mMaxDepth + 1);
+        stack = dynamicStack.data();
+    }
+    unsigned int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = mNodes[stack[--top]];
+        if (IntersectBox(pOrigin, invDir, closest, node.mMin, node.mMax) < 0) {
+            continue;
+        }
+
+        if (node.IsLeaf()) {
+            for (unsigned int i = node.mFirst; i < node.mFirst + node.mCount; ++i) {
+                ai_real t, u = 0, v = 0;
+                if (mGranularity == MeshInstances) {
+                    t = IntersectBox(pOrigin, invDir, closest, mBounds[i].mMin, mBounds[i].mMax);
+                    if (t < 0) {
+                        continue;
+                    }
+                } else if (!IntersectTriangle(pOrigin, pDirection, &mVertices[i * 3], t, u, v) || t > closest) {
+                    continue;
+                }
+                closest = t;
+                poHit.mDistance = t;
+                poHit.mPrimitive = i;
+                poHit.mU = u;
+                poHit.mV = v;
+                found = true;
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        const Node &left = mNodes[node.mFirst], &right = mNodes[node.mFirst + 1];
+        const ai_real tLeft = IntersectBox(pOrigin, invDir, closest, left.mMin, left.mMax);
+        const ai_real tRight = IntersectBox(pOrigin, invDir, closest, right.mMin, right.mMax);
+        if (tLeft >= 0 && tRight >= 0) {
+            stack[top++] = tLeft <= tRight ? node.mFirst + 1 : node.mFirst;
+            stack[top++] = tLeft <= tRight ? node.mFirst : node.mFirst + 1;
+        } else if (tLeft >= 0) {
+            stack[top++] = node.mFirst;
+        } else if (tRight >= 0) {
+            stack[top++] = node.mFirst + 1;
+        }
+    }
+    return found;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneBVH::QueryAABB(const aiAABB &pBox, std::vector<unsigned int> &poResults) const {
+    poResults.clear();
+    if (mNodes.empty()) {
+        return;
+    }
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node &node = mNodes[stack.back()];
+        stack.pop_back();
+        if (!Overlaps(pBox, aiAABB(node.mMin, node.mMax))) {
+            continue;
+        }
+        if (!node.IsLeaf()) {
+            stack.push_back(node.mFirst + 1);
+            stack.push_back(node.mFirst);
+            continue;
+        }
+        for (unsigned int i = node.mFirst; i < node.mFirst + node.mCount; ++i) {
+            if (Overlaps(pBox, mBounds[i])) {
+                poResults.push_back(i);
+            }
+        }
+    }
+    std::sort(poResults.begin(), poResults.end());
+}
@@ -271,6 +271,12 @@ void SceneCombiner::MergeScenes(aiScene **_dest, aiScene *master, std::vector<At
 
     aiScene *dest = *_dest;
 
+    // meshes and animations are moved between the scenes, so none may live in an arena
+    UnpackSceneFromArena(master);
+    for (AttachmentInfo &info : srcList) {
+        UnpackSceneFromArena(info.scene);
+    }
+
     std::vector<SceneHelper> src(srcList.size() + 1);
     src[0].scene = master;
     for (unsigned int i = 0; i < srcList.size(); ++i) {
@@ -866,20 +872,45 @@ void SceneCombiner::MergeMeshes(aiMesh **_out, unsigned int /*flags*/,
         out->mFaces = new aiFace[out->mNumFaces];
         aiFace *pf2 = out->mFaces;
 
+        // merged meshes which all store their indices contiguously keep doing so
+        bool contiguous = true;
+        for (std::vector<aiMesh *>::const_iterator it = begin; it != end; ++it) {
+            if ((*it)->mNumFaces) {
+                contiguous = contiguous && nullptr != (*it)->mIndexBuffer;
+            }
+            for (unsigned int m = 0; m < (*it)->mNumFaces; ++m) {
+                out->mIndexBufferSize += (*it)->mFaces[m].mNumIndices;
+            }
+        }
+        unsigned int *pi = nullptr;
+        if (contiguous) {
+            pi = out->mIndexBuffer = new unsigned int[out->mIndexBufferSize];
+        } else {
+            out->mIndexBufferSize = 0;
+        }
+
         unsigned int ofs = 0;
         for (std::vector<aiMesh *>::const_iterator it = begin; it != end; ++it) {
             for (unsigned int m = 0; m < (*it)->mNumFaces; ++m, ++pf2) {
                 aiFace &face = (*it)->mFaces[m];
                 pf2->mNumIndices = face.mNumIndices;
-                pf2->mIndices = face.mIndices;
+                if (contiguous) {
+                    pf2->mIndices = pi;
+                    pi += face.mNumIndices;
+                    for (unsigned int q = 0; q < face.mNumIndices; ++q) {
+                        pf2->mIndices[q] = face.mIndices[q] + ofs;
+                    }
+                    (*it)->FreeFaceIndices(face);
+                    continue;
+                }
+                pf2->mIndices = (*it)->TakeFaceIndices(face);
 
                 if (ofs) {
                     // add the offset to the vertex
-                    for (unsigned int q = 0; q < face.mNumIndices; ++q) {
-                        face.mIndices[q] += ofs;
+                    for (unsigned int q = 0; q < pf2->mNumIndices; ++q) {
+                        pf2->mIndices[q] += ofs;
                     }
                 }
-                face.mIndices = nullptr;
             }
             ofs += (*it)->mNumVertices;
         }
@@ -1078,15 +1109,42 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     // make a deep copy of all bones
     CopyPtrArray(dest->mBones, dest->mBones, dest->mNumBones);
 
-    // make a deep copy of all faces
+    // make a deep copy of all faces. Index arrays stored in the index buffer
+    // of the source are redirected into the copy of the buffer.
+    GetArrayCopy(dest->mIndexBuffer, dest->mIndexBufferSize);
     GetArrayCopy(dest->mFaces, dest->mNumFaces);
     for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
         aiFace &f = dest->mFaces[i];
-        GetArrayCopy(f.mIndices, f.mNumIndices);
+        if (src->IsInIndexBuffer(f.mIndices)) {
+            f.mIndices = dest->mIndexBuffer + (f.mIndices - src->mIndexBuffer);
+        } else {
+            GetArrayCopy(f.mIndices, f.mNumIndices);
+        }
     }
 
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
+
+    // and of the meshlets
+    dest->mMeshlets = nullptr;
+    Copy(&dest->mMeshlets, src->mMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiMeshlets **_dest, const aiMeshlets *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiMeshlets *dest = *_dest = new aiMeshlets();
+
+    // get a flat copy
+    *dest = *src;
+
+    // and reallocate all arrays
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    GetArrayCopy(dest->mVertices, dest->mNumVertices);
+    GetArrayCopy(dest->mTriangles, dest->mNumTriangles * 3);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -46,9 +46,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_SCENEPRIVATE_H_INCLUDED
 #define AI_SCENEPRIVATE_H_INCLUDED
 
+#include "SceneArena.h"
+
+#include <assimp/SceneBVH.h>
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <memory>
+
 namespace Assimp {
 
 // Forward declarations
@@ -71,13 +76,23 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Arena holding the bulk data of the scene if it was packed
+    // with PackSceneIntoArena(), nullptr otherwise.
+    std::unique_ptr<SceneArena> mArena;
+
+    // Hierarchy over the scene built by aiProcess_GenBoundingBoxes
+    // if AI_CONFIG_PP_GBB_BVH is set, nullptr otherwise.
+    std::unique_ptr<SceneBVH> mBVH;
 };
 
 inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
-, mIsCopy( false ) {
+, mIsCopy( false )
+, mArena()
+, mBVH() {
     // empty
 }
 
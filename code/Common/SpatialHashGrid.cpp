@@ -0,0 +1,348 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the helper class to quickly find vertices close to a given position */
+
+#include "SpatialHashGrid.h"
+#include "ThreadPool.h"
+
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+using namespace Assimp;
+
+namespace {
+
+// Cell coordinates are packed into 21 bits per axis
+static const unsigned int MaxCell = (1u << 21) - 1;
+
+// Number of positions handled by one job of the parallel build
+static const size_t ChunkSize = 1 << 14;
+
+// ------------------------------------------------------------------------------------------------
+inline uint64_t CellKey(unsigned int x, unsigned int y, unsigned int z) {
+    return static_cast<uint64_t>(x) | (static_cast<uint64_t>(y) << 21) | (static_cast<uint64_t>(z) << 42);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline unsigned int BucketOf(uint64_t key, uint64_t mask) {
+    return static_cast<unsigned int>(((key * 0x9E3779B97F4A7C15ull) >> 32) & mask);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Runs job(begin, end) over all chunks of [0,count), in parallel if worth it
+template <class Job>
+void ForEachChunk(ThreadPool *pool, size_t count, const Job &job) {
+    const size_t numChunks = (count + ChunkSize - 1) / ChunkSize;
+    if (nullptr == pool || numChunks < 2) {
+        job(0, count);
+        return;
+    }
+
+    pool->ParallelFor(numChunks, [&job, count](size_t chunk) {
+        job(chunk * ChunkSize, std::min(count, (chunk + 1) * ChunkSize));
+    });
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid() :
+        mPositions(),
+        mEntries(),
+        mBuckets(),
+        mMin(),
+        mMax(),
+        mCellSize(0),
+        mInvCellSize(0),
+        mThreadPool(nullptr),
+        mFinalized(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset, ThreadPool *pThreadPool) :
+        SpatialHashGrid() {
+    mThreadPool = pThreadPool;
+    Fill(pPositions, pNumPositions, pElementOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::~SpatialHashGrid() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::SetThreadPool(ThreadPool *pThreadPool) {
+    mThreadPool = pThreadPool;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize /*= true */) {
+    mPositions.clear();
+    Append(pPositions, pNumPositions, pElementOffset, pFinalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Append(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize /*= true */) {
+    mFinalized = false;
+    mPositions.reserve(mPositions.size() + pNumPositions);
+    const char *data = reinterpret_cast<const char *>(pPositions);
+    for (unsigned int a = 0; a < pNumPositions; ++a) {
+        mPositions.push_back(*reinterpret_cast<const aiVector3D *>(data + a * pElementOffset));
+    }
+
+    if (pFinalize) {
+        Finalize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Finalize() {
+    const size_t count = mPositions.size();
+    mEntries.clear();
+    mFinalized = true;
+
+    // bounding box, chunk by chunk
+    const size_t numChunks = std::max<size_t>(1, (count + ChunkSize - 1) / ChunkSize);
+    const ai_real big = std::numeric_limits<ai_real>::max();
+    std::vector<aiVector3D> chunkMin(numChunks, aiVector3D(big, big, big));
+    std::vector<aiVector3D> chunkMax(numChunks, aiVector3D(-big, -big, -big));
+    ForEachChunk(mThreadPool, count, [this, &chunkMin, &chunkMax](size_t begin, size_t end) {
+        aiVector3D &mn = chunkMin[begin / ChunkSize];
+        aiVector3D &mx = chunkMax[begin / ChunkSize];
+        for (size_t i = begin; i < end; ++i) {
+            const aiVector3D &p = mPositions[i];
+            for (unsigned int a = 0; a < 3; ++a) {
+                mn[a] = std::min(mn[a], p[a]);
+                mx[a] = std::max(mx[a], p[a]);
+            }
+        }
+    });
+    mMin = chunkMin[0];
+    mMax = chunkMax[0];
+    for (size_t c = 1; c < numChunks; ++c) {
+        for (unsigned int a = 0; a < 3; ++a) {
+            mMin[a] = std::min(mMin[a], chunkMin[c][a]);
+            mMax[a] = std::max(mMax[a], chunkMax[c][a]);
+        }
+    }
+
+    // Meshes sample surfaces, so size the cells to hold about one position each if the
+    // positions were spread evenly over the two largest extents of the box.
+    ai_real extents[3] = { mMax.x - mMin.x, mMax.y - mMin.y, mMax.z - mMin.z };
+    std::sort(extents, extents + 3);
+    mCellSize = 1;
+    if (count > 0 && extents[2] > 0 && std::isfinite(extents[2])) {
+        if (extents[1] > extents[2] * ai_real(1e-3)) {
+            mCellSize = std::sqrt(extents[2] * extents[1] / static_cast<ai_real>(count));
+        } else {
+            mCellSize = extents[2] / static_cast<ai_real>(count);
+        }
+        mCellSize = std::max(mCellSize, extents[2] / static_cast<ai_real>(MaxCell - 1));
+    }
+    mInvCellSize = ai_real(1) / mCellSize;
+
+    // hash all positions
+    size_t numBuckets = 1;
+    while (numBuckets < count) {
+        numBuckets <<= 1;
+    }
+    const uint64_t mask = numBuckets - 1;
+
+    std::vector<uint64_t> cells(count);
+    std::vector<unsigned int> buckets(count);
+    ForEachChunk(mThreadPool, count, [this, &cells, &buckets, mask](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const aiVector3D &p = mPositions[i];
+            cells[i] = CellKey(CellCoord(p.x, 0), CellCoord(p.y, 1), CellCoord(p.z, 2));
+            buckets[i] = BucketOf(cells[i], mask);
+        }
+    });
+
+    // counting sort by bucket, which keeps the positions of a bucket in index order
+    mBuckets.assign(numBuckets + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        ++mBuckets[buckets[i] + 1];
+    }
+    for (size_t b = 0; b < numBuckets; ++b) {
+        mBuckets[b + 1] += mBuckets[b];
+    }
+
+    std::vector<unsigned int> cursor(mBuckets.begin(), mBuckets.end() - 1);
+    mEntries.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        Entry &e = mEntries[cursor[buckets[i]]++];
+        e.mPosition = mPositions[i];
+        e.mIndex = static_cast<unsigned int>(i);
+        e.mCell = cells[i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::CellCoord(ai_real value, unsigned int axis) const {
+    const ai_real f = (value - mMin[axis]) * mInvCellSize;
+
+    // also catches NaN
+    if (!(f > 0)) {
+        return 0;
+    }
+    if (f >= static_cast<ai_real>(MaxCell)) {
+        return MaxCell;
+    }
+    return static_cast<unsigned int>(f);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::FindInRange(const aiVector3D &pPosition, ai_real pRange, ai_real pSquaredRadius,
+        bool pInclusive, std::vector<unsigned int> &poResults) const {
+    ai_assert(mFinalized);
+
+    // clear the array in this strange fashion because a simple clear() would also deallocate
+    // the array which we want to avoid
+    poResults.resize(0);
+    if (mEntries.empty()) {
+        return;
+    }
+
+    unsigned int lo[3], hi[3];
+    uint64_t numCells = 1;
+    for (unsigned int a = 0; a < 3; ++a) {
+        if (pPosition[a] + pRange < mMin[a] || pPosition[a] - pRange > mMax[a]) {
+            return;
+        }
+        lo[a] = CellCoord(pPosition[a] - pRange, a);
+        hi[a] = CellCoord(pPosition[a] + pRange, a);
+        numCells *= hi[a] - lo[a] + 1;
+    }
+
+    // a large radius covers more cells than there are positions, just test all of them
+    if (numCells > mEntries.size()) {
+        for (size_t i = 0; i < mPositions.size(); ++i) {
+            const ai_real sq = (mPositions[i] - pPosition).SquareLength();
+            if (pInclusive ? sq <= pSquaredRadius : sq < pSquaredRadius) {
+                poResults.push_back(static_cast<unsigned int>(i));
+            }
+        }
+        return;
+    }
+
+    const uint64_t mask = mBuckets.size() - 2;
+    for (unsigned int z = lo[2]; z <= hi[2]; ++z) {
+        for (unsigned int y = lo[1]; y <= hi[1]; ++y) {
+            for (unsigned int x = lo[0]; x <= hi[0]; ++x) {
+                const uint64_t key = CellKey(x, y, z);
+                const unsigned int bucket = BucketOf(key, mask);
+                for (unsigned int i = mBuckets[bucket]; i < mBuckets[bucket + 1]; ++i) {
+                    const Entry &e = mEntries[i];
+                    if (e.mCell != key) {
+                        continue;
+                    }
+                    const ai_real sq = (e.mPosition - pPosition).SquareLength();
+                    if (pInclusive ? sq <= pSquaredRadius : sq < pSquaredRadius) {
+                        poResults.push_back(e.mIndex);
+                    }
+                }
+            }
+        }
+    }
+
+    if (numCells > 1) {
+        std::sort(poResults.begin(), poResults.end());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::FindPositions(const aiVector3D &pPosition, ai_real pRadius,
+        std::vector<unsigned int> &poResults) const {
+    FindInRange(pPosition, pRadius, pRadius * pRadius, false, poResults);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::FindIdenticalPositions(const aiVector3D &pPosition,
+        std::vector<unsigned int> &poResults) const {
+    // SpatialSort accepts squared distances within six units in the last place of zero,
+    // i.e. six times the smallest denormal. The cells are searched a few units in the
+    // last place of the largest coordinate around the position.
+    static const ai_real squaredTolerance = std::numeric_limits<ai_real>::denorm_min() * 6;
+    const ai_real largest = std::max(std::abs(pPosition.x), std::max(std::abs(pPosition.y), std::abs(pPosition.z)));
+    const ai_real range = largest * std::numeric_limits<ai_real>::epsilon() * 8;
+
+    FindInRange(pPosition, range, squaredTolerance, true, poResults);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
+    ai_assert(mFinalized);
+
+    fill.assign(mPositions.size(), UINT_MAX);
+    std::vector<unsigned int> found;
+    unsigned int t = 0;
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        if (fill[i] != UINT_MAX) {
+            continue;
+        }
+
+        fill[i] = t;
+        FindPositions(mPositions[i], pRadius, found);
+        for (unsigned int index : found) {
+            if (fill[index] == UINT_MAX) {
+                fill[index] = t;
+            }
+        }
+        ++t;
+    }
+    return t;
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_real SpatialHashGrid::GetCellSize() const {
+    return mFinalized ? mCellSize : 0;
+}
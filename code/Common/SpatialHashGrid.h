@@ -0,0 +1,162 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file SpatialHashGrid.h
+ *  @brief Uniform hash grid to find vertices close to a given position.
+ */
+#pragma once
+#ifndef AI_SPATIALHASHGRID_H_INC
+#define AI_SPATIALHASHGRID_H_INC
+
+#include <assimp/types.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Assimp {
+
+class ThreadPool;
+
+// ------------------------------------------------------------------------------------------------
+/** Finds all vertices in the epsilon environment of a position, with the interface of
+ *  #SpatialSort.
+ *
+ *  The positions are bucketed into a uniform grid of cubic cells, which are stored in a hash
+ *  table. The cell size is derived from the bounding box and the number of positions, assuming
+ *  that the positions sample a surface. Queries with a radius up to the cell size visit at most
+ *  eight cells, which makes them O(1) on average regardless of how the mesh is oriented. Flat
+ *  meshes don't degenerate, unlike with the single sorting plane of #SpatialSort.
+ *
+ *  Query results are sorted by ascending index. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SpatialHashGrid {
+public:
+    SpatialHashGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Constructs the grid from the given position array.
+     * @param pPositions Pointer to the first position vector of the array.
+     * @param pNumPositions Number of vectors to expect in that array.
+     * @param pElementOffset Offset in bytes from the beginning of one vector in memory
+     *   to the beginning of the next vector.
+     * @param pThreadPool Optional worker threads to build the grid with. */
+    SpatialHashGrid(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset, ThreadPool *pThreadPool = nullptr);
+
+    ~SpatialHashGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the worker threads used by #Finalize(), nullptr to build serially. */
+    void SetThreadPool(ThreadPool *pThreadPool);
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the input data. This replaces existing data, if any. The new data receives
+     *  new indices in ascending order. See SpatialSort::Fill(). */
+    void Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset,
+            bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #Fill(), except the method appends to existing data. */
+    void Append(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset,
+            bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Builds the grid. Required before the grid can be queried. */
+    void Finalize();
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all positions closer than pRadius to the given
+     *  position. See SpatialSort::FindPositions(). */
+    void FindPositions(const aiVector3D &pPosition, ai_real pRadius,
+            std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all positions identical to the given position,
+     *  using the same tolerance of a few floating-point units as
+     *  SpatialSort::FindIdenticalPositions(). */
+    void FindIdenticalPositions(const aiVector3D &pPosition,
+            std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Computes a table that maps each position to the output ID of the first position
+     *  closer than pRadius to it. Output IDs are assigned in ascending order from 0...n.
+     *  @return Number of unique positions (n). */
+    unsigned int GenerateMappingTable(std::vector<unsigned int> &fill,
+            ai_real pRadius) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Returns the edge length of the grid cells, 0 if the grid isn't finalized. */
+    ai_real GetCellSize() const;
+
+private:
+    /** A position with its index and the key of its cell */
+    struct Entry {
+        aiVector3D mPosition;
+        unsigned int mIndex;
+        uint64_t mCell;
+    };
+
+    unsigned int CellCoord(ai_real value, unsigned int axis) const;
+    void FindInRange(const aiVector3D &pPosition, ai_real pRange, ai_real pSquaredRadius,
+            bool pInclusive, std::vector<unsigned int> &poResults) const;
+
+    /** Positions in the order they were added */
+    std::vector<aiVector3D> mPositions;
+
+    /** Positions grouped by hash bucket, by ascending index within a bucket */
+    std::vector<Entry> mEntries;
+
+    /** Start of each hash bucket in mEntries, one more than the number of buckets */
+    std::vector<unsigned int> mBuckets;
+
+    aiVector3D mMin, mMax;
+    ai_real mCellSize;
+    ai_real mInvCellSize;
+    ThreadPool *mThreadPool;
+    bool mFinalized;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SPATIALHASHGRID_H_INC
@@ -0,0 +1,249 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ThreadPool.cpp
+ *  @brief Implementation of the worker thread pool.
+ */
+
+#include "ThreadPool.h"
+
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// State of one ParallelFor() call. It is shared with the helper tasks, which
+// may start after the call already returned.
+struct ParallelForState {
+    ParallelForState(size_t count, const std::function<void(size_t)> &job) :
+            mCount(count),
+            mJob(job),
+            mNext(0),
+            mDone(0),
+            mFailed(false),
+            mFailedIndex(count),
+            mException() {
+        // empty
+    }
+
+    // Claims and runs indices until none are left. Once a job failed the
+    // remaining indices are only counted.
+    void Run() {
+        size_t completed = 0;
+        for (;;) {
+            const size_t i = mNext.fetch_add(1);
+            if (i >= mCount) {
+                break;
+            }
+            if (!mFailed.load()) {
+                try {
+                    mJob(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (i < mFailedIndex) {
+                        mFailedIndex = i;
+                        mException = std::current_exception();
+                    }
+                    mFailed.store(true);
+                }
+            }
+            ++completed;
+        }
+
+        if (completed) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDone += completed;
+            if (mDone == mCount) {
+                mCondition.notify_all();
+            }
+        }
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mDone == mCount; });
+    }
+
+    const size_t mCount;
+    const std::function<void(size_t)> mJob;
+    std::atomic<size_t> mNext;
+    size_t mDone;
+    std::atomic<bool> mFailed;
+    size_t mFailedIndex;
+    std::exception_ptr mException;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int numThreads) :
+        mWorkers(),
+        mTasks(),
+        mMutex(),
+        mCondition(),
+        mStop(false) {
+    if (0 == numThreads) {
+        numThreads = GetHardwareConcurrency();
+    }
+    mWorkers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+    for (std::thread &worker : mWorkers) {
+        worker.join();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetNumThreads() const {
+    return static_cast<unsigned int>(mWorkers.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::Enqueue(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTasks.push_back(std::move(task));
+    }
+    mCondition.notify_one();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &job) {
+    if (0 == count) {
+        return;
+    }
+
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>(count, job);
+
+    // one index is always left to the calling thread
+    const size_t numHelpers = std::min(count - 1, mWorkers.size());
+    for (size_t i = 0; i < numHelpers; ++i) {
+        Enqueue([state]() { state->Run(); });
+    }
+
+    state->Run();
+    state->Wait();
+
+    if (state->mException) {
+        std::rethrow_exception(state->mException);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || !mTasks.empty(); });
+            if (mTasks.empty()) {
+                return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+        task();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency() {
+    const unsigned int num = std::thread::hardware_concurrency();
+    return num ? num : 1;
+}
+
+#else // ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetNumThreads() const {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::Enqueue(Task task) {
+    task();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &job) {
+    for (size_t i = 0; i < count; ++i) {
+        job(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency() {
+    return 1;
+}
+
+#endif // ASSIMP_BUILD_SINGLETHREADED
@@ -0,0 +1,129 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ThreadPool.h
+ *  @brief A simple pool of worker threads used by the post-processing
+ *  pipeline and the batch loader.
+ */
+#pragma once
+#ifndef AI_THREADPOOL_H_INC
+#define AI_THREADPOOL_H_INC
+
+#include <assimp/defs.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#endif
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief A fixed-size pool of worker threads.
+ *
+ *  Tasks are executed in the order they have been enqueued. If Assimp is
+ *  built with ASSIMP_BUILD_SINGLETHREADED the pool has no workers and all
+ *  work is executed on the calling thread.
+ */
+class ASSIMP_API ThreadPool {
+public:
+    typedef std::function<void()> Task;
+
+    // -------------------------------------------------------------------
+    /** @brief Starts the worker threads.
+     *  @param numThreads Number of workers, 0 selects one worker per
+     *    hardware thread. */
+    explicit ThreadPool(unsigned int numThreads);
+
+    // -------------------------------------------------------------------
+    /** @brief Finishes all pending tasks and joins the workers. */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of worker threads. */
+    unsigned int GetNumThreads() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Queues a task for asynchronous execution.
+     *
+     *  Tasks must not throw. Without worker threads the task is executed
+     *  immediately. */
+    void Enqueue(Task task);
+
+    // -------------------------------------------------------------------
+    /** @brief Calls job(i) for all i in [0,count) and waits for completion.
+     *
+     *  The calling thread takes part in the work, so it is safe to call
+     *  this from within a task. Jobs must only touch data owned by their
+     *  index. If jobs throw, the exception of the lowest failing index is
+     *  rethrown once all running jobs have finished, no new jobs are
+     *  started after the first failure. */
+    void ParallelFor(size_t count, const std::function<void(size_t)> &job);
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of hardware threads, at least 1. */
+    static unsigned int GetHardwareConcurrency();
+
+private:
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    void WorkerLoop();
+
+    std::vector<std::thread> mWorkers;
+    std::deque<Task> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStop;
+#endif
+};
+
+} // namespace Assimp
+
+#endif // AI_THREADPOOL_H_INC
@@ -142,6 +142,12 @@ ASSIMP_API aiScene::aiScene() :
 
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiScene::~aiScene() {
+    // the arrays in the arena are released with the private data
+    Assimp::ScenePrivateData *priv = static_cast<Assimp::ScenePrivateData *>(mPrivate);
+    if (priv && priv->mArena) {
+        Assimp::DetachArenaBuffers(this);
+    }
+
     // delete all sub-objects recursively
     delete mRootNode;
 
@@ -183,5 +189,5 @@ ASSIMP_API aiScene::~aiScene() {
     aiMetadata::Dealloc(mMetaData);
     mMetaData = nullptr;
 
-    delete static_cast<Assimp::ScenePrivateData *>(mPrivate);
+    delete priv;
 }
@@ -62,6 +62,10 @@ bool ArmaturePopulate::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_PopulateArmatureData) != 0;
 }
 
+unsigned int ArmaturePopulate::GetMutatedMeshAttributes() const {
+    return MeshAttr_Bones;
+}
+
 void ArmaturePopulate::SetupProperties(const Importer *) {
     // do nothing
 }
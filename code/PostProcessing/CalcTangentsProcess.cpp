@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/TinyFormatter.h>
 #include <assimp/qnan.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -72,6 +74,11 @@ bool CalcTangentsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_CalcTangentSpace) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int CalcTangentsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_TangentsAndBitangents;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void CalcTangentsProcess::SetupProperties(const Importer *pImp) {
@@ -92,10 +99,11 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 
     ASSIMP_LOG_DEBUG("CalcTangentsProcess begin");
 
-    bool bHas = false;
-    for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        if (ProcessMesh(pScene->mMeshes[a], a)) bHas = true;
-    }
+    std::vector<char> results(pScene->mNumMeshes, 0);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        results[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+    const bool bHas = std::find(results.begin(), results.end(), 1) != results.end();
 
     if (bHas) {
         ASSIMP_LOG_INFO("CalcTangentsProcess finished. Tangents have been calculated");
@@ -106,7 +114,7 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 
 // ------------------------------------------------------------------------------------------------
 // Calculates tangents and bi-tangents for the given mesh
-bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
+bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int /*meshIndex*/) {
     // we assume that the mesh is still in the verbose vertex format where each face has its own set
     // of vertices and no vertices are shared between faces. Sadly I don't know any quick test to
     // assert() it here.
@@ -224,26 +232,12 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
         }
     }
 
-    // create a helper to quickly find locally close vertices among the vertex array
-    // FIX: check whether we can reuse the SpatialSort of a previous step
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-    float posEpsilon = 10e-6f;
-    if (shared) {
-        std::vector<std::pair<SpatialSort, float>> *avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT, avf);
-        if (avf) {
-            std::pair<SpatialSort, float> &blubb = avf->operator[](meshIndex);
-            vertexFinder = &blubb.first;
-            posEpsilon = blubb.second;
-            ;
-        }
-    }
-    if (!vertexFinder) {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
-        vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
-    }
+    // create a helper to quickly find locally close vertices among the vertex array,
+    // check whether we can reuse the spatial index of a previous step.
+    SharedSpatialIndex _vertexFinder;
+    const SharedSpatialIndex &spatialIndex = GetSpatialIndex(shared, pMesh, threadPool, _vertexFinder);
+    const SpatialHashGrid *vertexFinder = &spatialIndex.first;
+    const ai_real posEpsilon = spatialIndex.second;
     std::vector<unsigned int> verticesFound;
 
     const float fLimit = std::cos(configMaxAngle);
@@ -83,6 +83,10 @@ public:
     */
     void SetupProperties(const Importer* pImp);
 
+    // -------------------------------------------------------------------
+    /** Returns the mesh attributes modified by the step, the tangents and bitangents. */
+    unsigned int GetMutatedMeshAttributes() const;
+
 
     // setter for configMaxAngle
     inline void SetMaxSmoothAngle(float f)
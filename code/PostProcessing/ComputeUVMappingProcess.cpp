@@ -78,6 +78,12 @@ bool ComputeUVMappingProcess::IsActive( unsigned int pFlags) const
     return  (pFlags & aiProcess_GenUVCoords) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int ComputeUVMappingProcess::GetMutatedMeshAttributes() const
+{
+    return MeshAttr_TexCoords;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Check whether a ray intersects a plane and find the intersection point
 inline bool PlaneIntersect(const aiRay& ray, const aiVector3D& planePos,
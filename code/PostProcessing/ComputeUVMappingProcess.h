@@ -75,6 +75,10 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the mesh attributes modified by the step, the texture coordinates. */
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
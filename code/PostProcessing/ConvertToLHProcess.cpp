@@ -98,6 +98,11 @@ bool MakeLeftHandedProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_MakeLeftHanded);
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int MakeLeftHandedProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Positions | MeshAttr_Normals | MeshAttr_TangentsAndBitangents | MeshAttr_Bones;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void MakeLeftHandedProcess::Execute(aiScene *pScene) {
@@ -262,6 +267,11 @@ bool FlipUVsProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FlipUVs);
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int FlipUVsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_TexCoords;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FlipUVsProcess::Execute(aiScene *pScene) {
@@ -324,6 +334,11 @@ bool FlipWindingOrderProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FlipWindingOrder);
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int FlipWindingOrderProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Faces;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FlipWindingOrderProcess::Execute(aiScene *pScene) {
@@ -83,6 +83,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -134,6 +137,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -159,6 +165,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -74,6 +74,11 @@ bool DropFaceNormalsProcess::IsActive( unsigned int pFlags) const {
     return  (pFlags & aiProcess_DropNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int DropFaceNormalsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Normals;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void DropFaceNormalsProcess::Execute( aiScene* pScene) {
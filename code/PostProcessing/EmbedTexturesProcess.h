@@ -68,6 +68,9 @@ public:
     /// Overwritten, @see BaseProcess
     virtual bool IsActive(unsigned int pFlags) const;
 
+    /// Overwritten, @see BaseProcess
+    virtual unsigned int GetMutatedMeshAttributes() const;
+
     /// Overwritten, @see BaseProcess
     virtual void SetupProperties(const Importer* pImp);
 
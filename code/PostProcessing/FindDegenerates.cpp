@@ -94,11 +94,18 @@ void FindDegeneratesProcess::Execute( aiScene* pScene) {
     std::unordered_map<unsigned int, unsigned int> meshMap;
     meshMap.reserve(pScene->mNumMeshes);
 
+    // Do not process point cloud, ExecuteOnMesh works only with faces data
+    std::vector<char> removeMesh(pScene->mNumMeshes, 0);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int i) {
+        if (pScene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType::aiPrimitiveType_POINT) {
+            removeMesh[i] = ExecuteOnMesh(pScene->mMeshes[i]);
+        }
+    });
+
     const unsigned int originalNumMeshes = pScene->mNumMeshes;
     unsigned int targetIndex = 0;
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-        // Do not process point cloud, ExecuteOnMesh works only with faces data
-        if ((pScene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType::aiPrimitiveType_POINT) && ExecuteOnMesh(pScene->mMeshes[i])) {
+        if (removeMesh[i]) {
             delete pScene->mMeshes[i];
             // Not strictly required, but clean:
             pScene->mMeshes[i] = nullptr;
@@ -275,9 +282,7 @@ evil_jump_outside:
             }
             else {
                 // Otherwise delete it if we don't need this face
-                delete[] face_src.mIndices;
-                face_src.mIndices = nullptr;
-                face_src.mNumIndices = 0;
+                mesh->FreeFaceIndices(face_src);
             }
         }
         // Just leave the rest of the array unreferenced, we don't care for now
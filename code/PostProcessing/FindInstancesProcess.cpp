@@ -47,8 +47,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "FindInstancesProcess.h"
+
+#include <assimp/StringUtils.h>
+
+#include <cfloat>
+#include <cmath>
 #include <memory>
 #include <stdio.h>
+#include <unordered_map>
 
 using namespace Assimp;
 
@@ -56,6 +62,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 FindInstancesProcess::FindInstancesProcess()
 :   configSpeedFlag (false)
+,   configRigidTransforms (false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -78,6 +85,9 @@ void FindInstancesProcess::SetupProperties(const Importer* pImp)
 {
     // AI_CONFIG_FAVOUR_SPEED
     configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED,0));
+
+    // AI_CONFIG_PP_FI_RIGID_TRANSFORMS
+    configRigidTransforms = pImp->GetPropertyBool(AI_CONFIG_PP_FI_RIGID_TRANSFORMS,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -96,7 +106,7 @@ bool CompareBones(const aiMesh* orig, const aiMesh* inst)
         // compare weight per weight ---
         for (unsigned int n = 0; n < aha->mNumWeights;++n) {
             if  (aha->mWeights[n].mVertexId != oha->mWeights[n].mVertexId ||
-                (aha->mWeights[n].mWeight - oha->mWeights[n].mWeight) < 10e-3f) {
+                std::fabs(aha->mWeights[n].mWeight - oha->mWeights[n].mWeight) > 10e-3f) {
                 return false;
             }
         }
@@ -104,15 +114,200 @@ bool CompareBones(const aiMesh* orig, const aiMesh* inst)
     return true;
 }
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Picks three vertices which span a frame: the first vertex, the one farthest from it and the
+// one farthest from the line through both. Returns false if the mesh is too flat for that.
+bool FindFrameVertices(const aiMesh* mesh, float epsilon, unsigned int* anchors)
+{
+    const aiVector3D* v = mesh->mVertices;
+    anchors[0] = anchors[1] = anchors[2] = 0;
+    ai_real best = 0;
+    for (unsigned int i = 1; i < mesh->mNumVertices; ++i) {
+        const ai_real d = (v[i] - v[0]).SquareLength();
+        if (d > best) {
+            best = d;
+            anchors[1] = i;
+        }
+    }
+    if (best <= epsilon) {
+        return false;
+    }
+
+    const aiVector3D axis = (v[anchors[1]] - v[0]).Normalize();
+    best = 0;
+    for (unsigned int i = 1; i < mesh->mNumVertices; ++i) {
+        const ai_real d = ((v[i] - v[0]) ^ axis).SquareLength();
+        if (d > best) {
+            best = d;
+            anchors[2] = i;
+        }
+    }
+    return best > epsilon;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the orthonormal frame spanned by three vertices
+aiMatrix4x4 GetFrame(const aiVector3D* v, const unsigned int* anchors)
+{
+    const aiVector3D &a = v[anchors[0]];
+    const aiVector3D x = (v[anchors[1]] - a).Normalize();
+    const aiVector3D z = (x ^ (v[anchors[2]] - a)).Normalize();
+    const aiVector3D y = z ^ x;
+    return aiMatrix4x4(
+        x.x, y.x, z.x, a.x,
+        x.y, y.y, z.y, a.y,
+        x.z, y.z, z.z, a.z,
+        0, 0, 0, 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compares the vertex data of two meshes, positions and directions are transformed into the
+// space of inst first if a transformation is given
+bool CompareVertexData(const aiMesh* orig, const aiMesh* inst, float epsilon, const aiMatrix4x4* transform)
+{
+    // compare positions, normals, tangents and bitangents using this epsilon
+    if (nullptr == transform) {
+        if (orig->HasPositions() && !CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon)) {
+            return false;
+        }
+        if (orig->HasNormals() && !CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon)) {
+            return false;
+        }
+        if (orig->HasTangentsAndBitangents()) {
+            if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+                !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon)) {
+                return false;
+            }
+        }
+    } else {
+        const aiMatrix3x3 rotation(*transform);
+        const float directionEpsilon = 10e-4f;
+        for (unsigned int i = 0; i < orig->mNumVertices; ++i) {
+            if ((*transform * orig->mVertices[i] - inst->mVertices[i]).SquareLength() >= epsilon) {
+                return false;
+            }
+            if (orig->HasNormals() && (rotation * orig->mNormals[i] - inst->mNormals[i]).SquareLength() >= directionEpsilon) {
+                return false;
+            }
+            if (orig->HasTangentsAndBitangents() &&
+                    ((rotation * orig->mTangents[i] - inst->mTangents[i]).SquareLength() >= directionEpsilon ||
+                    (rotation * orig->mBitangents[i] - inst->mBitangents[i]).SquareLength() >= directionEpsilon)) {
+                return false;
+            }
+        }
+    }
+
+    // use a constant epsilon for colors and UV coordinates
+    static const float uvEpsilon = 10e-4f;
+    for (unsigned int j = 0, end = orig->GetNumUVChannels(); j < end; ++j) {
+        if (orig->mTextureCoords[j] && !CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+    for (unsigned int j = 0, end = orig->GetNumColorChannels(); j < end; ++j) {
+        if (orig->mColors[j] && !CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
-// Update mesh indices in the node graph
-void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
+// Update mesh indices in the node graph. Meshes found to be transformed instances are moved
+// to a new child node which carries the transformation.
+void UpdateMeshIndices(aiNode* node, const unsigned int* lookup, const std::vector<aiMatrix4x4>& transforms,
+        const std::vector<bool>& hasTransform)
 {
-    for (unsigned int n = 0; n < node->mNumMeshes;++n)
-        node->mMeshes[n] = lookup[node->mMeshes[n]];
+    std::vector<aiNode*> instances;
+    unsigned int numMeshes = 0;
+    for (unsigned int n = 0; n < node->mNumMeshes;++n) {
+        const unsigned int mesh = node->mMeshes[n];
+        if (!hasTransform[mesh]) {
+            node->mMeshes[numMeshes++] = lookup[mesh];
+            continue;
+        }
+
+        aiNode* child = new aiNode();
+        child->mName.length = static_cast<ai_uint32>(ai_snprintf(child->mName.data, MAXLEN, "%s_instance%u",
+                node->mName.C_Str(), static_cast<unsigned int>(instances.size())));
+        child->mTransformation = transforms[mesh];
+        child->mNumMeshes = 1;
+        child->mMeshes = new unsigned int[1];
+        child->mMeshes[0] = lookup[mesh];
+        instances.push_back(child);
+    }
 
     for (unsigned int n = 0; n < node->mNumChildren;++n)
-        UpdateMeshIndices(node->mChildren[n],lookup);
+        UpdateMeshIndices(node->mChildren[n],lookup,transforms,hasTransform);
+
+    if (!instances.empty()) {
+        node->mNumMeshes = numMeshes;
+        if (0 == numMeshes) {
+            delete[] node->mMeshes;
+            node->mMeshes = nullptr;
+        }
+        node->addChildren(static_cast<unsigned int>(instances.size()), &instances[0]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether inst is an instance of orig, possibly under a rigid transformation
+bool FindInstancesProcess::IsInstance(const aiMesh* orig, const aiMesh* inst, const MeshInfo& origInfo,
+        const MeshInfo& instInfo, aiMatrix4x4& transform, bool& transformed) const
+{
+    // check for hash collision .. we needn't check
+    // the vertex format, it *must* match due to the
+    // (brilliant) construction of the hash
+    if (orig->mNumBones       != inst->mNumBones      ||
+        orig->mNumFaces       != inst->mNumFaces      ||
+        orig->mNumVertices    != inst->mNumVertices   ||
+        orig->mMaterialIndex  != inst->mMaterialIndex ||
+        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+        return false;
+
+    // up to now the meshes are equal. Now compare the vertex data, first in place and
+    // then under the transformation which maps the frame of orig onto the one of inst
+    transformed = false;
+    if (!CompareVertexData(orig,inst,instInfo.epsilon,nullptr)) {
+        if (!origInfo.rigid || !instInfo.rigid) {
+            return false;
+        }
+        // the vertices of instances correspond by index, so the same vertices span the frame
+        transform = GetFrame(inst->mVertices, origInfo.anchors) * aiMatrix4x4(origInfo.frame).Inverse();
+        if (!CompareVertexData(orig,inst,instInfo.epsilon,&transform)) {
+            return false;
+        }
+        transformed = true;
+    }
+
+    // These two checks are actually quite expensive and almost *never* required.
+    // Almost. That's why they're still here. But there's no reason to do them
+    // in speed-targeted imports.
+    if (!configSpeedFlag) {
+
+        // It seems to be strange, but we really need to check whether the
+        // bones are identical too. Although it's extremely unprobable
+        // that they're not if control reaches here, we need to deal
+        // with unprobable cases, too. It could still be that there are
+        // equal shapes which are deformed differently.
+        if (!CompareBones(orig,inst))
+            return false;
+
+        // For completeness ... compare even the index buffers for equality,
+        // their hashes might collide.
+        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+            const aiFace& f = orig->mFaces[tt];
+            const aiFace& f2 = inst->mFaces[tt];
+            if (f.mNumIndices != f2.mNumIndices ||
+                0 != ::memcmp(f.mIndices,f2.mIndices,f.mNumIndices*sizeof(unsigned int)))
+                return false;
+        }
+    }
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -127,131 +322,88 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         // in the pipeline, so we could, depending on the file format,
         // have several thousand small meshes. That's too much for a brute
         // everyone-against-everyone check involving up to 10 comparisons
-        // each.
-        std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
-        std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
+        // each. The hash doesn't depend on the placement of the mesh, so
+        // rigidly transformed copies end up in the same bucket.
+        std::vector<MeshInfo> infos(pScene->mNumMeshes);
+        ParallelFor(pScene->mNumMeshes, [&](unsigned int i) {
+            const aiMesh* mesh = pScene->mMeshes[i];
+            MeshInfo& info = infos[i];
+            info.hash = GetMeshHash(const_cast<aiMesh*>(mesh)) ^ (GetFaceHash(shared, mesh) * 0x9E3779B97F4A7C15ull);
+
+            // Find an appropriate epsilon to compare position differences against
+            info.epsilon = ComputePositionEpsilon(mesh);
+            info.epsilon *= info.epsilon;
+
+            // rigid instances of skinned or morphed meshes would need their bones and
+            // anim meshes changed too, so these are only matched in place
+            info.rigid = false;
+            if (configRigidTransforms && mesh->HasPositions() && !mesh->HasBones() && 0 == mesh->mNumAnimMeshes) {
+                // account for the rounding errors of transforming vertices far from the origin
+                aiVector3D minVec, maxVec;
+                ArrayBounds(mesh->mVertices, mesh->mNumVertices, minVec, maxVec);
+                const float magnitude = std::max(std::max(std::fabs(minVec.x), std::fabs(maxVec.x)),
+                        std::max(std::max(std::fabs(minVec.y), std::fabs(maxVec.y)), std::max(std::fabs(minVec.z), std::fabs(maxVec.z))));
+                const float rounding = 16 * FLT_EPSILON * magnitude;
+                info.epsilon = std::max(info.epsilon, rounding * rounding);
+
+                info.rigid = FindFrameVertices(mesh, info.epsilon, info.anchors);
+                if (info.rigid) {
+                    info.frame = GetFrame(mesh->mVertices, info.anchors);
+                }
+            }
+        });
 
-        unsigned int numMeshesOut = 0;
+        // group the meshes by their hash, in order of their index
+        std::unordered_map<uint64_t, unsigned int> bucketIndex;
+        std::vector<std::vector<unsigned int>> buckets;
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            auto it = bucketIndex.insert(std::make_pair(infos[i].hash, static_cast<unsigned int>(buckets.size())));
+            if (it.second) {
+                buckets.emplace_back();
+            }
+            buckets[it.first->second].push_back(i);
+        }
 
-            aiMesh* inst = pScene->mMeshes[i];
-            hashes[i] = GetMeshHash(inst);
-
-            // Find an appropriate epsilon 
-            // to compare position differences against
-            float epsilon = ComputePositionEpsilon(inst);
-            epsilon *= epsilon;
-
-            for (int a = i-1; a >= 0; --a) {
-                if (hashes[i] == hashes[a])
-                {
-                    aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
-                        continue;
-
-                    // check for hash collision .. we needn't check
-                    // the vertex format, it *must* match due to the
-                    // (brilliant) construction of the hash
-                    if (orig->mNumBones       != inst->mNumBones      ||
-                        orig->mNumFaces       != inst->mNumFaces      ||
-                        orig->mNumVertices    != inst->mNumVertices   ||
-                        orig->mMaterialIndex  != inst->mMaterialIndex ||
-                        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
-                        continue;
-
-                    // up to now the meshes are equal. Now compare vertex positions, normals,
-                    // tangents and bitangents using this epsilon.
-                    if (orig->HasPositions()) {
-                        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasNormals()) {
-                        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasTangentsAndBitangents()) {
-                        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-                            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-
-                    // use a constant epsilon for colors and UV coordinates
-                    static const float uvEpsilon = 10e-4f;
-                    {
-                        unsigned int j, end = orig->GetNumUVChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mTextureCoords[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
-                        }
-                    }
-                    {
-                        unsigned int j, end = orig->GetNumColorChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mColors[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
-                        }
-                    }
-
-                    // These two checks are actually quite expensive and almost *never* required.
-                    // Almost. That's why they're still here. But there's no reason to do them
-                    // in speed-targeted imports.
-                    if (!configSpeedFlag) {
-
-                        // It seems to be strange, but we really need to check whether the
-                        // bones are identical too. Although it's extremely unprobable
-                        // that they're not if control reaches here, we need to deal
-                        // with unprobable cases, too. It could still be that there are
-                        // equal shapes which are deformed differently.
-                        if (!CompareBones(orig,inst))
-                            continue;
-
-                        // For completeness ... compare even the index buffers for equality
-                        // face order & winding order doesn't care. Input data is in verbose format.
-                        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
-                        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
-
-                        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-                            aiFace& f = orig->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-                                ftbl_orig[f.mIndices[nn]] = tt;
-
-                            aiFace& f2 = inst->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-                                ftbl_inst[f2.mIndices[nn]] = tt;
-                        }
-                        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-                            continue;
+        // compare each mesh with the meshes kept so far in its bucket. Buckets are
+        // independent, so they are processed in parallel.
+        std::vector<unsigned int> original(pScene->mNumMeshes);
+        std::vector<aiMatrix4x4> transforms(pScene->mNumMeshes);
+        std::vector<bool> hasTransform(pScene->mNumMeshes, false);
+        std::vector<char> transformed(pScene->mNumMeshes, 0);
+        ParallelFor(static_cast<unsigned int>(buckets.size()), [&](unsigned int b) {
+            std::vector<unsigned int> kept;
+            for (unsigned int i : buckets[b]) {
+                original[i] = i;
+                for (unsigned int a : kept) {
+                    bool isTransformed = false;
+                    if (IsInstance(pScene->mMeshes[a],pScene->mMeshes[i],infos[a],infos[i],transforms[i],isTransformed)) {
+                        original[i] = a;
+                        transformed[i] = isTransformed ? 1 : 0;
+                        break;
                     }
-
-                    // We're still here. Or in other words: 'inst' is an instance of 'orig'.
-                    // Place a marker in our list that we can easily update mesh indices.
-                    remapping[i] = remapping[a];
-
-                    // Delete the instanced mesh, we don't need it anymore
-                    delete inst;
-                    pScene->mMeshes[i] = nullptr;
-                    break;
+                }
+                if (original[i] == i) {
+                    kept.push_back(i);
                 }
             }
+        });
 
-            // If we didn't find a match for the current mesh: keep it
-            if (pScene->mMeshes[i]) {
+        // We're still here. Or in other words: the meshes marked are instances of others.
+        // Delete them and build a lookup table to update the mesh indices.
+        std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
+        unsigned int numMeshesOut = 0, numTransformed = 0;
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            if (original[i] == i) {
                 remapping[i] = numMeshesOut++;
+                continue;
             }
+            remapping[i] = remapping[original[i]];
+            hasTransform[i] = 0 != transformed[i];
+            numTransformed += transformed[i];
+
+            // Delete the instanced mesh, we don't need it anymore
+            delete pScene->mMeshes[i];
+            pScene->mMeshes[i] = nullptr;
         }
         ai_assert(0 != numMeshesOut);
         if (numMeshesOut != pScene->mNumMeshes) {
@@ -263,11 +415,12 @@ void FindInstancesProcess::Execute( aiScene* pScene)
             }
 
             // And update the node graph with our nice lookup table
-            UpdateMeshIndices(pScene->mRootNode,remapping.get());
+            UpdateMeshIndices(pScene->mRootNode,remapping.get(),transforms,hasTransform);
 
             // write to log
             if (!DefaultLogger::isNullLogger()) {
-                ASSIMP_LOG_INFO( "FindInstancesProcess finished. Found ", (pScene->mNumMeshes - numMeshesOut), " instances" );
+                ASSIMP_LOG_INFO( "FindInstancesProcess finished. Found ", (pScene->mNumMeshes - numMeshesOut), " instances, ",
+                        numTransformed, " of them transformed" );
             }
             pScene->mNumMeshes = numMeshesOut;
         } else {
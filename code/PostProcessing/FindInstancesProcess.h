@@ -106,8 +106,13 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
+ *
+ *  Meshes are bucketed by a hash of their format and index buffer and only
+ *  compared within their bucket. With #AI_CONFIG_PP_FI_RIGID_TRANSFORMS
+ *  meshes which are rigidly transformed copies of others are found too,
+ *  they are replaced by a child node which carries the transformation.
 */
-class FindInstancesProcess : public BaseProcess
+class ASSIMP_API FindInstancesProcess : public BaseProcess
 {
 public:
 
@@ -129,7 +134,27 @@ public:
 
 private:
 
+    // Data computed up front for each mesh
+    struct MeshInfo {
+        // Bucket of the mesh
+        uint64_t hash;
+        // Squared epsilon for position comparisons
+        float epsilon;
+        // Whether the mesh may be matched under a rigid transformation
+        bool rigid;
+        // Indices of the vertices spanning the frame of the mesh, and the frame
+        unsigned int anchors[3];
+        aiMatrix4x4 frame;
+    };
+
+    // -------------------------------------------------------------------
+    // Check whether inst is an instance of orig. transform receives the
+    // transformation from orig to inst if one is needed.
+    bool IsInstance(const aiMesh* orig, const aiMesh* inst, const MeshInfo& origInfo,
+            const MeshInfo& instInfo, aiMatrix4x4& transform, bool& transformed) const;
+
     bool configSpeedFlag;
+    bool configRigidTransforms;
 
 }; // ! end class FindInstancesProcess
 }  // ! end namespace Assimp
@@ -78,6 +78,11 @@ bool FixInfacingNormalsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_FixInfacingNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int FixInfacingNormalsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Normals | MeshAttr_Faces;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FixInfacingNormalsProcess::Execute( aiScene* pScene)
@@ -70,6 +70,10 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the mesh attributes modified by the step, the normals and the winding order of the faces. */
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -42,14 +42,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS
 
 #include "PostProcessing/GenBoundingBoxesProcess.h"
+#include "Common/ScenePrivate.h"
 
+#include <assimp/SceneBVH.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
 
 namespace Assimp {
 
 GenBoundingBoxesProcess::GenBoundingBoxesProcess()
-: BaseProcess() {
+: BaseProcess()
+, mBVH(0)
+, mBVHMaxLeafSize(4) {
 
 }
 
@@ -61,6 +68,16 @@ bool GenBoundingBoxesProcess::IsActive(unsigned int pFlags) const {
     return 0 != ( pFlags & aiProcess_GenBoundingBoxes );
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int GenBoundingBoxesProcess::GetMutatedMeshAttributes() const {
+    return 0;
+}
+
+void GenBoundingBoxesProcess::SetupProperties(const Importer *pImp) {
+    mBVH = pImp->GetPropertyInteger(AI_CONFIG_PP_GBB_BVH, 0);
+    mBVHMaxLeafSize = static_cast<unsigned int>(std::max(1, pImp->GetPropertyInteger(AI_CONFIG_PP_GBB_BVH_MAX_LEAF_SIZE, 4)));
+}
+
 void checkMesh(aiMesh* mesh, aiVector3D& min, aiVector3D& max) {
     ai_assert(nullptr != mesh);
 
@@ -108,6 +125,20 @@ void GenBoundingBoxesProcess::Execute(aiScene* pScene) {
         mesh->mAABB.mMin = min;
         mesh->mAABB.mMax = max;
     }
+
+    ScenePrivateData *priv = ScenePriv(pScene);
+    if (nullptr == priv) {
+        return;
+    }
+    priv->mBVH.reset();
+    if (mBVH != 1 && mBVH != 2) {
+        return;
+    }
+
+    priv->mBVH.reset(new SceneBVH());
+    priv->mBVH->Build(pScene, mBVH == 1 ? SceneBVH::Triangles : SceneBVH::MeshInstances, mBVHMaxLeafSize, threadPool);
+    ASSIMP_LOG_DEBUG("GenBoundingBoxesProcess: built a BVH with ", priv->mBVH->GetNodes().size(),
+            " nodes over ", priv->mBVH->GetPrimitives().size(), " primitives");
 }
 
 } // Namespace Assimp
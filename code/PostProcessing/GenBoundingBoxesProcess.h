@@ -55,7 +55,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp {
 
 /** Post-processing process to find axis-aligned bounding volumes for amm meshes
- *  used in a scene
+ *  used in a scene. On request, see #AI_CONFIG_PP_GBB_BVH, it also builds a
+ *  bounding volume hierarchy over the whole scene.
  */
 class ASSIMP_API GenBoundingBoxesProcess : public BaseProcess {
 public:
@@ -65,8 +66,16 @@ public:
     ~GenBoundingBoxesProcess();
     /// Will return true, if aiProcess_GenBoundingBoxes is defined.
     bool IsActive(unsigned int pFlags) const override;
+    /// Reads the BVH settings from the importer configuration.
+    void SetupProperties(const Importer *pImp) override;
+    /// Bounding boxes don't affect any cached mesh data.
+    unsigned int GetMutatedMeshAttributes() const override;
     /// The execution callback.
     void Execute(aiScene* pScene) override;
+
+private:
+    int mBVH;
+    unsigned int mBVHMaxLeafSize;
 };
 
 } // Namespace Assimp
@@ -74,6 +74,11 @@ bool GenFaceNormalsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_GenNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int GenFaceNormalsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Normals;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenFaceNormalsProcess::Execute(aiScene *pScene) {
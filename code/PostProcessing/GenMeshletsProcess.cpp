@@ -0,0 +1,354 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the meshlet generation post-processing step.
+ *
+ * Meshlets are grown greedily, one triangle at a time: the next triangle is the one connected to the
+ * meshlet which adds the fewest new vertices, ties are broken by the distance to the centroid of the
+ * meshlet. The bounds follow the conventions of meshoptimizer, so the cone test of existing
+ * renderers can be used unchanged.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "Common/VertexTriangleAdjacency.h"
+#include "ProcessHelper.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Computes a bounding sphere of the indexed points with Ritter's algorithm
+void ComputeBoundingSphere(const aiVector3D *positions, const unsigned int *indices, unsigned int count,
+        aiVector3D &center, ai_real &radius) {
+    // start with the sphere spanned by two distant points ...
+    auto farthest = [&](const aiVector3D &from) {
+        unsigned int best = 0;
+        ai_real bestDistance = -1;
+        for (unsigned int i = 0; i < count; ++i) {
+            const ai_real distance = (positions[indices[i]] - from).SquareLength();
+            if (distance > bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+        return positions[indices[best]];
+    };
+    const aiVector3D a = farthest(positions[indices[0]]);
+    const aiVector3D b = farthest(a);
+    center = (a + b) * ai_real(0.5);
+    radius = (b - a).Length() * ai_real(0.5);
+
+    // ... and grow it until it contains all of them
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiVector3D &p = positions[indices[i]];
+        const ai_real distance = (p - center).Length();
+        if (distance > radius) {
+            const ai_real newRadius = (radius + distance) * ai_real(0.5);
+            center += (p - center) * ((newRadius - radius) / distance);
+            radius = newRadius;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the normalized normal of a triangle, or a zero vector for degenerate triangles
+aiVector3D TriangleNormal(const aiMesh *pMesh, unsigned int face) {
+    const unsigned int *idx = pMesh->mFaces[face].mIndices;
+    const aiVector3D &p0 = pMesh->mVertices[idx[0]];
+    aiVector3D n = (pMesh->mVertices[idx[1]] - p0) ^ (pMesh->mVertices[idx[2]] - p0);
+    const ai_real length = n.Length();
+    return length > 0 ? n / length : aiVector3D();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes the normal cone of a meshlet from its faces, the bounding sphere must be set already
+void ComputeNormalCone(const aiMesh *pMesh, const unsigned int *faces, unsigned int count, aiMeshlet &meshlet) {
+    meshlet.mConeApex = meshlet.mCenter;
+    meshlet.mConeAxis = aiVector3D();
+    meshlet.mConeCutoff = 1;
+
+    aiVector3D axis;
+    for (unsigned int i = 0; i < count; ++i) {
+        axis += TriangleNormal(pMesh, faces[i]);
+    }
+    const ai_real length = axis.Length();
+    if (length <= 0) {
+        return;
+    }
+    axis /= length;
+    meshlet.mConeAxis = axis;
+
+    ai_real minDot = 1;
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiVector3D n = TriangleNormal(pMesh, faces[i]);
+        if (n.SquareLength() > 0) {
+            minDot = std::min(minDot, n * axis);
+        }
+    }
+
+    // an opening angle close to or above 180 degrees never allows culling the meshlet
+    if (minDot <= ai_real(0.1)) {
+        return;
+    }
+
+    // move the apex back along the axis until all triangle planes are in front of it
+    ai_real maxT = 0;
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiVector3D n = TriangleNormal(pMesh, faces[i]);
+        if (n.SquareLength() > 0) {
+            const aiVector3D &p0 = pMesh->mVertices[pMesh->mFaces[faces[i]].mIndices[0]];
+            maxT = std::max(maxT, ((meshlet.mCenter - p0) * n) / (axis * n));
+        }
+    }
+    meshlet.mConeApex = meshlet.mCenter - axis * maxT;
+    meshlet.mConeCutoff = std::sqrt(1 - minDot * minDot);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::GenMeshletsProcess() :
+        mGenerate(false),
+        mMaxVertices(64),
+        mMaxTriangles(124) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::~GenMeshletsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsActive(unsigned int /*pFlags*/) const {
+    // there is no flag left for this step, AI_CONFIG_PP_MESHLET_GENERATE enables it
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GenMeshletsProcess::GetMutatedMeshAttributes() const {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetupProperties(const Importer *pImp) {
+    mGenerate = pImp->GetPropertyBool(AI_CONFIG_PP_MESHLET_GENERATE, false);
+    mMaxVertices = static_cast<unsigned int>(std::min(std::max(pImp->GetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_VERTICES, 64), 3), 255));
+    mMaxTriangles = static_cast<unsigned int>(std::min(std::max(pImp->GetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_TRIANGLES, 124), 1), 512));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::Execute(aiScene *pScene) {
+    if (!mGenerate) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess begin");
+
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        aiMesh *mesh = pScene->mMeshes[a];
+        delete mesh->mMeshlets;
+        mesh->mMeshlets = nullptr;
+        if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || !mesh->HasPositions() || !mesh->HasFaces()) {
+            return;
+        }
+        mesh->mMeshlets = BuildMeshlets(mesh, mMaxVertices, mMaxTriangles, shared);
+    });
+
+    unsigned int numMeshlets = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        if (pScene->mMeshes[a]->mMeshlets) {
+            numMeshlets += pScene->mMeshes[a]->mMeshlets->mNumMeshlets;
+        }
+    }
+    AddMetric("Meshlets", numMeshlets);
+    ASSIMP_LOG_INFO("GenMeshletsProcess finished. Generated ", numMeshlets, " meshlets");
+}
+
+// ------------------------------------------------------------------------------------------------
+aiMeshlets *GenMeshletsProcess::BuildMeshlets(const aiMesh *pMesh, unsigned int maxVertices, unsigned int maxTriangles,
+        SharedPostProcessInfo *shared) {
+    ai_assert(pMesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE);
+    maxVertices = std::min(std::max(maxVertices, 3u), 255u);
+    maxTriangles = std::max(maxTriangles, 1u);
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const aiVector3D *const positions = pMesh->mVertices;
+
+    // the adjacency lists are copied and kept partitioned: the first liveTriangles[v]
+    // entries of vertex v are the faces not assigned to a meshlet yet
+    std::unique_ptr<VertexTriangleAdjacency> _adj;
+    const VertexTriangleAdjacency &sharedAdj = GetVertexTriangleAdjacency(shared, pMesh, _adj);
+    std::vector<unsigned int> liveTriangles(sharedAdj.mLiveTriangles, sharedAdj.mLiveTriangles + pMesh->mNumVertices);
+    std::vector<unsigned int> adjacency(sharedAdj.mAdjacencyTable,
+            sharedAdj.mAdjacencyTable + std::accumulate(liveTriangles.begin(), liveTriangles.end(), 0u));
+    const unsigned int *const offsets = sharedAdj.mOffsetTable;
+
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned char> triangles;
+    std::vector<unsigned int> faces;
+    vertices.reserve(pMesh->mNumVertices);
+    triangles.reserve(numFaces * 3);
+    faces.reserve(numFaces);
+
+    // index of each vertex in the current meshlet, -1 if it is not part of it
+    std::vector<int> local(pMesh->mNumVertices, -1);
+    std::vector<bool> emitted(numFaces, false);
+
+    aiMeshlet meshlet = aiMeshlet();
+    aiVector3D centroid;
+
+    auto numNewVertices = [&](unsigned int face) {
+        const unsigned int *idx = pMesh->mFaces[face].mIndices;
+        return static_cast<unsigned int>((local[idx[0]] < 0) + (local[idx[1]] < 0) + (local[idx[2]] < 0));
+    };
+    auto finishMeshlet = [&]() {
+        for (size_t i = meshlet.mVertexOffset; i < vertices.size(); ++i) {
+            local[vertices[i]] = -1;
+        }
+        meshlets.push_back(meshlet);
+        meshlet = aiMeshlet();
+        meshlet.mVertexOffset = static_cast<unsigned int>(vertices.size());
+        meshlet.mTriangleOffset = static_cast<unsigned int>(faces.size());
+        centroid = aiVector3D();
+    };
+
+    unsigned int cursor = 0;
+    for (unsigned int n = 0; n < numFaces; ++n) {
+        int best = -1;
+        if (meshlet.mNumVertices > 0) {
+            const aiVector3D center = centroid / static_cast<ai_real>(meshlet.mNumVertices);
+            unsigned int bestNew = 4;
+            ai_real bestDistance = 0;
+            for (size_t i = meshlet.mVertexOffset; i < vertices.size(); ++i) {
+                const unsigned int v = vertices[i];
+                const unsigned int *tris = &adjacency[offsets[v]];
+                for (unsigned int t = 0; t < liveTriangles[v]; ++t) {
+                    const unsigned int face = tris[t];
+                    const unsigned int newVertices = numNewVertices(face);
+                    if (newVertices > bestNew || meshlet.mNumVertices + newVertices > maxVertices) {
+                        continue;
+                    }
+                    const unsigned int *idx = pMesh->mFaces[face].mIndices;
+                    const aiVector3D faceCenter = (positions[idx[0]] + positions[idx[1]] + positions[idx[2]]) / ai_real(3);
+                    const ai_real distance = (faceCenter - center).SquareLength();
+                    if (newVertices < bestNew || distance < bestDistance) {
+                        best = static_cast<int>(face);
+                        bestNew = newVertices;
+                        bestDistance = distance;
+                    }
+                }
+            }
+        }
+
+        if (best < 0) {
+            // nothing connected fits, continue with the next unassigned face in mesh order.
+            // It joins the current meshlet if there is room, so that meshes made of many
+            // small pieces don't end up with a meshlet per piece.
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = static_cast<int>(cursor);
+            if (meshlet.mNumVertices + numNewVertices(cursor) > maxVertices) {
+                finishMeshlet();
+            }
+        }
+
+        // add the face to the meshlet
+        const unsigned int face = static_cast<unsigned int>(best);
+        const unsigned int *idx = pMesh->mFaces[face].mIndices;
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = idx[k];
+            if (local[v] < 0) {
+                local[v] = static_cast<int>(meshlet.mNumVertices++);
+                vertices.push_back(v);
+                centroid += positions[v];
+            }
+            triangles.push_back(static_cast<unsigned char>(local[v]));
+
+            unsigned int *tris = &adjacency[offsets[v]];
+            unsigned int *const last = tris + liveTriangles[v] - 1;
+            *std::find(tris, last, face) = *last;
+            *last = face;
+            --liveTriangles[v];
+        }
+        faces.push_back(face);
+        emitted[face] = true;
+        if (++meshlet.mNumTriangles == maxTriangles) {
+            finishMeshlet();
+        }
+    }
+    if (meshlet.mNumTriangles > 0) {
+        finishMeshlet();
+    }
+
+    // compute the bounds of all meshlets
+    for (aiMeshlet &m : meshlets) {
+        ComputeBoundingSphere(positions, &vertices[m.mVertexOffset], m.mNumVertices, m.mCenter, m.mRadius);
+        ComputeNormalCone(pMesh, &faces[m.mTriangleOffset], m.mNumTriangles, m);
+    }
+
+    aiMeshlets *out = new aiMeshlets();
+    out->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    out->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), out->mMeshlets);
+    out->mNumVertices = static_cast<unsigned int>(vertices.size());
+    out->mVertices = new unsigned int[vertices.size()];
+    std::copy(vertices.begin(), vertices.end(), out->mVertices);
+    out->mNumTriangles = numFaces;
+    out->mTriangles = new unsigned char[triangles.size()];
+    std::copy(triangles.begin(), triangles.end(), out->mTriangles);
+    return out;
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
@@ -0,0 +1,99 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to partition meshes into meshlets.
+ */
+
+#pragma once
+
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+struct aiMeshlets;
+
+namespace Assimp {
+
+/** Post-processing process to partition triangle meshes into meshlets of a
+ *  bounded number of vertices and triangles, as consumed by mesh shaders and
+ *  cluster culling. Each meshlet gets a bounding sphere and a normal cone.
+ *
+ *  There is no flag for this step, it is enabled by #AI_CONFIG_PP_MESHLET_GENERATE.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenMeshletsProcess();
+    /// The class destructor.
+    ~GenMeshletsProcess();
+    /// Always returns true, the step is enabled by AI_CONFIG_PP_MESHLET_GENERATE.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Reads the limits from the importer configuration.
+    void SetupProperties(const Importer *pImp) override;
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    /// @brief  Partitions a triangle mesh into meshlets.
+    /// @param  pMesh         The mesh, must consist of triangles only.
+    /// @param  maxVertices   Maximum number of vertices per meshlet, 3 ... 255.
+    /// @param  maxTriangles  Maximum number of triangles per meshlet, at least 1.
+    /// @param  shared        Cache to take the adjacency of the mesh from, may be nullptr.
+    /// @return The meshlets, owned by the caller.
+    static aiMeshlets *BuildMeshlets(const aiMesh *pMesh, unsigned int maxVertices, unsigned int maxTriangles,
+            SharedPostProcessInfo *shared = nullptr);
+    /// Meshlets don't affect any cached mesh data.
+    unsigned int GetMutatedMeshAttributes() const override;
+
+private:
+    bool mGenerate;
+    unsigned int mMaxVertices;
+    unsigned int mMaxTriangles;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 #include <assimp/qnan.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -74,6 +76,11 @@ bool GenVertexNormalsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_GenSmoothNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int GenVertexNormalsProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Normals;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::SetupProperties(const Importer *pImp) {
@@ -91,11 +98,11 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
     }
 
-    bool bHas = false;
-    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        if (GenMeshVertexNormals(pScene->mMeshes[a], a))
-            bHas = true;
-    }
+    std::vector<char> results(pScene->mNumMeshes, 0);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        results[a] = GenMeshVertexNormals(pScene->mMeshes[a], a);
+    });
+    const bool bHas = std::find(results.begin(), results.end(), 1) != results.end();
 
     if (bHas) {
         ASSIMP_LOG_INFO("GenVertexNormalsProcess finished. "
@@ -108,7 +115,7 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
 
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
-bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int meshIndex) {
+bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int /*meshIndex*/) {
     if (nullptr != pMesh->mNormals) {
         if (force_)
             delete[] pMesh->mNormals;
@@ -125,52 +132,27 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
     }
 
     // Allocate the array to hold the output normals
-    const float qnan = std::numeric_limits<ai_real>::quiet_NaN();
     pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    // Compute per-face normals but store them per-vertex
+    // Compute per-face normals but store them per-vertex,
+    // check whether we can reuse the face normals of a previous step.
+    std::vector<aiVector3D> _faceNormals;
+    const std::vector<aiVector3D> &faceNormals = GetFaceNormals(shared, pMesh, _faceNormals);
     for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         const aiFace &face = pMesh->mFaces[a];
-        if (face.mNumIndices < 3) {
-            // either a point or a line -> no normal vector
-            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-                pMesh->mNormals[face.mIndices[i]] = aiVector3D(qnan);
-            }
-
-            continue;
-        }
-
-        const aiVector3D *pV1 = &pMesh->mVertices[face.mIndices[0]];
-        const aiVector3D *pV2 = &pMesh->mVertices[face.mIndices[1]];
-        const aiVector3D *pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
-        if (flippedWindingOrder_)
-            std::swap( pV2, pV3 );
-        const aiVector3D vNor = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
+        const aiVector3D vNor = flippedWindingOrder_ ? -faceNormals[a] : faceNormals[a];
 
         for (unsigned int i = 0; i < face.mNumIndices; ++i) {
             pMesh->mNormals[face.mIndices[i]] = vNor;
         }
     }
 
-    // Set up a SpatialSort to quickly find all vertices close to a given position
-    // check whether we can reuse the SpatialSort of a previous step.
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-    ai_real posEpsilon = ai_real(1e-5);
-    if (shared) {
-        std::vector<std::pair<SpatialSort, ai_real>> *avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT, avf);
-        if (avf) {
-            std::pair<SpatialSort, ai_real> &blubb = avf->operator[](meshIndex);
-            vertexFinder = &blubb.first;
-            posEpsilon = blubb.second;
-        }
-    }
-    if (!vertexFinder) {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
-        vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
-    }
+    // Set up a spatial index to quickly find all vertices close to a given position
+    // check whether we can reuse the index of a previous step.
+    SharedSpatialIndex _vertexFinder;
+    const SharedSpatialIndex &spatialIndex = GetSpatialIndex(shared, pMesh, threadPool, _vertexFinder);
+    const SpatialHashGrid *vertexFinder = &spatialIndex.first;
+    const ai_real posEpsilon = spatialIndex.second;
     std::vector<unsigned int> verticesFound;
     aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
 
@@ -79,6 +79,10 @@ public:
     */
     void SetupProperties(const Importer* pImp);
 
+    // -------------------------------------------------------------------
+    /** Returns the mesh attributes modified by the step, the normals. */
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
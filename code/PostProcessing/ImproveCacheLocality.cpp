@@ -43,28 +43,377 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /** @file Implementation of the post processing step to improve the cache locality of a mesh.
  * <br>
- * The algorithm is roughly basing on this paper:
+ * The face order is computed as described in Tom Forsyth's "Linear-Speed Vertex Cache
+ * Optimisation", https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html.
+ * Overdraw reduction follows Sander, Nehab and Barczak, "Fast Triangle Reordering for
+ * Vertex Locality and Reduced Overdraw":
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw reduction isn't implemented yet ...
  */
 
 // internal headers
 #include "PostProcessing/ImproveCacheLocality.h"
 #include "Common/VertexTriangleAdjacency.h"
+#include "ProcessHelper.h"
 
 #include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
 #include <stdio.h>
-#include <stack>
+#include <vector>
 
 using namespace Assimp;
 
+namespace {
+
+// Scoring parameters from Forsyth's paper
+const float CacheDecayPower = 1.5f;
+const float LastTriScore = 0.75f;
+const float ValenceBoostScale = 2.0f;
+const float ValenceBoostPower = 0.5f;
+
+// ------------------------------------------------------------------------------------------------
+// Score of a vertex at the given position of a LRU cache (-1 if not cached) which is still
+// used by the given number of faces to be emitted
+float ComputeVertexScore(int cachePosition, unsigned int numLiveTriangles, unsigned int cacheSize) {
+    if (0 == numLiveTriangles) {
+        // no faces left, the vertex doesn't matter anymore
+        return -1.f;
+    }
+
+    float score = 0.f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // the vertex was used by the last face, there's no point in favouring one of them
+            score = LastTriScore;
+        } else {
+            const float scaler = 1.f / (cacheSize - 3);
+            score = std::pow(1.f - (cachePosition - 3) * scaler, CacheDecayPower);
+        }
+    }
+
+    // bonus for vertices with few faces left, so lone faces don't get stranded
+    return score + ValenceBoostScale * std::pow(static_cast<float>(numLiveTriangles), -ValenceBoostPower);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Simulates a FIFO cache of the given size and returns the number of cache misses. If
+// missesPerFace is given, the misses of each face are added to it.
+unsigned int SimulateCache(const std::vector<unsigned int> &indices, unsigned int numVertices,
+        unsigned int cacheSize, unsigned int *missesPerFace = nullptr) {
+    // a vertex is cached if less than cacheSize vertices were added since it was
+    std::vector<unsigned int> stamps(numVertices, 0);
+    unsigned int stamp = cacheSize + 1;
+    unsigned int misses = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const unsigned int v = indices[i];
+        if (stamp - stamps[v] > cacheSize) {
+            stamps[v] = stamp++;
+            ++misses;
+            if (missesPerFace) {
+                ++missesPerFace[i / 3];
+            }
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the triangles in indices for a LRU cache of the given size
+void OptimizeVertexCache(SharedPostProcessInfo *shared, aiMesh *pMesh, unsigned int cacheSize,
+        std::vector<unsigned int> &indices) {
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // the adjacency lists are copied and kept partitioned: the first liveTriangles[v]
+    // entries of vertex v are the faces not yet emitted
+    std::unique_ptr<VertexTriangleAdjacency> _adj;
+    const VertexTriangleAdjacency &sharedAdj = GetVertexTriangleAdjacency(shared, pMesh, _adj);
+    std::vector<unsigned int> liveTriangles(sharedAdj.mLiveTriangles, sharedAdj.mLiveTriangles + numVertices);
+    std::vector<unsigned int> adjacency(sharedAdj.mAdjacencyTable,
+            sharedAdj.mAdjacencyTable + std::accumulate(liveTriangles.begin(), liveTriangles.end(), 0u));
+    const unsigned int *const offsets = sharedAdj.mOffsetTable;
+
+    std::vector<int> cachePosition(numVertices, -1);
+    std::vector<float> vertexScore(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        vertexScore[v] = ComputeVertexScore(-1, liveTriangles[v], cacheSize);
+    }
+
+    std::vector<float> faceScore(numFaces);
+    int best = -1;
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const unsigned int *idx = pMesh->mFaces[f].mIndices;
+        faceScore[f] = vertexScore[idx[0]] + vertexScore[idx[1]] + vertexScore[idx[2]];
+        if (best < 0 || faceScore[f] > faceScore[best]) {
+            best = static_cast<int>(f);
+        }
+    }
+
+    std::vector<bool> emitted(numFaces, false);
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+    unsigned int cursor = 0;
+
+    indices.clear();
+    indices.reserve(numFaces * 3);
+    for (unsigned int numEmitted = 0; numEmitted < numFaces; ++numEmitted) {
+        if (best < 0) {
+            // dead end - no cached vertex has faces left, continue in input order
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = static_cast<int>(cursor);
+        }
+
+        const unsigned int face = static_cast<unsigned int>(best);
+        const unsigned int *idx = pMesh->mFaces[face].mIndices;
+        emitted[face] = true;
+
+        // emit the face and move its vertices to the front of the cache
+        newCache.clear();
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = idx[k];
+            indices.push_back(v);
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+
+            // drop the face from the live partition of the vertex
+            unsigned int *tris = &adjacency[offsets[v]];
+            unsigned int *const last = tris + liveTriangles[v] - 1;
+            *std::find(tris, last, face) = *last;
+            *last = face;
+            --liveTriangles[v];
+        }
+        for (unsigned int v : cache) {
+            if (v != idx[0] && v != idx[1] && v != idx[2]) {
+                newCache.push_back(v);
+            }
+        }
+
+        // rescore all vertices that moved or dropped out of the cache, and their faces
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            const unsigned int v = newCache[i];
+            cachePosition[v] = i < cacheSize ? static_cast<int>(i) : -1;
+            const float score = ComputeVertexScore(cachePosition[v], liveTriangles[v], cacheSize);
+            const float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            const unsigned int *tris = &adjacency[offsets[v]];
+            for (unsigned int t = 0; t < liveTriangles[v]; ++t) {
+                faceScore[tris[t]] += delta;
+            }
+        }
+        if (newCache.size() > cacheSize) {
+            newCache.resize(cacheSize);
+        }
+        cache.swap(newCache);
+
+        // the next face is the best one using a cached vertex
+        best = -1;
+        for (unsigned int v : cache) {
+            const unsigned int *tris = &adjacency[offsets[v]];
+            for (unsigned int t = 0; t < liveTriangles[v]; ++t) {
+                if (best < 0 || faceScore[tris[t]] > faceScore[best]) {
+                    best = static_cast<int>(tris[t]);
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Splits the cache optimized face order into clusters and sorts them so that outward facing
+// clusters come first. A cluster is closed once its ACMR drops below threshold times the ACMR
+// of the run of faces it belongs to.
+void OptimizeOverdraw(const aiMesh *pMesh, unsigned int cacheSize, float threshold, std::vector<unsigned int> &indices) {
+    const size_t numFaces = indices.size() / 3;
+
+    // hard boundaries: the cache was flushed, all vertices of the face missed
+    std::vector<unsigned int> misses(numFaces, 0);
+    SimulateCache(indices, pMesh->mNumVertices, cacheSize, misses.data());
+    std::vector<size_t> hardBoundaries;
+    for (size_t f = 0; f < numFaces; ++f) {
+        if (0 == f || 3 == misses[f]) {
+            hardBoundaries.push_back(f);
+        }
+    }
+    hardBoundaries.push_back(numFaces);
+
+    // soft boundaries, simulating a cache which is flushed at the start of each cluster
+    std::vector<unsigned int> stamps(pMesh->mNumVertices, 0);
+    unsigned int stamp = cacheSize + 1;
+    auto countMisses = [&](size_t f) {
+        unsigned int n = 0;
+        for (size_t k = f * 3; k < f * 3 + 3; ++k) {
+            if (stamp - stamps[indices[k]] > cacheSize) {
+                stamps[indices[k]] = stamp++;
+                ++n;
+            }
+        }
+        return n;
+    };
+
+    std::vector<size_t> clusters;
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h) {
+        const size_t start = hardBoundaries[h], end = hardBoundaries[h + 1];
+
+        stamp += cacheSize + 1;
+        unsigned int runMisses = 0;
+        for (size_t f = start; f < end; ++f) {
+            runMisses += countMisses(f);
+        }
+        const float clusterThreshold = threshold * runMisses / static_cast<float>(end - start);
+
+        const size_t first = clusters.size();
+        clusters.push_back(start);
+        stamp += cacheSize + 1;
+        unsigned int clusterMisses = 0, clusterFaces = 0;
+        for (size_t f = start; f < end; ++f) {
+            clusterMisses += countMisses(f);
+            ++clusterFaces;
+            if (clusterMisses <= clusterThreshold * clusterFaces && f + 1 < end) {
+                clusters.push_back(f + 1);
+                stamp += cacheSize + 1;
+                clusterMisses = clusterFaces = 0;
+            }
+        }
+
+        // the trailing cluster didn't reach the threshold, merge it with the previous one
+        if (clusterFaces > 0 && clusters.size() - first > 1) {
+            clusters.pop_back();
+        }
+    }
+    clusters.push_back(numFaces);
+
+    // sort key: how far the cluster faces away from the mesh centre
+    aiVector3D meshCenter;
+    for (unsigned int i : indices) {
+        meshCenter += pMesh->mVertices[i];
+    }
+    meshCenter /= static_cast<ai_real>(indices.size());
+
+    const size_t numClusters = clusters.size() - 1;
+    std::vector<float> sortKey(numClusters);
+    std::vector<size_t> order(numClusters);
+    for (size_t c = 0; c < numClusters; ++c) {
+        aiVector3D center, normal;
+        ai_real area = 0;
+        for (size_t f = clusters[c]; f < clusters[c + 1]; ++f) {
+            const aiVector3D &p0 = pMesh->mVertices[indices[f * 3]];
+            const aiVector3D &p1 = pMesh->mVertices[indices[f * 3 + 1]];
+            const aiVector3D &p2 = pMesh->mVertices[indices[f * 3 + 2]];
+            const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+            const ai_real a = n.Length();
+            center += (p0 + p1 + p2) * (a / 3);
+            normal += n;
+            area += a;
+        }
+        if (area > 0) {
+            center /= area;
+        }
+        const ai_real length = normal.Length();
+        sortKey[c] = length > 0 ? static_cast<float>(((center - meshCenter) * normal) / length) : 0.f;
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return sortKey[lhs] > sortKey[rhs];
+    });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (size_t c : order) {
+        sorted.insert(sorted.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+    indices.swap(sorted);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void RemapStream(T *&data, const std::vector<unsigned int> &remap) {
+    if (nullptr == data) {
+        return;
+    }
+    T *remapped = new T[remap.size()];
+    for (size_t v = 0; v < remap.size(); ++v) {
+        remapped[remap[v]] = data[v];
+    }
+    delete[] data;
+    data = remapped;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves each vertex v of a mesh or anim mesh to remap[v]
+template <class XMesh>
+void RemapVertices(XMesh *pMesh, const std::vector<unsigned int> &remap) {
+    RemapStream(pMesh->mVertices, remap);
+    RemapStream(pMesh->mNormals, remap);
+    RemapStream(pMesh->mTangents, remap);
+    RemapStream(pMesh->mBitangents, remap);
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        RemapStream(pMesh->mColors[a], remap);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        RemapStream(pMesh->mTextureCoords[a], remap);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Renumbers the vertices in the order the faces first use them, unused vertices go last
+void OptimizeVertexFetch(aiMesh *pMesh) {
+    std::vector<unsigned int> remap(pMesh->mNumVertices, UINT_MAX);
+    unsigned int next = 0;
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace &face = pMesh->mFaces[f];
+        for (unsigned int k = 0; k < face.mNumIndices; ++k) {
+            unsigned int &target = remap[face.mIndices[k]];
+            if (UINT_MAX == target) {
+                target = next++;
+            }
+            face.mIndices[k] = target;
+        }
+    }
+    bool identity = true;
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        if (UINT_MAX == remap[v]) {
+            remap[v] = next++;
+        }
+        identity = identity && remap[v] == v;
+    }
+    if (identity) {
+        return;
+    }
+
+    RemapVertices(pMesh, remap);
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        if (pMesh->mAnimMeshes[a]->mNumVertices == pMesh->mNumVertices) {
+            RemapVertices(pMesh->mAnimMeshes[a], remap);
+        }
+    }
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        aiBone *bone = pMesh->mBones[a];
+        for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; ++b) {
+            if (bone->mWeights[b].mVertexId < pMesh->mNumVertices) {
+                bone->mWeights[b].mVertexId = remap[bone->mWeights[b].mVertexId];
+            }
+        }
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
-: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
+: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE)
+, mConfigOverdrawThreshold(0.f)
+, mConfigVertexFetch(false) {
     // empty
 }
 
@@ -80,11 +429,18 @@ bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
     return (pFlags & aiProcess_ImproveCacheLocality) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int ImproveCacheLocalityProcess::GetMutatedMeshAttributes() const {
+    return mConfigVertexFetch ? MeshAttr_All : MeshAttr_Faces;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration
 void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+    mConfigOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD, 0.f);
+    mConfigVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -97,283 +453,104 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
-    float out = 0.f;
-    unsigned int numf = 0, numm = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
-        if (res) {
-            numf += pScene->mMeshes[a]->mNumFaces;
-            out  += res;
+    std::vector<MeshStatistics> results(pScene->mNumMeshes);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        results[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+
+    unsigned int numf = 0, numv = 0, numm = 0, missesIn = 0, missesOut = 0;
+    for (const MeshStatistics &res : results) {
+        if (res.mNumFaces) {
+            numf += res.mNumFaces;
+            numv += res.mNumVertices;
+            missesIn += res.mMissesIn;
+            missesOut += res.mMissesOut;
             ++numm;
         }
     }
-    if (!DefaultLogger::isNullLogger()) {
-        if (numf > 0) {
-            ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
-        }
-        ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
+    if (numf > 0) {
+        const float acmrIn = missesIn / static_cast<float>(numf), acmrOut = missesOut / static_cast<float>(numf);
+        const float atvrIn = missesIn / static_cast<float>(numv), atvrOut = missesOut / static_cast<float>(numv);
+        ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", numf, " faces). ACMR in: ", acmrIn, " out: ", acmrOut,
+                " | ATVR in: ", atvrIn, " out: ", atvrOut);
+        AddMetric("ACMR in", acmrIn);
+        AddMetric("ACMR out", acmrOut);
+        AddMetric("ATVR in", atvrIn);
+        AddMetric("ATVR out", atvrOut);
     }
+    ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
 }
 
 // ------------------------------------------------------------------------------------------------
 // Improves the cache coherency of a specific mesh
-ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum) {
-    // TODO: rewrite this to use std::vector or boost::shared_array
+ImproveCacheLocalityProcess::MeshStatistics ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum) {
     ai_assert(nullptr != pMesh);
+    MeshStatistics stats;
 
     // Check whether the input data is valid
     // - there must be vertices and faces
     // - all faces must be triangulated or we can't operate on them
     if (!pMesh->HasFaces() || !pMesh->HasPositions())
-        return static_cast<ai_real>(0.f);
+        return stats;
 
     if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
         ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
-        return static_cast<ai_real>(0.f);
+        return stats;
     }
 
-    if(pMesh->mNumVertices <= mConfigCacheDepth) {
-        return static_cast<ai_real>(0.f);
+    if(pMesh->mNumVertices <= mConfigCacheDepth || mConfigCacheDepth < 4) {
+        return stats;
     }
 
-    ai_real fACMR = 3.f;
-    const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
-
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[mConfigCacheDepth];
-        memset(piFIFOStack,0xff,mConfigCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + mConfigCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
-            }
-        }
-        delete[] piFIFOStack;
-        fACMR = (ai_real) iCacheMisses / pMesh->mNumFaces;
-        if (3.0 == fACMR)   {
-            char szBuff[128]; // should be sufficiently large in every case
-
-            // the JoinIdenticalVertices process has not been executed on this
-            // mesh, otherwise this value would normally be at least minimally
-            // smaller than 3.0 ...
-            ai_snprintf(szBuff,128,"Mesh %u: Not suitable for vcache optimization",meshNum);
-            ASSIMP_LOG_WARN(szBuff);
-            return static_cast<ai_real>(0.f);
-        }
+    // work on a flat copy of the index buffer
+    std::vector<unsigned int> indices;
+    indices.reserve(pMesh->mNumFaces * 3);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        indices.insert(indices.end(), pMesh->mFaces[f].mIndices, pMesh->mFaces[f].mIndices + 3);
     }
-
-    // first we need to build a vertex-triangle adjacency list
-    VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
-
-    // build a list to store per-vertex caching time stamps
-    unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
-    memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
-
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
-    unsigned int* piCSIter = piIBOutput;
-
-    // allocate the flag array to hold the information
-    // whether a face has already been emitted or not
-    std::vector<bool> abEmitted(pMesh->mNumFaces,false);
-
-    // dead-end vertex index stack
-    std::stack<unsigned int, std::vector<unsigned int> > sDeadEndVStack;
-
-    // create a copy of the piNumTriPtr buffer
-    unsigned int* const piNumTriPtr = adj.mLiveTriangles;
-    const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + pMesh->mNumVertices);
-
-    // get the largest number of referenced triangles and allocate the "candidate buffer"
-    unsigned int iMaxRefTris = 0; {
-        const unsigned int* piCur = adj.mLiveTriangles;
-        const unsigned int* const piCurEnd = adj.mLiveTriangles+pMesh->mNumVertices;
-        for (;piCur != piCurEnd;++piCur) {
-            iMaxRefTris = std::max(iMaxRefTris,*piCur);
-        }
+    const unsigned int missesIn = SimulateCache(indices, pMesh->mNumVertices, mConfigCacheDepth);
+    if (missesIn == indices.size()) {
+        // the JoinIdenticalVertices process has not been executed on this
+        // mesh, otherwise this value would normally be at least minimally
+        // smaller than 3.0 ...
+        ASSIMP_LOG_WARN("Mesh ", meshNum, ": Not suitable for vcache optimization");
+        return stats;
     }
-    ai_assert(iMaxRefTris > 0);
-    unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
-
-    // ...................................................................................
-    /** PSEUDOCODE for the algorithm
-
-        A = Build-Adjacency(I) Vertex-triangle adjacency
-        L = Get-Triangle-Counts(A) Per-vertex live triangle counts
-        C = Zero(Vertex-Count(I)) Per-vertex caching time stamps
-        D = Empty-Stack() Dead-end vertex stack
-        E = False(Triangle-Count(I)) Per triangle emitted flag
-        O = Empty-Index-Buffer() Empty output buffer
-        f = 0 Arbitrary starting vertex
-        s = k+1, i = 1 Time stamp and cursor
-        while f >= 0 For all valid fanning vertices
-            N = Empty-Set() 1-ring of next candidates
-            for each Triangle t in Neighbors(A, f)
-                if !Emitted(E,t)
-                    for each Vertex v in t
-                        Append(O,v) Output vertex
-                        Push(D,v) Add to dead-end stack
-                        Insert(N,v) Register as candidate
-                        L[v] = L[v]-1 Decrease live triangle count
-                        if s-C[v] > k If not in cache
-                            C[v] = s Set time stamp
-                            s = s+1 Increment time stamp
-                    E[t] = true Flag triangle as emitted
-            Select next fanning vertex
-            f = Get-Next-Vertex(I,i,k,N,C,s,L,D)
-        return O
-        */
-    // ...................................................................................
-
-    int ivdx = 0;
-    int ics = 1;
-    int iStampCnt = mConfigCacheDepth+1;
-    while (ivdx >= 0)   {
-
-        unsigned int icnt = piNumTriPtrNoModify[ivdx];
-        unsigned int* piList = adj.GetAdjacentTriangles(ivdx);
-        unsigned int* piCurCandidate = piCandidates;
-
-        // get all triangles in the neighborhood
-        for (unsigned int tri = 0; tri < icnt;++tri)    {
-
-            // if they have not yet been emitted, add them to the output IB
-            const unsigned int fidx = *piList++;
-            if (!abEmitted[fidx])   {
-
-                // so iterate through all vertices of the current triangle
-                const aiFace* pcFace = &pMesh->mFaces[ fidx ];
-                unsigned nind = pcFace->mNumIndices;
-                for (unsigned ind = 0; ind < nind; ind++) {
-                    unsigned dp = pcFace->mIndices[ind];
-
-                    // the current vertex won't have any free triangles after this step
-                    if (ivdx != (int)dp) {
-                        // append the vertex to the dead-end stack
-                        sDeadEndVStack.push(dp);
-
-                        // register as candidate for the next step
-                        *piCurCandidate++ = dp;
-
-                        // decrease the per-vertex triangle counts
-                        piNumTriPtr[dp]--;
-                    }
-
-                    // append the vertex to the output index buffer
-                    *piCSIter++ = dp;
-
-                    // if the vertex is not yet in cache, set its cache count
-                    if (iStampCnt-piCachingStamps[dp] > mConfigCacheDepth) {
-                        piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
-                    }
-                }
-                // flag triangle as emitted
-                abEmitted[fidx] = true;
-            }
-        }
 
-        // the vertex has now no living adjacent triangles anymore
-        piNumTriPtr[ivdx] = 0;
-
-        // get next fanning vertex
-        ivdx = -1;
-        int max_priority = -1;
-        for (unsigned int* piCur = piCandidates;piCur != piCurCandidate;++piCur)    {
-            const unsigned int dp = *piCur;
-
-            // must have live triangles
-            if (piNumTriPtr[dp] > 0)    {
-                int priority = 0;
-
-                // will the vertex be in cache, even after fanning occurs?
-                unsigned int tmp;
-                if ((tmp = iStampCnt-piCachingStamps[dp]) + 2*piNumTriPtr[dp] <= mConfigCacheDepth) {
-                    priority = tmp;
-                }
-
-                // keep best candidate
-                if (priority > max_priority) {
-                    max_priority = priority;
-                    ivdx = dp;
-                }
-            }
-        }
-        // did we reach a dead end?
-        if (-1 == ivdx) {
-            // need to get a non-local vertex for which we have a good chance that it is still
-            // in the cache ...
-            while (!sDeadEndVStack.empty()) {
-                unsigned int iCachedIdx = sDeadEndVStack.top();
-                sDeadEndVStack.pop();
-                if (piNumTriPtr[ iCachedIdx ] > 0)  {
-                    ivdx = iCachedIdx;
-                    break;
-                }
-            }
-
-            if (-1 == ivdx) {
-                // well, there isn't such a vertex. Simply get the next vertex in input order and
-                // hope it is not too bad ...
-                while (ics < (int)pMesh->mNumVertices)  {
-                    ++ics;
-                    if (piNumTriPtr[ics] > 0)   {
-                        ivdx = ics;
-                        break;
-                    }
-                }
-            }
-        }
+    std::vector<unsigned int> optimized;
+    OptimizeVertexCache(shared, pMesh, mConfigCacheDepth, optimized);
+    if (SimulateCache(optimized, pMesh->mNumVertices, mConfigCacheDepth) < missesIn) {
+        indices.swap(optimized);
+    }
+    if (mConfigOverdrawThreshold >= 1.f) {
+        OptimizeOverdraw(pMesh, mConfigCacheDepth, mConfigOverdrawThreshold, indices);
     }
-    ai_real fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
 
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_VERBOSE_DEBUG("Mesh %u | ACMR in: ", meshNum, " out: ", fACMR, " | ~", fACMR2, ((fACMR - fACMR2) / fACMR) * 100.f);
-        }
+    stats.mNumFaces = pMesh->mNumFaces;
+    stats.mMissesIn = missesIn;
+    stats.mMissesOut = SimulateCache(indices, pMesh->mNumVertices, mConfigCacheDepth);
+    std::vector<bool> referenced(pMesh->mNumVertices, false);
+    for (unsigned int v : indices) {
+        stats.mNumVertices += referenced[v] ? 0 : 1;
+        referenced[v] = true;
+    }
 
-        fACMR2 *= pMesh->mNumFaces;
+    // very intense verbose logging ... prepare for much text if there are many meshes
+    if (!DefaultLogger::isNullLogger() && DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
+        ASSIMP_LOG_VERBOSE_DEBUG("Mesh ", meshNum, " | ACMR in: ", stats.mMissesIn / static_cast<float>(stats.mNumFaces),
+                " out: ", stats.mMissesOut / static_cast<float>(stats.mNumFaces),
+                " | ATVR in: ", stats.mMissesIn / static_cast<float>(stats.mNumVertices),
+                " out: ", stats.mMissesOut / static_cast<float>(stats.mNumVertices));
     }
+
     // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned * ind = pcFace->mIndices;
-        if (nind > 0) ind[0] = *piCSIter++;
-        if (nind > 1) ind[1] = *piCSIter++;
-        if (nind > 2) ind[2] = *piCSIter++;
+    const unsigned int *idx = indices.data();
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f, idx += 3) {
+        std::copy(idx, idx + 3, pMesh->mFaces[f].mIndices);
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
-
-    return fACMR2;
+    if (mConfigVertexFetch) {
+        OptimizeVertexFetch(pMesh);
+    }
+    return stats;
 }
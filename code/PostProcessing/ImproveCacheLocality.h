@@ -56,12 +56,14 @@ namespace Assimp
 
 // ---------------------------------------------------------------------------
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
- *  cache locality. It tries to arrange all faces to fans and to render
- *  faces which share vertices directly one after the other.
+ *  cache locality. Faces are emitted greedily by a score which favours
+ *  vertices recently used and vertices with few remaining faces.
+ *  Optionally the faces are then regrouped to reduce overdraw, and the
+ *  vertices are renumbered in the order of first use for vertex fetch.
  *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -74,6 +76,11 @@ public:
     // Check whether the pp step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    // Mesh attributes modified by the step, the faces and, with vertex fetch
+    // optimization enabled, the order of all vertex streams
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     // Executes the pp step on a given scene
     void Execute( aiScene* pScene);
@@ -82,18 +89,40 @@ public:
     // Configures the pp step
     void SetupProperties(const Importer* pImp);
 
-protected:
+    // -------------------------------------------------------------------
+    /** Post-transform cache statistics of a mesh, as seen by a FIFO
+     *  cache of the configured size */
+    struct MeshStatistics {
+        //! Number of faces, zero if the mesh was not processed
+        unsigned int mNumFaces = 0;
+
+        //! Number of vertices referenced by the faces
+        unsigned int mNumVertices = 0;
+
+        //! Cache misses before and after the step
+        unsigned int mMissesIn = 0;
+        unsigned int mMissesOut = 0;
+    };
+
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
      * @param pMesh The mesh to process.
      * @param meshNum Index of the mesh to process
+     * @return Cache statistics of the mesh
      */
-    ai_real ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
+    MeshStatistics ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
 
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: allowed ACMR increase for overdraw
+    //! reduction, below 1 to disable it
+    float mConfigOverdrawThreshold;
+
+    //! Configuration parameter: renumber vertices in first-use order
+    bool mConfigVertexFetch;
 };
 
 } // end of namespace Assimp
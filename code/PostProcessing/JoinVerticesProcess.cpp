@@ -53,12 +53,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Vertex.h>
 #include <assimp/TinyFormatter.h>
 #include <stdio.h>
-#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 
 using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: mExactMatch(false)
 {
     // nothing to do here
 }
@@ -76,6 +79,13 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    mExactMatch = pImp->GetPropertyBool(AI_CONFIG_PP_JIV_EXACT_MATCH, false);
+}
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -91,9 +101,11 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
     }
 
     // execute the step
-    int iNumVertices = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+    std::vector<int> numVertices(pScene->mNumMeshes, 0);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        numVertices[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+    const int iNumVertices = std::accumulate(numVertices.begin(), numVertices.end(), 0);
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger()) {
@@ -226,8 +238,193 @@ void updateXMeshVertices(XMesh *pMesh, std::vector<Vertex> &uniqueVertices) {
         }
     }
 }
+
+// Number of values packAttributes() writes per vertex of the given mesh
+template<class XMesh>
+unsigned int countAttributes(const XMesh *pMesh) {
+    unsigned int count = 0;
+    if (pMesh->mVertices) {
+        count += 3;
+    }
+    if (pMesh->mNormals) {
+        count += 3;
+    }
+    if (pMesh->mTangents) {
+        count += 3;
+    }
+    if (pMesh->mBitangents) {
+        count += 3;
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; a++) {
+        count += pMesh->HasVertexColors(a) ? 4 : 0;
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+        count += pMesh->HasTextureCoords(a) ? 3 : 0;
+    }
+    return count;
+}
+
+// Adding zero turns -0 into +0, so equal values are always bitwise equal afterwards
+inline ai_real *packVector(const aiVector3D &v, ai_real *out) {
+    out[0] = v.x + ai_real(0.0);
+    out[1] = v.y + ai_real(0.0);
+    out[2] = v.z + ai_real(0.0);
+    return out + 3;
+}
+
+// Writes all attributes of a vertex to a flat record which can be hashed and compared bytewise
+template<class XMesh>
+ai_real *packAttributes(const XMesh *pMesh, unsigned int index, ai_real *out) {
+    if (pMesh->mVertices) {
+        out = packVector(pMesh->mVertices[index], out);
+    }
+    if (pMesh->mNormals) {
+        out = packVector(pMesh->mNormals[index], out);
+    }
+    if (pMesh->mTangents) {
+        out = packVector(pMesh->mTangents[index], out);
+    }
+    if (pMesh->mBitangents) {
+        out = packVector(pMesh->mBitangents[index], out);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; a++) {
+        if (pMesh->HasVertexColors(a)) {
+            const aiColor4D &c = pMesh->mColors[a][index];
+            out[0] = c.r + ai_real(0.0);
+            out[1] = c.g + ai_real(0.0);
+            out[2] = c.b + ai_real(0.0);
+            out[3] = c.a + ai_real(0.0);
+            out += 4;
+        }
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+        if (pMesh->HasTextureCoords(a)) {
+            out = packVector(pMesh->mTextureCoords[a][index], out);
+        }
+    }
+    return out;
+}
+
+// FNV-1a over 32 bit words, sizeInBytes must be a multiple of four
+inline uint64_t hashWords(const void *data, size_t sizeInBytes, uint64_t hash) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < sizeInBytes; i += 4) {
+        uint32_t word;
+        ::memcpy(&word, bytes + i, 4);
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    return hash ^ (hash >> 32);
+}
+
+// A bone influence as (bone index, weight), ordered by bone
+typedef std::pair<unsigned int, ai_real> BoneInfluence;
+
 } // namespace
 
+// ------------------------------------------------------------------------------------------------
+// Finds all used vertices of the mesh which are bitwise identical
+void JoinVerticesProcess::FindExactDuplicates(const aiMesh* pMesh,
+        const std::vector<bool>& usedVertices,
+        std::vector<unsigned int>& replaceIndex,
+        std::vector<unsigned int>& uniqueSources)
+{
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // the record of a vertex holds the attributes of the mesh followed by those of each anim mesh
+    unsigned int stride = countAttributes(pMesh);
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; a++) {
+        stride += countAttributes(pMesh->mAnimMeshes[a]);
+    }
+
+    // gather the bone influences per vertex, bones store them the other way round
+    std::vector<unsigned int> influenceStart(numVertices + 1, 0);
+    for (unsigned int a = 0; a < pMesh->mNumBones; a++) {
+        const aiBone *bone = pMesh->mBones[a];
+        for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; b++) {
+            if (bone->mWeights[b].mVertexId < numVertices) {
+                ++influenceStart[bone->mWeights[b].mVertexId + 1];
+            }
+        }
+    }
+    std::partial_sum(influenceStart.begin(), influenceStart.end(), influenceStart.begin());
+    std::vector<BoneInfluence> influences(influenceStart.back());
+    if (!influences.empty()) {
+        std::vector<unsigned int> cursor(influenceStart.begin(), influenceStart.end() - 1);
+        for (unsigned int a = 0; a < pMesh->mNumBones; a++) {
+            const aiBone *bone = pMesh->mBones[a];
+            for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; b++) {
+                const aiVertexWeight &w = bone->mWeights[b];
+                if (w.mVertexId < numVertices) {
+                    influences[cursor[w.mVertexId]++] = BoneInfluence(a, w.mWeight + ai_real(0.0));
+                }
+            }
+        }
+    }
+
+    // pack and hash all vertices, in parallel since this is where the time goes
+    static const unsigned int ChunkSize = 4096;
+    std::vector<ai_real> records(static_cast<size_t>(numVertices) * stride);
+    std::vector<uint64_t> hashes(numVertices);
+    ParallelFor((numVertices + ChunkSize - 1) / ChunkSize, [&](unsigned int chunk) {
+        const unsigned int end = std::min(numVertices, (chunk + 1) * ChunkSize);
+        for (unsigned int v = chunk * ChunkSize; v < end; v++) {
+            if (!usedVertices[v]) {
+                continue;
+            }
+            ai_real *record = records.data() + static_cast<size_t>(v) * stride;
+            ai_real *out = packAttributes(pMesh, v, record);
+            for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; a++) {
+                out = packAttributes(pMesh->mAnimMeshes[a], v, out);
+            }
+            ai_assert(out == record + stride);
+
+            uint64_t hash = hashWords(record, stride * sizeof(ai_real), 0xcbf29ce484222325ull);
+            std::sort(influences.begin() + influenceStart[v], influences.begin() + influenceStart[v + 1]);
+            for (unsigned int i = influenceStart[v]; i < influenceStart[v + 1]; i++) {
+                hash = hashWords(&influences[i].first, sizeof(unsigned int), hash);
+                hash = hashWords(&influences[i].second, sizeof(ai_real), hash);
+            }
+            hashes[v] = hash;
+        }
+    });
+
+    const size_t recordSize = stride * sizeof(ai_real);
+    auto isSameVertex = [&](unsigned int lhs, unsigned int rhs) {
+        if (hashes[lhs] != hashes[rhs] ||
+                ::memcmp(&records[static_cast<size_t>(lhs) * stride], &records[static_cast<size_t>(rhs) * stride], recordSize) != 0) {
+            return false;
+        }
+        const unsigned int numInfluences = influenceStart[lhs + 1] - influenceStart[lhs];
+        return numInfluences == influenceStart[rhs + 1] - influenceStart[rhs] &&
+               std::equal(influences.begin() + influenceStart[lhs], influences.begin() + influenceStart[lhs + 1],
+                       influences.begin() + influenceStart[rhs]);
+    };
+
+    // open addressing table of unique vertex indices, at most half full
+    size_t tableSize = 16;
+    while (tableSize < static_cast<size_t>(numVertices) * 2) {
+        tableSize *= 2;
+    }
+    std::vector<unsigned int> table(tableSize, 0xffffffff);
+
+    uniqueSources.reserve(numVertices);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        if (!usedVertices[v]) {
+            continue;
+        }
+        size_t slot = hashes[v] & (tableSize - 1);
+        while (table[slot] != 0xffffffff && !isSameVertex(uniqueSources[table[slot]], v)) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] != 0xffffffff) {
+            replaceIndex[v] = table[slot] | 0x80000000;
+        } else {
+            table[slot] = replaceIndex[v] = static_cast<unsigned int>(uniqueSources.size());
+            uniqueSources.push_back(v);
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Unites identical vertices in the given mesh
 int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
@@ -243,13 +440,14 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     // We should care only about used vertices, not all of them
     // (this can happen due to original file vertices buffer being used by
     // multiple meshes)
-    std::unordered_set<unsigned int> usedVertexIndices;
-    usedVertexIndices.reserve(pMesh->mNumVertices);
+    std::vector<bool> usedVertices(pMesh->mNumVertices, false);
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
     {
         aiFace& face = pMesh->mFaces[a];
         for( unsigned int b = 0; b < face.mNumIndices; b++) {
-            usedVertexIndices.insert(face.mIndices[b]);
+            if (face.mIndices[b] < pMesh->mNumVertices) {
+                usedVertices[face.mIndices[b]] = true;
+            }
         }
     }
 
@@ -265,34 +463,6 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
     std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
-    // float posEpsilonSqr;
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
-
-    // Again, better waste some bytes than a realloc ...
-    std::vector<unsigned int> verticesFound;
-    verticesFound.reserve(10);
-
-    // Run an optimized code path if we don't have multiple UVs or vertex colors.
-    // This should yield false in more than 99% of all imports ...
-    const bool complex = ( pMesh->GetNumColorChannels() > 0 || pMesh->GetNumUVChannels() > 1);
     const bool hasAnimMeshes = pMesh->mNumAnimMeshes > 0;
 
     // We'll never have more vertices afterwards.
@@ -304,69 +474,93 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
-    // Now check each vertex if it brings something new to the table
-    for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
-        if (usedVertexIndices.find(a) == usedVertexIndices.end()) {
-            continue;
+    if (mExactMatch) {
+        // hash all attributes, only bitwise identical vertices are joined
+        std::vector<unsigned int> uniqueSources;
+        FindExactDuplicates(pMesh, usedVertices, replaceIndex, uniqueSources);
+        for (unsigned int source : uniqueSources) {
+            uniqueVertices.emplace_back(pMesh, source);
+            for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                uniqueAnimatedVertices[animMeshIndex].emplace_back(pMesh->mAnimMeshes[animMeshIndex], source);
+            }
         }
+    } else {
+        // check whether we can reuse the spatial index of a previous step
+        SharedSpatialIndex _vertexFinder;
+        const SpatialHashGrid *vertexFinder = &GetSpatialIndex(shared, pMesh, threadPool, _vertexFinder).first;
+
+        // Again, better waste some bytes than a realloc ...
+        std::vector<unsigned int> verticesFound;
+        verticesFound.reserve(10);
+
+        // Run an optimized code path if we don't have multiple UVs or vertex colors.
+        // This should yield false in more than 99% of all imports ...
+        const bool complex = ( pMesh->GetNumColorChannels() > 0 || pMesh->GetNumUVChannels() > 1);
+
+        // Now check each vertex if it brings something new to the table
+        for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
+            if (!usedVertices[a]) {
+                continue;
+            }
 
-        // collect the vertex data
-        Vertex v(pMesh,a);
+            // collect the vertex data
+            Vertex v(pMesh,a);
 
-        // collect all vertices that are close enough to the given position
-        vertexFinder->FindIdenticalPositions( v.position, verticesFound);
-        unsigned int matchIndex = 0xffffffff;
+            // collect all vertices that are close enough to the given position
+            vertexFinder->FindIdenticalPositions( v.position, verticesFound);
+            unsigned int matchIndex = 0xffffffff;
 
-        // check all unique vertices close to the position if this vertex is already present among them
-        for( unsigned int b = 0; b < verticesFound.size(); b++) {
-            const unsigned int vidx = verticesFound[b];
-            const unsigned int uidx = replaceIndex[ vidx];
-            if( uidx & 0x80000000)
-                continue;
+            // check all unique vertices close to the position if this vertex is already present among them
+            for( unsigned int b = 0; b < verticesFound.size(); b++) {
+                const unsigned int vidx = verticesFound[b];
+                const unsigned int uidx = replaceIndex[ vidx];
+                if( uidx & 0x80000000)
+                    continue;
 
-            const Vertex& uv = uniqueVertices[ uidx];
+                const Vertex& uv = uniqueVertices[ uidx];
 
-            if (!areVerticesEqual(v, uv, complex)) {
-                continue;
-            }
+                if (!areVerticesEqual(v, uv, complex)) {
+                    continue;
+                }
 
-            if (hasAnimMeshes) {
-                // If given vertex is animated, then it has to be preserver 1 to 1 (base mesh and animated mesh require same topology)
-                // NOTE: not doing this totaly breaks anim meshes as they don't have their own faces (they use pMesh->mFaces)
-                bool breaksAnimMesh = false;
-                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-                    const Vertex& animatedUV = uniqueAnimatedVertices[animMeshIndex][ uidx];
-                    Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
-                    if (!areVerticesEqual(aniMeshVertex, animatedUV, complex)) {
-                        breaksAnimMesh = true;
-                        break;
+                if (hasAnimMeshes) {
+                    // If given vertex is animated, then it has to be preserver 1 to 1 (base mesh and animated mesh require same topology)
+                    // NOTE: not doing this totaly breaks anim meshes as they don't have their own faces (they use pMesh->mFaces)
+                    bool breaksAnimMesh = false;
+                    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                        const Vertex& animatedUV = uniqueAnimatedVertices[animMeshIndex][ uidx];
+                        Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
+                        if (!areVerticesEqual(aniMeshVertex, animatedUV, complex)) {
+                            breaksAnimMesh = true;
+                            break;
+                        }
+                    }
+                    if (breaksAnimMesh) {
+                        continue;
                     }
                 }
-                if (breaksAnimMesh) {
-                    continue;
-                }
-            }
 
-            // we're still here -> this vertex perfectly matches our given vertex
-            matchIndex = uidx;
-            break;
-        }
+                // we're still here -> this vertex perfectly matches our given vertex
+                matchIndex = uidx;
+                break;
+            }
 
-        // found a replacement vertex among the uniques?
-        if( matchIndex != 0xffffffff)
-        {
-            // store where to found the matching unique vertex
-            replaceIndex[a] = matchIndex | 0x80000000;
-        }
-        else
-        {
-            // no unique vertex matches it up to now -> so add it
-            replaceIndex[a] = (unsigned int)uniqueVertices.size();
-            uniqueVertices.push_back( v);
-            if (hasAnimMeshes) {
-                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-                    Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
-                    uniqueAnimatedVertices[animMeshIndex].push_back(aniMeshVertex);
+            // found a replacement vertex among the uniques?
+            if( matchIndex != 0xffffffff)
+            {
+                // store where to found the matching unique vertex
+                replaceIndex[a] = matchIndex | 0x80000000;
+            }
+            else
+            {
+                // no unique vertex matches it up to now -> so add it
+                replaceIndex[a] = (unsigned int)uniqueVertices.size();
+                uniqueVertices.push_back( v);
+                if (hasAnimMeshes) {
+                    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+                        Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
+                        uniqueAnimatedVertices[animMeshIndex].push_back(aniMeshVertex);
+                    }
                 }
             }
         }
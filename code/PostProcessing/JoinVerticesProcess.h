@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
+#include <vector>
+
 struct aiMesh;
 
 namespace Assimp
@@ -82,12 +84,44 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Unites identical vertices in the given mesh.
      * @param pMesh The mesh to process.
      * @param meshIndex Index of the mesh to process
      */
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
+
+    // -------------------------------------------------------------------
+    /** Enables or disables the exact matching mode,
+     *  see #AI_CONFIG_PP_JIV_EXACT_MATCH. */
+    void SetExactMatch(bool exactMatch) {
+        mExactMatch = exactMatch;
+    }
+
+protected:
+    // -------------------------------------------------------------------
+    /** Finds the used vertices of a mesh which are bitwise identical.
+     * @param pMesh The mesh to process.
+     * @param usedVertices Flags the vertices referenced by a face.
+     * @param replaceIndex Receives the unique vertex each used vertex
+     *   maps to, with the most significant bit set for duplicates.
+     * @param uniqueSources Receives the vertex each unique vertex is
+     *   copied from.
+     */
+    void FindExactDuplicates(const aiMesh* pMesh,
+        const std::vector<bool>& usedVertices,
+        std::vector<unsigned int>& replaceIndex,
+        std::vector<unsigned int>& uniqueSources);
+
+private:
+    bool mExactMatch;
 };
 
 } // end of namespace Assimp
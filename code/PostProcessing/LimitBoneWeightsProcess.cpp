@@ -74,15 +74,21 @@ bool LimitBoneWeightsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_LimitBoneWeights) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int LimitBoneWeightsProcess::GetMutatedMeshAttributes() const
+{
+    return MeshAttr_Bones;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void LimitBoneWeightsProcess::Execute( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("LimitBoneWeightsProcess begin");
 
-    for (unsigned int m = 0; m < pScene->mNumMeshes; ++m) {
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int m) {
         ProcessMesh(pScene->mMeshes[m]);
-    }
+    });
 
     ASSIMP_LOG_DEBUG("LimitBoneWeightsProcess end");
 }
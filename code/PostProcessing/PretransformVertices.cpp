@@ -235,7 +235,7 @@ void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcN
 
 				unsigned int *pi;
 				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
-					pi = f_dst.mIndices = f_src.mIndices;
+					pi = f_dst.mIndices = pcMesh->TakeFaceIndices(f_src);
 
 					// offset all vertex indices
 					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
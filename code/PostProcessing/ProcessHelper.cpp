@@ -142,6 +142,108 @@ ai_real ComputePositionEpsilon(const aiMesh *pMesh) {
     return (maxVec - minVec).Length() * epsilon;
 }
 
+// -------------------------------------------------------------------------------
+void BuildSpatialIndex(const aiMesh *pMesh, ThreadPool *threadPool, SharedSpatialIndex &out) {
+    out.first.SetThreadPool(threadPool);
+    out.first.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
+    out.first.SetThreadPool(nullptr);
+    out.second = ComputePositionEpsilon(pMesh);
+}
+
+// -------------------------------------------------------------------------------
+const SharedSpatialIndex &GetSpatialIndex(SharedPostProcessInfo *shared, const aiMesh *pMesh,
+        ThreadPool *threadPool, SharedSpatialIndex &local) {
+    if (nullptr == shared) {
+        BuildSpatialIndex(pMesh, threadPool, local);
+        return local;
+    }
+    SharedSpatialIndex *index = shared->GetMeshData<SharedSpatialIndex>(pMesh, MeshData_SpatialIndex);
+    if (nullptr == index) {
+        index = new SharedSpatialIndex();
+        BuildSpatialIndex(pMesh, threadPool, *index);
+        index = shared->AddMeshData(pMesh, MeshData_SpatialIndex, index);
+    }
+    return *index;
+}
+
+// -------------------------------------------------------------------------------
+const VertexTriangleAdjacency &GetVertexTriangleAdjacency(SharedPostProcessInfo *shared,
+        const aiMesh *pMesh, std::unique_ptr<VertexTriangleAdjacency> &local) {
+    VertexTriangleAdjacency *adj = nullptr;
+    if (nullptr != shared) {
+        adj = shared->GetMeshData<VertexTriangleAdjacency>(pMesh, MeshData_Adjacency);
+    }
+    if (nullptr == adj) {
+        adj = new VertexTriangleAdjacency(pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, true);
+        if (nullptr != shared) {
+            adj = shared->AddMeshData(pMesh, MeshData_Adjacency, adj);
+        } else {
+            local.reset(adj);
+        }
+    }
+    return *adj;
+}
+
+// -------------------------------------------------------------------------------
+const std::vector<aiVector3D> &GetFaceNormals(SharedPostProcessInfo *shared,
+        const aiMesh *pMesh, std::vector<aiVector3D> &local) {
+    std::vector<aiVector3D> *normals = nullptr;
+    if (nullptr != shared) {
+        normals = shared->GetMeshData<std::vector<aiVector3D>>(pMesh, MeshData_FaceNormals);
+        if (nullptr != normals) {
+            return *normals;
+        }
+        normals = new std::vector<aiVector3D>();
+    } else {
+        normals = &local;
+    }
+
+    const ai_real qnan = std::numeric_limits<ai_real>::quiet_NaN();
+    normals->resize(pMesh->mNumFaces);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace &face = pMesh->mFaces[a];
+        if (face.mNumIndices < 3) {
+            // either a point or a line -> no normal vector
+            (*normals)[a] = aiVector3D(qnan);
+            continue;
+        }
+        const aiVector3D &v1 = pMesh->mVertices[face.mIndices[0]];
+        const aiVector3D &v2 = pMesh->mVertices[face.mIndices[1]];
+        const aiVector3D &v3 = pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
+        (*normals)[a] = ((v2 - v1) ^ (v3 - v1)).NormalizeSafe();
+    }
+
+    if (nullptr != shared) {
+        normals = shared->AddMeshData(pMesh, MeshData_FaceNormals, normals);
+    }
+    return *normals;
+}
+
+// -------------------------------------------------------------------------------
+uint64_t GetFaceHash(SharedPostProcessInfo *shared, const aiMesh *pMesh) {
+    if (nullptr != shared) {
+        const uint64_t *cached = shared->GetMeshData<uint64_t>(pMesh, MeshData_FaceHash);
+        if (nullptr != cached) {
+            return *cached;
+        }
+    }
+
+    // FNV-1a over the face sizes and indices
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace &face = pMesh->mFaces[i];
+        hash = (hash ^ face.mNumIndices) * 0x100000001b3ull;
+        for (unsigned int n = 0; n < face.mNumIndices; ++n) {
+            hash = (hash ^ face.mIndices[n]) * 0x100000001b3ull;
+        }
+    }
+
+    if (nullptr != shared) {
+        shared->AddMeshData(pMesh, MeshData_FaceHash, new uint64_t(hash));
+    }
+    return hash;
+}
+
 // -------------------------------------------------------------------------------
 ai_real ComputePositionEpsilon(const aiMesh *const *pMeshes, size_t num) {
     ai_assert(nullptr != pMeshes);
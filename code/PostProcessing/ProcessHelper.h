@@ -51,10 +51,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 
 #include "Common/BaseProcess.h"
+#include "Common/SpatialHashGrid.h"
+#include "Common/VertexTriangleAdjacency.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/SpatialSort.h>
 
 #include <list>
+#include <memory>
 
 // -------------------------------------------------------------------------------
 // Some extensions to std namespace. Mainly std::min and std::max for all
@@ -332,7 +335,37 @@ const char *MappingTypeToString(aiTextureMapping in);
 aiMesh *MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
 // -------------------------------------------------------------------------------
-// Utility postprocess step to share the spatial sort tree between
+// Spatial index of a mesh and its position epsilon, cached as MeshData_SpatialIndex
+typedef std::pair<SpatialHashGrid, ai_real> SharedSpatialIndex;
+
+// -------------------------------------------------------------------------------
+// Build the spatial index of a mesh and its position epsilon
+void BuildSpatialIndex(const aiMesh *pMesh, ThreadPool *threadPool, SharedSpatialIndex &out);
+
+// -------------------------------------------------------------------------------
+// Get the spatial index of a mesh from the shared cache. If it isn't cached it
+// is built and added to the cache, or built into local if shared is nullptr.
+ASSIMP_API const SharedSpatialIndex &GetSpatialIndex(SharedPostProcessInfo *shared, const aiMesh *pMesh,
+        ThreadPool *threadPool, SharedSpatialIndex &local);
+
+// -------------------------------------------------------------------------------
+// Get the vertex-triangle adjacency of a mesh from the shared cache, see
+// GetSpatialIndex(). The live triangle counts must not be modified.
+ASSIMP_API const VertexTriangleAdjacency &GetVertexTriangleAdjacency(SharedPostProcessInfo *shared,
+        const aiMesh *pMesh, std::unique_ptr<VertexTriangleAdjacency> &local);
+
+// -------------------------------------------------------------------------------
+// Get the normalized normals of all faces of a mesh from the shared cache, see
+// GetSpatialIndex(). Points and lines get a qNaN normal.
+ASSIMP_API const std::vector<aiVector3D> &GetFaceNormals(SharedPostProcessInfo *shared,
+        const aiMesh *pMesh, std::vector<aiVector3D> &local);
+
+// -------------------------------------------------------------------------------
+// Get a hash of the index buffer of a mesh, cached if shared isn't nullptr
+ASSIMP_API uint64_t GetFaceHash(SharedPostProcessInfo *shared, const aiMesh *pMesh);
+
+// -------------------------------------------------------------------------------
+// Utility postprocess step to share the spatial index between
 // all steps which use it to speedup its computations.
 class ComputeSpatialSortProcess : public BaseProcess {
     bool IsActive(unsigned int pFlags) const {
@@ -341,20 +374,20 @@ class ComputeSpatialSortProcess : public BaseProcess {
     }
 
     void Execute(aiScene *pScene) {
-        typedef std::pair<SpatialSort, ai_real> _Type;
         ASSIMP_LOG_DEBUG("Generate spatially-sorted vertex cache");
 
-        std::vector<_Type> *p = new std::vector<_Type>(pScene->mNumMeshes);
-        std::vector<_Type>::iterator it = p->begin();
-
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
-            aiMesh *mesh = pScene->mMeshes[i];
-            _Type &blubb = *it;
-            blubb.first.Fill(mesh->mVertices, mesh->mNumVertices, sizeof(aiVector3D));
-            blubb.second = ComputePositionEpsilon(mesh);
-        }
+        ParallelFor(pScene->mNumMeshes, [this, pScene](unsigned int i) {
+            const aiMesh *mesh = pScene->mMeshes[i];
+            if (nullptr == shared->GetMeshData<SharedSpatialIndex>(mesh, MeshData_SpatialIndex)) {
+                SharedSpatialIndex *blubb = new SharedSpatialIndex();
+                BuildSpatialIndex(mesh, threadPool, *blubb);
+                shared->AddMeshData(mesh, MeshData_SpatialIndex, blubb);
+            }
+        });
+    }
 
-        shared->AddProperty(AI_SPP_SPATIAL_SORT, p);
+    unsigned int GetMutatedMeshAttributes() const {
+        return 0;
     }
 };
 
@@ -367,7 +400,11 @@ class DestroySpatialSortProcess : public BaseProcess {
     }
 
     void Execute(aiScene * /*pScene*/) {
-        shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
+        shared->RemoveMeshData(MeshData_SpatialIndex);
+    }
+
+    unsigned int GetMutatedMeshAttributes() const {
+        return 0;
     }
 };
 
@@ -75,6 +75,12 @@ bool RemoveRedundantMatsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_RemoveRedundantMaterials) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int RemoveRedundantMatsProcess::GetMutatedMeshAttributes() const
+{
+    return 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup import properties
 void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp)
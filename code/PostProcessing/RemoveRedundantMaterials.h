@@ -69,6 +69,10 @@ public:
     // Check whether step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    // Mesh attributes modified by the step, none
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     // Execute step on a given scene
     void Execute( aiScene* pScene);
@@ -68,6 +68,10 @@ bool ScaleProcess::IsActive( unsigned int pFlags ) const {
     return ( pFlags & aiProcess_GlobalScale ) != 0;
 }
 
+unsigned int ScaleProcess::GetMutatedMeshAttributes() const {
+    return MeshAttr_Positions | MeshAttr_Bones;
+}
+
 void ScaleProcess::SetupProperties( const Importer* pImp ) {
     // User scaling
     mScale = pImp->GetPropertyFloat( AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, 1.0f );
@@ -0,0 +1,635 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the mesh simplification post-processing step.
+ *
+ * Edges are collapsed into one of their vertices (half-edge collapse) in the order of the
+ * quadric error of the result, as described by Garland and Heckbert in "Surface Simplification
+ * Using Quadric Error Metrics". The collapses are done in passes: each pass sorts all candidate
+ * edges and collapses as many as possible without touching the same faces twice.
+ */
+
+#ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+
+#include "PostProcessing/SimplifyProcess.h"
+#include "PostProcessing/ProcessHelper.h"
+
+#include <assimp/SceneCombiner.h>
+#include <assimp/StringUtils.h>
+#include <assimp/commonMetaData.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Sum of the squared distances of a point to a set of planes, as a symmetric 4x4 matrix
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0, c = 0;
+
+    // adds the plane n*p + d = 0, n must be normalized
+    void AddPlane(const aiVector3D &n, double d) {
+        a00 += n.x * n.x;
+        a01 += n.x * n.y;
+        a02 += n.x * n.z;
+        a11 += n.y * n.y;
+        a12 += n.y * n.z;
+        a22 += n.z * n.z;
+        b0 += n.x * d;
+        b1 += n.y * d;
+        b2 += n.z * d;
+        c += d * d;
+    }
+
+    void Add(const Quadric &q) {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a11 += q.a11;
+        a12 += q.a12;
+        a22 += q.a22;
+        b0 += q.b0;
+        b1 += q.b1;
+        b2 += q.b2;
+        c += q.c;
+    }
+
+    double Error(const aiVector3D &p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        const double r = x * (a00 * x + a01 * y + a02 * z) +
+                         y * (a01 * x + a11 * y + a12 * z) +
+                         z * (a02 * x + a12 * y + a22 * z) +
+                         2 * (b0 * x + b1 * y + b2 * z) + c;
+        return r > 0 ? r : 0;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// A collapse of vertex from into vertex to
+struct Collapse {
+    unsigned int from, to;
+    double error;
+};
+
+// ------------------------------------------------------------------------------------------------
+inline aiVector3D FaceNormal(const aiVector3D &p0, const aiVector3D &p1, const aiVector3D &p2) {
+    return (p1 - p0) ^ (p2 - p0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// True if two vertices of a mesh or anim mesh have the same attributes, the position aside
+template <class XMesh>
+bool SameAttributes(const XMesh *pMesh, unsigned int a, unsigned int b) {
+    if ((pMesh->mNormals && pMesh->mNormals[a] != pMesh->mNormals[b]) ||
+            (pMesh->mTangents && pMesh->mTangents[a] != pMesh->mTangents[b]) ||
+            (pMesh->mBitangents && pMesh->mBitangents[a] != pMesh->mBitangents[b])) {
+        return false;
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        if (pMesh->mColors[c] && pMesh->mColors[c][a] != pMesh->mColors[c][b]) {
+            return false;
+        }
+    }
+    for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+        if (pMesh->mTextureCoords[t] && pMesh->mTextureCoords[t][a] != pMesh->mTextureCoords[t][b]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Welds the vertices which only duplicate another one in the indices, and flags the vertices which
+// must not move: those of open or non-manifold edges, which are also the material borders, and
+// those at positions where the attributes are split (UV or normal seams)
+std::vector<bool> FindLockedVertices(const aiMesh *pMesh, std::vector<unsigned int> &indices) {
+    const unsigned int numVertices = pMesh->mNumVertices;
+    const aiVector3D *pos = pMesh->mVertices;
+
+    // the bone weights of each vertex, in bone order
+    std::vector<std::vector<std::pair<unsigned int, ai_real>>> weights(pMesh->mNumBones ? numVertices : 0);
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        const aiBone *pBone = pMesh->mBones[a];
+        for (unsigned int b = 0; pBone->mWeights && b < pBone->mNumWeights; ++b) {
+            const aiVertexWeight &w = pBone->mWeights[b];
+            if (w.mVertexId < numVertices) {
+                weights[w.mVertexId].emplace_back(a, w.mWeight);
+            }
+        }
+    }
+    const auto sameVertex = [&](unsigned int a, unsigned int b) {
+        if (!SameAttributes(pMesh, a, b) || (!weights.empty() && weights[a] != weights[b])) {
+            return false;
+        }
+        for (unsigned int m = 0; m < pMesh->mNumAnimMeshes; ++m) {
+            const aiAnimMesh *anim = pMesh->mAnimMeshes[m];
+            if (anim->mNumVertices == numVertices &&
+                    ((anim->mVertices && anim->mVertices[a] != anim->mVertices[b]) || !SameAttributes(anim, a, b))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // vertices with the same position get the same id, a position is a seam if its vertices
+    // still differ once the duplicates are welded
+    std::vector<unsigned int> order(numVertices);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [pos](unsigned int lhs, unsigned int rhs) {
+        return pos[lhs] < pos[rhs];
+    });
+    std::vector<unsigned int> positionId(numVertices), welded(numVertices);
+    std::vector<bool> seam(numVertices, false);
+    std::vector<unsigned int> distinct;
+    for (unsigned int begin = 0, end = 0; begin < numVertices; begin = end) {
+        distinct.clear();
+        for (end = begin; end < numVertices && pos[order[end]] == pos[order[begin]]; ++end) {
+            const unsigned int v = order[end];
+            positionId[v] = order[begin];
+            welded[v] = v;
+            for (unsigned int other : distinct) {
+                if (sameVertex(v, other)) {
+                    welded[v] = other;
+                    break;
+                }
+            }
+            if (welded[v] == v) {
+                distinct.push_back(v);
+            }
+        }
+        seam[order[begin]] = distinct.size() > 1;
+    }
+    for (unsigned int &v : indices) {
+        v = welded[v];
+    }
+
+    // count the faces of each edge between positions
+    std::unordered_map<uint64_t, unsigned int> edgeFaces;
+    edgeFaces.reserve(indices.size());
+    for (size_t f = 0; f < indices.size(); f += 3) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const uint64_t a = positionId[indices[f + k]], b = positionId[indices[f + (k + 1) % 3]];
+            ++edgeFaces[std::min(a, b) << 32 | std::max(a, b)];
+        }
+    }
+    for (const auto &edge : edgeFaces) {
+        if (2 != edge.second) {
+            seam[edge.first >> 32] = seam[edge.first & 0xffffffff] = true;
+        }
+    }
+    std::vector<bool> locked(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        locked[v] = seam[positionId[v]];
+    }
+    return locked;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sets name to base followed by the level, base is shortened if both don't fit
+void SetLodName(aiString &name, const aiString &base, unsigned int level) {
+    char suffix[16];
+    const int suffixLength = ai_snprintf(suffix, sizeof(suffix), "_LOD%u", level);
+    const int baseLength = std::min(static_cast<int>(base.length), static_cast<int>(MAXLEN) - 1 - suffixLength);
+    name.length = static_cast<ai_uint32>(ai_snprintf(name.data, MAXLEN, "%.*s%s", baseLength, base.data, suffix));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Index of the bone with the largest weight per vertex, -1 for unskinned vertices
+std::vector<int> FindDominantBones(const aiMesh *pMesh) {
+    std::vector<int> bone(pMesh->mNumVertices, -1);
+    std::vector<ai_real> weight(pMesh->mNumVertices, 0);
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        const aiBone *pBone = pMesh->mBones[a];
+        for (unsigned int b = 0; pBone->mWeights && b < pBone->mNumWeights; ++b) {
+            const aiVertexWeight &w = pBone->mWeights[b];
+            if (w.mVertexId < pMesh->mNumVertices && w.mWeight > weight[w.mVertexId]) {
+                weight[w.mVertexId] = w.mWeight;
+                bone[w.mVertexId] = static_cast<int>(a);
+            }
+        }
+    }
+    return bone;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void CompactStream(T *&data, const std::vector<unsigned int> &kept) {
+    if (nullptr == data) {
+        return;
+    }
+    T *compacted = new T[kept.size()];
+    for (size_t v = 0; v < kept.size(); ++v) {
+        compacted[v] = data[kept[v]];
+    }
+    delete[] data;
+    data = compacted;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Keeps only the given vertices of a mesh or anim mesh
+template <class XMesh>
+void CompactVertices(XMesh *pMesh, const std::vector<unsigned int> &kept) {
+    CompactStream(pMesh->mVertices, kept);
+    CompactStream(pMesh->mNormals, kept);
+    CompactStream(pMesh->mTangents, kept);
+    CompactStream(pMesh->mBitangents, kept);
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        CompactStream(pMesh->mColors[a], kept);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        CompactStream(pMesh->mTextureCoords[a], kept);
+    }
+    pMesh->mNumVertices = static_cast<unsigned int>(kept.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replaces the faces of the mesh and drops all vertices they don't use
+void WriteBack(aiMesh *pMesh, const std::vector<unsigned int> &indices) {
+    std::vector<unsigned int> remap(pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> kept;
+    for (unsigned int v : indices) {
+        if (UINT_MAX == remap[v]) {
+            remap[v] = 0;
+        }
+    }
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        if (UINT_MAX != remap[v]) {
+            remap[v] = static_cast<unsigned int>(kept.size());
+            kept.push_back(v);
+        }
+    }
+
+    // keep the index storage mode of the mesh
+    const bool contiguous = nullptr != pMesh->mIndexBuffer;
+    const unsigned int numFaces = static_cast<unsigned int>(indices.size() / 3);
+    pMesh->DeleteFaces();
+    if (contiguous) {
+        unsigned int *out = pMesh->AllocateContiguousFaces(numFaces, 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            out[i] = remap[indices[i]];
+        }
+    } else {
+        pMesh->mNumFaces = numFaces;
+        pMesh->mFaces = new aiFace[numFaces];
+        for (unsigned int f = 0; f < numFaces; ++f) {
+            aiFace &face = pMesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                face.mIndices[k] = remap[indices[f * 3 + k]];
+            }
+        }
+    }
+
+    for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        aiBone *bone = pMesh->mBones[a];
+        unsigned int numWeights = 0;
+        for (unsigned int b = 0; bone->mWeights && b < bone->mNumWeights; ++b) {
+            const aiVertexWeight &w = bone->mWeights[b];
+            if (w.mVertexId < pMesh->mNumVertices && UINT_MAX != remap[w.mVertexId]) {
+                bone->mWeights[numWeights++] = aiVertexWeight(remap[w.mVertexId], w.mWeight);
+            }
+        }
+        bone->mNumWeights = numWeights;
+    }
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        if (pMesh->mAnimMeshes[a]->mNumVertices == pMesh->mNumVertices) {
+            CompactVertices(pMesh->mAnimMeshes[a], kept);
+        }
+    }
+    CompactVertices(pMesh, kept);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SimplifyProcess::SimplifyProcess() :
+        mEnabled(false),
+        mTargetRatio(0.5f),
+        mTargetError(0.01f),
+        mLodCount(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SimplifyProcess::~SimplifyProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SimplifyProcess::IsActive(unsigned int /*pFlags*/) const {
+    // there is no flag left for this step, AI_CONFIG_PP_SIMPLIFY enables it
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SimplifyProcess::SetupProperties(const Importer *pImp) {
+    mEnabled = pImp->GetPropertyBool(AI_CONFIG_PP_SIMPLIFY, false);
+    mLodCount = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_PP_SIMPLIFY_LOD_COUNT, 0));
+    mTargetRatio = pImp->GetPropertyFloat(AI_CONFIG_PP_SIMPLIFY_TARGET_RATIO, 0.5f);
+    mTargetError = pImp->GetPropertyFloat(AI_CONFIG_PP_SIMPLIFY_TARGET_ERROR, 0.01f);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SimplifyProcess::Execute(aiScene *pScene) {
+    if (!mEnabled || mTargetRatio >= 1.f || mTargetRatio < 0.f) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("SimplifyProcess begin");
+
+    // simplify each mesh, or each level from the previous one
+    const unsigned int numLevels = std::max(1u, mLodCount);
+    std::vector<std::vector<aiMesh *>> levels(pScene->mNumMeshes);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
+        aiMesh *source = pScene->mMeshes[a];
+        if (source->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || !source->HasPositions()) {
+            return;
+        }
+        aiVector3D min, max;
+        ArrayBounds(source->mVertices, source->mNumVertices, min, max);
+        const ai_real maxError = mTargetError * (max - min).Length();
+        double targetFaces = source->mNumFaces;
+        for (unsigned int level = 1; level <= numLevels; ++level) {
+            aiMesh *mesh = source;
+            if (mLodCount > 0) {
+                SceneCombiner::Copy(&mesh, source);
+                SetLodName(mesh->mName, pScene->mMeshes[a]->mName, level);
+            }
+
+            const unsigned int numFaces = source->mNumFaces;
+            targetFaces *= mTargetRatio;
+            SimplifyMesh(mesh, static_cast<unsigned int>(targetFaces), maxError);
+            if (mesh == pScene->mMeshes[a]) {
+                break;
+            }
+            if (mesh->mNumFaces >= numFaces) {
+                // the previous level is as simple as it gets
+                delete mesh;
+                break;
+            }
+            levels[a].push_back(mesh);
+            source = mesh;
+        }
+    });
+
+    if (0 == mLodCount) {
+        ASSIMP_LOG_DEBUG("SimplifyProcess finished");
+        return;
+    }
+
+    // append the levels to the meshes of the scene
+    std::vector<std::vector<unsigned int>> levelIndices(pScene->mNumMeshes);
+    std::vector<aiMesh *> meshes(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes);
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        for (aiMesh *mesh : levels[a]) {
+            levelIndices[a].push_back(static_cast<unsigned int>(meshes.size()));
+            meshes.push_back(mesh);
+        }
+    }
+    const unsigned int numLodMeshes = static_cast<unsigned int>(meshes.size()) - pScene->mNumMeshes;
+    if (0 == numLodMeshes) {
+        ASSIMP_LOG_DEBUG("SimplifyProcess finished, no levels of detail generated");
+        return;
+    }
+    delete[] pScene->mMeshes;
+    pScene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+    pScene->mMeshes = new aiMesh *[pScene->mNumMeshes];
+    std::copy(meshes.begin(), meshes.end(), pScene->mMeshes);
+
+    // and give each node referencing them one child node per level
+    std::vector<aiNode *> nodes(1, pScene->mRootNode);
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        nodes.insert(nodes.end(), nodes[n]->mChildren, nodes[n]->mChildren + nodes[n]->mNumChildren);
+    }
+    for (aiNode *node : nodes) {
+        std::vector<aiNode *> children;
+        for (unsigned int level = 1; level <= mLodCount; ++level) {
+            std::vector<unsigned int> lodMeshes;
+            for (unsigned int m = 0; m < node->mNumMeshes; ++m) {
+                const std::vector<unsigned int> &chain = levelIndices[node->mMeshes[m]];
+                if (chain.size() >= level) {
+                    lodMeshes.push_back(chain[level - 1]);
+                }
+            }
+            if (lodMeshes.empty()) {
+                break;
+            }
+
+            aiNode *child = new aiNode();
+            SetLodName(child->mName, node->mName, level);
+            child->mParent = node;
+            child->mNumMeshes = static_cast<unsigned int>(lodMeshes.size());
+            child->mMeshes = new unsigned int[child->mNumMeshes];
+            std::copy(lodMeshes.begin(), lodMeshes.end(), child->mMeshes);
+            child->mMetaData = aiMetadata::Alloc(1);
+            child->mMetaData->Set(0, AI_METADATA_LOD_LEVEL, static_cast<int32_t>(level));
+            children.push_back(child);
+        }
+        if (!children.empty()) {
+            node->addChildren(static_cast<unsigned int>(children.size()), children.data());
+        }
+    }
+
+    ASSIMP_LOG_INFO("SimplifyProcess finished. Generated ", numLodMeshes, " level of detail meshes");
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_real SimplifyProcess::SimplifyMesh(aiMesh *pMesh, unsigned int targetFaces, ai_real maxError) {
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || !pMesh->HasPositions() || pMesh->mNumFaces <= targetFaces) {
+        return 0;
+    }
+
+    // neither the ordering of the positions nor the quadrics work with NaN or infinity
+    const aiVector3D *const begin = pMesh->mVertices, *const end = begin + pMesh->mNumVertices;
+    if (end != std::find_if(begin, end, [](const aiVector3D &p) {
+            return !std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z);
+        })) {
+        ASSIMP_LOG_WARN("SimplifyProcess: mesh \"", pMesh->mName.C_Str(), "\" has non-finite positions, it is not simplified");
+        return 0;
+    }
+
+    const unsigned int numVertices = pMesh->mNumVertices;
+    const aiVector3D *pos = pMesh->mVertices;
+    std::vector<unsigned int> indices;
+    indices.reserve(pMesh->mNumFaces * 3);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        indices.insert(indices.end(), pMesh->mFaces[f].mIndices, pMesh->mFaces[f].mIndices + 3);
+    }
+
+    const std::vector<bool> locked = FindLockedVertices(pMesh, indices);
+    const std::vector<int> dominantBone = FindDominantBones(pMesh);
+
+    // the error quadric of each vertex starts with the planes of its faces
+    std::vector<Quadric> quadrics(numVertices);
+    for (size_t f = 0; f < indices.size(); f += 3) {
+        aiVector3D n = FaceNormal(pos[indices[f]], pos[indices[f + 1]], pos[indices[f + 2]]);
+        const ai_real length = n.Length();
+        if (length > 0) {
+            n /= length;
+            const double d = -(n * pos[indices[f]]);
+            for (unsigned int k = 0; k < 3; ++k) {
+                quadrics[indices[f + k]].AddPlane(n, d);
+            }
+        }
+    }
+
+    const double maxErrorSq = static_cast<double>(maxError) * maxError;
+    double resultError = 0;
+    std::vector<unsigned int> faceStart(numVertices + 1), faceList, collapseTo(numVertices);
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched;
+    size_t numFaces = indices.size() / 3;
+    while (numFaces > targetFaces) {
+        // faces per vertex
+        std::fill(faceStart.begin(), faceStart.end(), 0);
+        for (unsigned int v : indices) {
+            ++faceStart[v + 1];
+        }
+        std::partial_sum(faceStart.begin(), faceStart.end(), faceStart.begin());
+        faceList.resize(indices.size());
+        {
+            std::vector<unsigned int> cursor(faceStart.begin(), faceStart.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) {
+                faceList[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+            }
+        }
+
+        // the cheaper direction of each edge that may collapse, interior edges are seen from both sides
+        collapses.clear();
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const unsigned int a = indices[i], b = indices[i - i % 3 + (i + 1) % 3];
+            if (a >= b || dominantBone[a] != dominantBone[b]) {
+                continue;
+            }
+            Quadric q = quadrics[a];
+            q.Add(quadrics[b]);
+            Collapse c = { a, b, locked[a] ? HUGE_VAL : q.Error(pos[b]) };
+            if (!locked[b] && q.Error(pos[a]) < c.error) {
+                c.from = b;
+                c.to = a;
+                c.error = q.Error(pos[a]);
+            }
+            if (c.error <= maxErrorSq) {
+                collapses.push_back(c);
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse &lhs, const Collapse &rhs) {
+            return lhs.error < rhs.error || (lhs.error == rhs.error && (lhs.from < rhs.from || (lhs.from == rhs.from && lhs.to < rhs.to)));
+        });
+
+        // collapse greedily, the faces around a collapsed vertex are left alone for the rest of the pass
+        std::iota(collapseTo.begin(), collapseTo.end(), 0);
+        touched.assign(numVertices, false);
+        size_t removed = 0;
+        for (const Collapse &c : collapses) {
+            if (numFaces - removed <= targetFaces) {
+                break;
+            }
+            if (touched[c.from] || touched[c.to]) {
+                continue;
+            }
+
+            // reject collapses which flip a face
+            bool flips = false;
+            unsigned int degenerate = 0;
+            for (unsigned int i = faceStart[c.from]; i < faceStart[c.from + 1] && !flips; ++i) {
+                const unsigned int *face = &indices[faceList[i] * 3];
+                if (face[0] == c.to || face[1] == c.to || face[2] == c.to) {
+                    ++degenerate;
+                    continue;
+                }
+                aiVector3D p[3] = { pos[face[0]], pos[face[1]], pos[face[2]] };
+                const aiVector3D before = FaceNormal(p[0], p[1], p[2]);
+                for (unsigned int k = 0; k < 3; ++k) {
+                    if (face[k] == c.from) {
+                        p[k] = pos[c.to];
+                    }
+                }
+                flips = before * FaceNormal(p[0], p[1], p[2]) <= 0;
+            }
+            if (flips) {
+                continue;
+            }
+
+            collapseTo[c.from] = c.to;
+            quadrics[c.to].Add(quadrics[c.from]);
+            resultError = std::max(resultError, c.error);
+            removed += degenerate;
+            touched[c.to] = true;
+            for (unsigned int i = faceStart[c.from]; i < faceStart[c.from + 1]; ++i) {
+                const unsigned int *face = &indices[faceList[i] * 3];
+                touched[face[0]] = touched[face[1]] = touched[face[2]] = true;
+            }
+        }
+        if (0 == removed) {
+            break;
+        }
+
+        // apply the collapses and drop the faces which became degenerate
+        size_t out = 0;
+        for (size_t f = 0; f < indices.size(); f += 3) {
+            const unsigned int a = collapseTo[indices[f]], b = collapseTo[indices[f + 1]], c = collapseTo[indices[f + 2]];
+            if (a != b && b != c && a != c) {
+                indices[out++] = a;
+                indices[out++] = b;
+                indices[out++] = c;
+            }
+        }
+        indices.resize(out);
+        numFaces = out / 3;
+    }
+
+    WriteBack(pMesh, indices);
+    return static_cast<ai_real>(std::sqrt(resultError));
+}
+
+#endif // !! ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
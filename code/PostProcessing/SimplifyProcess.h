@@ -0,0 +1,102 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to simplify meshes and to generate
+ *        chains of levels of detail.
+ */
+
+#pragma once
+
+#ifndef AI_SIMPLIFYPROCESS_H_INC
+#define AI_SIMPLIFYPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/types.h>
+
+struct aiMesh;
+
+namespace Assimp {
+
+/** Post-processing process to reduce the number of triangles of all meshes by
+ *  collapsing edges in the order of their quadric error. Open borders, which
+ *  are also the material borders, and vertices split for UV or normal seams are
+ *  kept in place, as are the attributes and bone weights of all remaining
+ *  vertices.
+ *
+ *  The step has no aiPostProcessSteps flag, it is enabled by #AI_CONFIG_PP_SIMPLIFY
+ *  and then runs whenever post-processing is applied.
+ */
+class ASSIMP_API SimplifyProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    SimplifyProcess();
+    /// The class destructor.
+    ~SimplifyProcess();
+    /// Will always return true, the step is enabled by its configuration.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Reads the targets from the importer configuration.
+    void SetupProperties(const Importer *pImp) override;
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    /// @brief  Simplifies a triangle mesh in place.
+    /// @param  pMesh        The mesh, meshes with other primitives or non-finite
+    ///                      positions are left alone.
+    /// @param  targetFaces  Number of faces to stop at.
+    /// @param  maxError     Largest allowed displacement of the surface, absolute.
+    /// @return The error of the simplified mesh.
+    static ai_real SimplifyMesh(aiMesh *pMesh, unsigned int targetFaces, ai_real maxError);
+
+private:
+    bool mEnabled;
+    float mTargetRatio;
+    float mTargetError;
+    unsigned int mLodCount;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_SIMPLIFY_PROCESS
+
+#endif // AI_SIMPLIFYPROCESS_H_INC
@@ -301,10 +301,10 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                 }
 
                 outFaces->mNumIndices = in.mNumIndices;
-                outFaces->mIndices = in.mIndices;
+                outFaces->mIndices = mesh->TakeFaceIndices(in);
 
                 for (unsigned int q = 0; q < in.mNumIndices; ++q) {
-                    unsigned int idx = in.mIndices[q];
+                    unsigned int idx = outFaces->mIndices[q];
 
                     // process all bones of this index
                     if (avw) {
@@ -359,10 +359,9 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                     if (pp == mesh->mNumAnimMeshes)
                         amIdx++;
 
-                    in.mIndices[q] = outIdx++;
+                    outFaces->mIndices[q] = outIdx++;
                 }
 
-                in.mIndices = nullptr;
                 ++outFaces;
             }
             ai_assert(outFaces == out->mFaces + out->mNumFaces);
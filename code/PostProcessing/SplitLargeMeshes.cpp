@@ -48,11 +48,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
 
+#include <algorithm>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle() {
     LIMIT = AI_SLM_DEFAULT_MAX_TRIANGLES;
+    SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -103,6 +106,7 @@ void SplitLargeMeshesProcess_Triangle::Execute( aiScene* pScene) {
 void SplitLargeMeshesProcess_Triangle::SetupProperties( const Importer* pImp) {
     // get the current value of the split property
     this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,AI_SLM_DEFAULT_MAX_TRIANGLES);
+    this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -141,7 +145,10 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
         unsigned int a,
         aiMesh* pMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
-    if (pMesh->mNumFaces > SplitLargeMeshesProcess_Triangle::LIMIT) {
+    if (pMesh->mNumFaces > SplitLargeMeshesProcess_Triangle::LIMIT && SPATIAL) {
+        ASSIMP_LOG_INFO("Mesh exceeds the triangle limit. It will be split spatially ...");
+        SplitMeshSpatially(a, pMesh, LIMIT, 0xffffffff, true, avList);
+    } else if (pMesh->mNumFaces > SplitLargeMeshesProcess_Triangle::LIMIT) {
         ASSIMP_LOG_INFO("Mesh exceeds the triangle limit. It will be split ...");
 
         // we need to split this mesh into sub meshes
@@ -326,9 +333,313 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Split a mesh into spatially coherent chunks
+void SplitLargeMeshesProcess_Triangle::SplitMeshSpatially(
+        unsigned int a,
+        aiMesh* pMesh,
+        unsigned int maxFaces,
+        unsigned int maxVertices,
+        bool verbose,
+        std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
+    typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
+
+    // a chunk must be able to hold at least a single face
+    maxFaces = std::max(maxFaces, 1u);
+
+    // compute the centroid of all faces
+    std::vector<aiVector3D> avCentroids(pMesh->mNumFaces);
+    if (pMesh->HasPositions()) {
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            const aiFace& face = pMesh->mFaces[i];
+            aiVector3D vCenter;
+            for (unsigned int v = 0; v < face.mNumIndices; ++v) {
+                vCenter += pMesh->mVertices[face.mIndices[v]];
+            }
+            if (face.mNumIndices) {
+                vCenter /= (ai_real)face.mNumIndices;
+            }
+            avCentroids[i] = vCenter;
+        }
+    }
+
+    std::vector<unsigned int> aiFaces(pMesh->mNumFaces);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        aiFaces[i] = i;
+    }
+
+    // marks the vertices referenced by the chunk being tested or built
+    std::vector<unsigned int> aiVertexMap(pMesh->mNumVertices, 0xffffffff);
+    std::vector<unsigned int> aiChunkVertices;
+
+    // partition the faces along a median-split kd tree. Ranges are processed
+    // depth-first and left-to-right so neighbouring chunks stay adjacent.
+    std::vector<std::pair<unsigned int, unsigned int> > aiRanges;
+    std::vector<std::pair<unsigned int, unsigned int> > aiStack;
+    aiStack.push_back(std::make_pair(0u, pMesh->mNumFaces));
+    while (!aiStack.empty()) {
+        const std::pair<unsigned int, unsigned int> range = aiStack.back();
+        aiStack.pop_back();
+
+        const unsigned int iNumFaces = range.second - range.first;
+        bool bFits = iNumFaces <= maxFaces;
+        if (bFits && maxVertices != 0xffffffff) {
+            // count the vertices the chunk would need
+            unsigned int iNumVertices = 0;
+            aiChunkVertices.clear();
+            for (unsigned int i = range.first; i < range.second && iNumVertices <= maxVertices; ++i) {
+                const aiFace& face = pMesh->mFaces[aiFaces[i]];
+                if (verbose) {
+                    iNumVertices += face.mNumIndices;
+                    continue;
+                }
+                for (unsigned int v = 0; v < face.mNumIndices; ++v) {
+                    if (0xffffffff == aiVertexMap[face.mIndices[v]]) {
+                        aiVertexMap[face.mIndices[v]] = 0;
+                        aiChunkVertices.push_back(face.mIndices[v]);
+                        ++iNumVertices;
+                    }
+                }
+            }
+            for (unsigned int iIndex : aiChunkVertices) {
+                aiVertexMap[iIndex] = 0xffffffff;
+            }
+            bFits = iNumVertices <= maxVertices;
+        }
+
+        // a single face can't be split any further
+        if (bFits || iNumFaces == 1) {
+            aiRanges.push_back(range);
+            continue;
+        }
+
+        // split at the median centroid along the longest axis
+        aiVector3D vMin = avCentroids[aiFaces[range.first]], vMax = vMin;
+        for (unsigned int i = range.first + 1; i < range.second; ++i) {
+            const aiVector3D& c = avCentroids[aiFaces[i]];
+            vMin.x = std::min(vMin.x, c.x); vMax.x = std::max(vMax.x, c.x);
+            vMin.y = std::min(vMin.y, c.y); vMax.y = std::max(vMax.y, c.y);
+            vMin.z = std::min(vMin.z, c.z); vMax.z = std::max(vMax.z, c.z);
+        }
+        const aiVector3D vExtent = vMax - vMin;
+        unsigned int iAxis = 0;
+        if (vExtent.y > vExtent.x) {
+            iAxis = 1;
+        }
+        if (vExtent.z > vExtent[iAxis]) {
+            iAxis = 2;
+        }
+
+        const unsigned int iMid = range.first + iNumFaces / 2;
+        std::nth_element(aiFaces.begin() + range.first, aiFaces.begin() + iMid, aiFaces.begin() + range.second,
+                [&avCentroids, iAxis](unsigned int l, unsigned int r) {
+                    return avCentroids[l][iAxis] < avCentroids[r][iAxis];
+                });
+
+        // push the upper half first so the lower half is processed next
+        aiStack.push_back(std::make_pair(iMid, range.second));
+        aiStack.push_back(std::make_pair(range.first, iMid));
+    }
+
+    // build a per-vertex weight list if necessary
+    VertexWeightTable* avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
+
+    typedef std::vector<aiVertexWeight> BoneWeightList;
+    std::vector<BoneWeightList> avBoneWeights(pMesh->mNumBones);
+
+    for (const std::pair<unsigned int, unsigned int>& range : aiRanges) {
+        // collect the output vertices and remap the face indices
+        aiMesh* pcMesh          = new aiMesh;
+        pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
+        pcMesh->mMethod         = pMesh->mMethod;
+
+        // the name carries the adjacency information between the meshes
+        pcMesh->mName = pMesh->mName;
+
+        pcMesh->mNumFaces = range.second - range.first;
+        pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+
+        aiChunkVertices.clear();
+        for (unsigned int p = 0; p < pcMesh->mNumFaces; ++p) {
+            const aiFace& face = pMesh->mFaces[aiFaces[range.first + p]];
+            aiFace& rFace = pcMesh->mFaces[p];
+            rFace.mNumIndices = face.mNumIndices;
+            rFace.mIndices = new unsigned int[face.mNumIndices];
+
+            // need to update the output primitive types
+            switch (face.mNumIndices) {
+            case 1:
+                pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
+                break;
+            case 2:
+                pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+                break;
+            case 3:
+                pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+                break;
+            default:
+                pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+            }
+
+            for (unsigned int v = 0; v < face.mNumIndices; ++v) {
+                const unsigned int iIndex = face.mIndices[v];
+                if (verbose || 0xffffffff == aiVertexMap[iIndex]) {
+                    aiVertexMap[iIndex] = (unsigned int)aiChunkVertices.size();
+                    aiChunkVertices.push_back(iIndex);
+                }
+                rFace.mIndices[v] = verbose ? (unsigned int)aiChunkVertices.size() - 1 : aiVertexMap[iIndex];
+            }
+        }
+        for (unsigned int iIndex : aiChunkVertices) {
+            aiVertexMap[iIndex] = 0xffffffff;
+        }
+
+        // copy the vertex attributes
+        const unsigned int iCnt = pcMesh->mNumVertices = (unsigned int)aiChunkVertices.size();
+        if (pMesh->HasPositions()) {
+            pcMesh->mVertices = new aiVector3D[iCnt];
+        }
+        if (pMesh->HasNormals()) {
+            pcMesh->mNormals = new aiVector3D[iCnt];
+        }
+        if (pMesh->HasTangentsAndBitangents()) {
+            pcMesh->mTangents = new aiVector3D[iCnt];
+            pcMesh->mBitangents = new aiVector3D[iCnt];
+        }
+        for (unsigned int c = 0; pMesh->HasTextureCoords(c); ++c) {
+            pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
+            pcMesh->mTextureCoords[c] = new aiVector3D[iCnt];
+        }
+        for (unsigned int c = 0; pMesh->HasVertexColors(c); ++c) {
+            pcMesh->mColors[c] = new aiColor4D[iCnt];
+        }
+
+        for (unsigned int i = 0; i < iCnt; ++i) {
+            const unsigned int iIndex = aiChunkVertices[i];
+            if (pMesh->HasPositions()) {
+                pcMesh->mVertices[i] = pMesh->mVertices[iIndex];
+            }
+            if (pMesh->HasNormals()) {
+                pcMesh->mNormals[i] = pMesh->mNormals[iIndex];
+            }
+            if (pMesh->HasTangentsAndBitangents()) {
+                pcMesh->mTangents[i] = pMesh->mTangents[iIndex];
+                pcMesh->mBitangents[i] = pMesh->mBitangents[iIndex];
+            }
+            for (unsigned int c = 0; pMesh->HasTextureCoords(c); ++c) {
+                pcMesh->mTextureCoords[c][i] = pMesh->mTextureCoords[c][iIndex];
+            }
+            for (unsigned int c = 0; pMesh->HasVertexColors(c); ++c) {
+                pcMesh->mColors[c][i] = pMesh->mColors[c][iIndex];
+            }
+            if (avPerVertexWeights) {
+                for (const std::pair<unsigned int, float>& weight : avPerVertexWeights[iIndex]) {
+                    avBoneWeights[weight.first].push_back(aiVertexWeight(i, weight.second));
+                }
+            }
+        }
+
+        // copy the bones which influence this chunk
+        if (avPerVertexWeights) {
+            pcMesh->mBones = new aiBone*[pMesh->mNumBones];
+            for (unsigned int k = 0; k < pMesh->mNumBones; ++k) {
+                BoneWeightList& weights = avBoneWeights[k];
+                if (weights.empty()) {
+                    continue;
+                }
+                aiBone* pcOut = new aiBone();
+                pcMesh->mBones[pcMesh->mNumBones++] = pcOut;
+                pcOut->mName = pMesh->mBones[k]->mName;
+                pcOut->mOffsetMatrix = pMesh->mBones[k]->mOffsetMatrix;
+                pcOut->mArmature = pMesh->mBones[k]->mArmature;
+                pcOut->mNode = pMesh->mBones[k]->mNode;
+                pcOut->mNumWeights = (unsigned int)weights.size();
+                pcOut->mWeights = new aiVertexWeight[pcOut->mNumWeights];
+                ::memcpy(pcOut->mWeights, &weights[0], pcOut->mNumWeights * sizeof(aiVertexWeight));
+                weights.clear();
+            }
+            if (0 == pcMesh->mNumBones) {
+                // no bone influences this chunk
+                delete[] pcMesh->mBones;
+                pcMesh->mBones = nullptr;
+            }
+        }
+
+        // copy the morph targets
+        if (pMesh->mNumAnimMeshes) {
+            pcMesh->mNumAnimMeshes = pMesh->mNumAnimMeshes;
+            pcMesh->mAnimMeshes = new aiAnimMesh*[pcMesh->mNumAnimMeshes];
+            for (unsigned int m = 0; m < pMesh->mNumAnimMeshes; ++m) {
+                const aiAnimMesh* pAnim = pMesh->mAnimMeshes[m];
+                aiAnimMesh* pcAnim = pcMesh->mAnimMeshes[m] = new aiAnimMesh();
+                pcAnim->mName = pAnim->mName;
+                pcAnim->mWeight = pAnim->mWeight;
+                pcAnim->mNumVertices = iCnt;
+                if (pAnim->HasPositions()) {
+                    pcAnim->mVertices = new aiVector3D[iCnt];
+                }
+                if (pAnim->HasNormals()) {
+                    pcAnim->mNormals = new aiVector3D[iCnt];
+                }
+                if (pAnim->HasTangentsAndBitangents()) {
+                    pcAnim->mTangents = new aiVector3D[iCnt];
+                    pcAnim->mBitangents = new aiVector3D[iCnt];
+                }
+                for (unsigned int c = 0; pAnim->HasTextureCoords(c); ++c) {
+                    pcAnim->mTextureCoords[c] = new aiVector3D[iCnt];
+                }
+                for (unsigned int c = 0; pAnim->HasVertexColors(c); ++c) {
+                    pcAnim->mColors[c] = new aiColor4D[iCnt];
+                }
+                for (unsigned int i = 0; i < iCnt; ++i) {
+                    const unsigned int iIndex = aiChunkVertices[i];
+                    if (pAnim->HasPositions()) {
+                        pcAnim->mVertices[i] = pAnim->mVertices[iIndex];
+                    }
+                    if (pAnim->HasNormals()) {
+                        pcAnim->mNormals[i] = pAnim->mNormals[iIndex];
+                    }
+                    if (pAnim->HasTangentsAndBitangents()) {
+                        pcAnim->mTangents[i] = pAnim->mTangents[iIndex];
+                        pcAnim->mBitangents[i] = pAnim->mBitangents[iIndex];
+                    }
+                    for (unsigned int c = 0; pAnim->HasTextureCoords(c); ++c) {
+                        pcAnim->mTextureCoords[c][i] = pAnim->mTextureCoords[c][iIndex];
+                    }
+                    for (unsigned int c = 0; pAnim->HasVertexColors(c); ++c) {
+                        pcAnim->mColors[c][i] = pAnim->mColors[c][iIndex];
+                    }
+                }
+            }
+        }
+
+        // give every chunk a tight bounding box
+        if (pcMesh->HasPositions()) {
+            aiVector3D vMin = pcMesh->mVertices[0], vMax = vMin;
+            for (unsigned int i = 1; i < iCnt; ++i) {
+                const aiVector3D& v = pcMesh->mVertices[i];
+                vMin.x = std::min(vMin.x, v.x); vMax.x = std::max(vMax.x, v.x);
+                vMin.y = std::min(vMin.y, v.y); vMax.y = std::max(vMax.y, v.y);
+                vMin.z = std::min(vMin.z, v.z); vMax.z = std::max(vMax.z, v.z);
+            }
+            pcMesh->mAABB = aiAABB(vMin, vMax);
+        }
+
+        // add the newly created mesh to the list
+        avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+    }
+
+    // delete the per-vertex weight list again
+    delete[] avPerVertexWeights;
+
+    // now delete the old mesh data
+    delete pMesh;
+}
+
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Vertex::SplitLargeMeshesProcess_Vertex() {
     LIMIT = AI_SLM_DEFAULT_MAX_VERTICES;
+    SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -387,6 +698,7 @@ void SplitLargeMeshesProcess_Vertex::Execute( aiScene* pScene) {
 // Setup properties
 void SplitLargeMeshesProcess_Vertex::SetupProperties( const Importer* pImp) {
     this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,AI_SLM_DEFAULT_MAX_VERTICES);
+    this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -395,6 +707,11 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
         unsigned int a,
         aiMesh* pMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
+    if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT && SPATIAL) {
+        ASSIMP_LOG_INFO("Mesh exceeds the vertex limit. It will be split spatially ...");
+        SplitLargeMeshesProcess_Triangle::SplitMeshSpatially(a, pMesh, 0xffffffff, LIMIT, false, avList);
+        return;
+    }
     if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT) {
         typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
 
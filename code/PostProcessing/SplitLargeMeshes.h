@@ -119,6 +119,14 @@ public:
     inline unsigned int GetLimit() const
         {return LIMIT;}
 
+    //! Enable or disable the spatial partitioning mode
+    inline void SetSpatial(bool spatial)
+        {SPATIAL = spatial;}
+
+    //! Get whether the spatial partitioning mode is enabled
+    inline bool IsSpatial() const
+        {return SPATIAL;}
+
 public:
 
     // -------------------------------------------------------------------
@@ -139,9 +147,29 @@ public:
     static void UpdateNode(aiNode* pcNode,
         const std::vector<std::pair<aiMesh*, unsigned int> >& avList);
 
+    // -------------------------------------------------------------------
+    /** Split a mesh along a median-split kd tree of its face centroids.
+    *
+    * Faces are partitioned recursively until every chunk holds at most
+    * maxFaces faces and references at most maxVertices vertices. Every
+    * output mesh receives a tight mAABB.
+    * @param a Index of the mesh in the scene
+    * @param pMesh Mesh to be split, deleted afterwards
+    * @param maxFaces Maximum number of faces per chunk
+    * @param maxVertices Maximum number of vertices per chunk
+    * @param verbose Emit one vertex per face corner instead of
+    *   sharing vertices between the faces of a chunk
+    * @param avList Receives the output meshes */
+    static void SplitMeshSpatially(unsigned int a, aiMesh* pMesh,
+        unsigned int maxFaces, unsigned int maxVertices, bool verbose,
+        std::vector<std::pair<aiMesh*, unsigned int> >& avList);
+
 public:
     //! Triangle limit
     unsigned int LIMIT;
+
+    //! Split along a kd tree of the face centroids
+    bool SPATIAL;
 };
 
 
@@ -183,6 +211,14 @@ public:
     inline unsigned int GetLimit() const
         {return LIMIT;}
 
+    //! Enable or disable the spatial partitioning mode
+    inline void SetSpatial(bool spatial)
+        {SPATIAL = spatial;}
+
+    //! Get whether the spatial partitioning mode is enabled
+    inline bool IsSpatial() const
+        {return SPATIAL;}
+
 public:
 
     // -------------------------------------------------------------------
@@ -200,8 +236,11 @@ public:
     // NOTE: Reuse SplitLargeMeshesProcess_Triangle::UpdateNode()
 
 public:
-    //! Triangle limit
+    //! Vertex limit
     unsigned int LIMIT;
+
+    //! Split along a kd tree of the face centroids
+    bool SPATIAL;
 };
 
 } // end of namespace Assimp
@@ -76,6 +76,12 @@ bool TextureTransformStep::IsActive( unsigned int pFlags) const
     return  (pFlags & aiProcess_TransformUVCoords) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int TextureTransformStep::GetMutatedMeshAttributes() const
+{
+    return MeshAttr_TexCoords;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup properties
 void TextureTransformStep::SetupProperties(const Importer* pImp)
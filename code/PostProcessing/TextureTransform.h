@@ -205,6 +205,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
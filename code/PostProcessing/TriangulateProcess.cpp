@@ -63,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
 
+#include <algorithm>
 #include <memory>
 #include <cstdint>
 
@@ -178,21 +179,25 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_Triangulate) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int TriangulateProcess::GetMutatedMeshAttributes() const
+{
+    return MeshAttr_Faces;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void TriangulateProcess::Execute( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("TriangulateProcess begin");
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-    {
+    std::vector<char> results(pScene->mNumMeshes, 0);
+    ParallelFor(pScene->mNumMeshes, [&](unsigned int a) {
         if (pScene->mMeshes[ a ]) {
-            if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
-                bHas = true;
-            }
+            results[ a ] = TriangulateMesh( pScene->mMeshes[ a ] );
         }
-    }
+    });
+    const bool bHas = std::find(results.begin(), results.end(), 1) != results.end();
     if ( bHas ) {
         ASSIMP_LOG_INFO( "TriangulateProcess finished. All polygons have been triangulated." );
     } else {
@@ -608,15 +613,16 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             ++f;
         }
 
-        delete[] face.mIndices;
-        face.mIndices = nullptr;
+        pMesh->FreeFaceIndices(face);
     }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
     fclose(fout);
 #endif
 
-    // kill the old faces
+    // kill the old faces. Their index arrays have all been moved or released
+    // above, so this must not go through DeleteFaces() which would also free
+    // the index buffer the new faces may still point into.
     delete [] pMesh->mFaces;
 
     // ... and store the new ones
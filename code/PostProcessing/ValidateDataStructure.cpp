@@ -72,6 +72,11 @@ ValidateDSProcess::~ValidateDSProcess() {}
 bool ValidateDSProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ValidateDSProcess::GetMutatedMeshAttributes() const {
+    return 0;
+}
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) {
     ai_assert(nullptr != msg);
@@ -329,6 +334,11 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
         if (!face.mIndices)
             ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
+
+        if (pMesh->IsInIndexBuffer(face.mIndices) &&
+                face.mIndices + face.mNumIndices > pMesh->mIndexBuffer + pMesh->mIndexBufferSize) {
+            ReportError("aiMesh::mFaces[%i].mIndices exceeds aiMesh::mIndexBuffer", i);
+        }
     }
 
     // positions must always be there ...
@@ -464,6 +474,42 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
     } else if (pMesh->mBones) {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    if (pMesh->mMeshlets) {
+        Validate(pMesh, pMesh->mMeshlets);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate(const aiMesh *pMesh, const aiMeshlets *pMeshlets) {
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        ReportError("aiMesh::mMeshlets is set, but the mesh does not consist of triangles only");
+    }
+    if (!pMeshlets->mMeshlets || !pMeshlets->mVertices || !pMeshlets->mTriangles) {
+        ReportError("aiMeshlets is empty");
+    }
+    if (pMeshlets->mNumTriangles != pMesh->mNumFaces) {
+        ReportError("aiMeshlets::mNumTriangles is %u, but the mesh has %u faces",
+                pMeshlets->mNumTriangles, pMesh->mNumFaces);
+    }
+
+    for (unsigned int i = 0; i < pMeshlets->mNumMeshlets; ++i) {
+        const aiMeshlet &meshlet = pMeshlets->mMeshlets[i];
+        if (meshlet.mVertexOffset + meshlet.mNumVertices > pMeshlets->mNumVertices ||
+                meshlet.mTriangleOffset + meshlet.mNumTriangles > pMeshlets->mNumTriangles) {
+            ReportError("aiMeshlets::mMeshlets[%u] is out of range", i);
+        }
+        for (unsigned int a = 0; a < meshlet.mNumVertices; ++a) {
+            if (pMeshlets->mVertices[meshlet.mVertexOffset + a] >= pMesh->mNumVertices) {
+                ReportError("aiMeshlets::mMeshlets[%u] references a vertex which is out of range", i);
+            }
+        }
+        for (unsigned int a = 0; a < meshlet.mNumTriangles * 3; ++a) {
+            if (pMeshlets->mTriangles[meshlet.mTriangleOffset * 3 + a] >= meshlet.mNumVertices) {
+                ReportError("aiMeshlets::mMeshlets[%u] has a triangle index which is out of range", i);
+            }
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 struct aiBone;
 struct aiMesh;
+struct aiMeshlets;
 struct aiAnimation;
 struct aiNodeAnim;
 struct aiMeshMorphAnim;
@@ -80,6 +81,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    unsigned int GetMutatedMeshAttributes() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -110,6 +114,12 @@ protected:
      * @param pBone Input bone*/
     void Validate( const aiMesh* pMesh,const aiBone* pBone,float* afSum);
 
+    // -------------------------------------------------------------------
+    /** Validates the meshlets of a mesh
+     * @param pMesh Input mesh
+     * @param pMeshlets Meshlets of the mesh*/
+    void Validate( const aiMesh* pMesh,const aiMeshlets* pMeshlets);
+
     // -------------------------------------------------------------------
     /** Validates an animation
      * @param pAnimation Input animation*/
@@ -67,11 +67,32 @@ class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
+class ThreadPool;
+
+namespace Profiling {
+class Profiler;
+}
 
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
                                           (string[1] << 16) + (string[2] << 8) + string[3]))
 
+// ---------------------------------------------------------------------------
+/** Magic tokens identifying a file format, as declared by
+ *  BaseImporter::GetMagicTokens(). The members correspond to the
+ *  parameters of BaseImporter::CheckMagicToken().
+ */
+struct MagicTokenInfo {
+    /// Array of num tokens, each of them size bytes long.
+    const void *tokens;
+    /// Number of tokens.
+    unsigned int num;
+    /// Offset from file start where the tokens are located.
+    unsigned int offset;
+    /// Size of one token, in bytes. Maximally 16 bytes.
+    unsigned int size;
+};
+
 // ---------------------------------------------------------------------------
 /** FOR IMPORTER PLUGINS ONLY: The BaseImporter defines a common interface
  *  for all importer worker classes.
@@ -115,6 +136,17 @@ public:
             IOSystem *pIOHandler,
             bool checkSig) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns the magic tokens identifying the format, if it has any.
+     *
+     * Importers whose signature check consists of nothing but magic
+     * tokens should declare them here. Format auto-detection then
+     * compares them against the shared file header instead of calling
+     * CanRead(). The default implementation declares none.
+     * @return The tokens, nullptr if the format has none.
+     */
+    virtual const MagicTokenInfo *GetMagicTokens() const;
+
     // -------------------------------------------------------------------
     /** Imports the given file and returns the imported data.
      * If the import succeeds, ownership of the data is transferred to
@@ -309,6 +341,18 @@ public: // static utilities
             unsigned int offset = 0,
             unsigned int size = 4);
 
+    // -------------------------------------------------------------------
+    /** @brief Check whether a file starts with the tokens declared
+     *   by GetMagicTokens()
+     *  @param pIOHandler IO system to be used
+     *  @param pFile Input file
+     *  @return true if one of the tokens was found, false if there
+     *   are none
+     */
+    bool CheckMagicTokens(
+            IOSystem *pIOHandler,
+            const std::string &pFile) const;
+
     // -------------------------------------------------------------------
     /** An utility for all text file loaders. It converts a file to our
      *   UTF8 character set. Errors are reported, but ignored.
@@ -394,6 +438,10 @@ protected:
     std::exception_ptr m_Exception;
     /// Currently set progress handler.
     ProgressHandler *m_progress;
+    /// Profiler of the running import, nullptr unless statistics are gathered.
+    Profiling::Profiler *m_profiler;
+    /// Worker threads of the running import, nullptr to work serially.
+    ThreadPool *m_threadPool;
 };
 
 } // end of namespace Assimp
@@ -126,6 +126,17 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns a read-only view onto the whole file contents
+     *
+     *  Streams which keep the complete file in memory (memory-mapped
+     *  files, memory buffers) return a pointer to FileSize() bytes which
+     *  stays valid until the stream is closed. The data is not
+     *  null-terminated. The default implementation returns nullptr, in
+     *  this case the contents must be fetched using Read().
+     *  @see IOStreamView */
+    virtual const uint8_t* GetReadOnlyView() const;
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -139,6 +150,12 @@ AI_FORCE_INLINE
 IOStream::~IOStream() {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+AI_FORCE_INLINE
+const uint8_t* IOStream::GetReadOnlyView() const {
+    return nullptr;
+}
 // ----------------------------------------------------------------------------------
 
 } //!namespace Assimp
@@ -54,8 +54,60 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 
+#ifdef AI_SSE2_AVAILABLE
+#   include <emmintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#endif
+
 namespace Assimp {
 
+// ---------------------------------------------------------------------------
+/** Returns the first line end character ('\r', '\n', '\0' or '\f') in
+ *  [it, end), end if there is none.
+ */
+template<class T>
+AI_FORCE_INLINE
+T *findLineEnd( T *it, T *end ) {
+    while ( it != end && !IsLineEnd( *it ) ) {
+        ++it;
+    }
+    return it;
+}
+
+#ifdef AI_SSE2_AVAILABLE
+// Text data is scanned 16 characters at a time
+template<>
+AI_FORCE_INLINE
+char *findLineEnd<char>( char *it, char *end ) {
+    const __m128i cr = _mm_set1_epi8( '\r' );
+    const __m128i lf = _mm_set1_epi8( '\n' );
+    const __m128i ff = _mm_set1_epi8( '\f' );
+    const __m128i nul = _mm_setzero_si128();
+    while ( end - it >= 16 ) {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( it ) );
+        const __m128i hits = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, cr ), _mm_cmpeq_epi8( v, lf ) ),
+                                           _mm_or_si128( _mm_cmpeq_epi8( v, ff ), _mm_cmpeq_epi8( v, nul ) ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( hits ) );
+        if ( 0 != mask ) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward( &index, mask );
+            return it + index;
+#else
+            return it + __builtin_ctz( mask );
+#endif
+        }
+        it += 16;
+    }
+    while ( it != end && !IsLineEnd( *it ) ) {
+        ++it;
+    }
+    return it;
+}
+#endif // AI_SSE2_AVAILABLE
+
 // ---------------------------------------------------------------------------
 /**
  *  Implementation of a cached stream buffer.
@@ -107,6 +159,26 @@ public:
     /// @return true if successful.
     bool getNextDataLine( std::vector<T> &buffer, T continuationToken );
 
+    /// @brief  Will return a view of the next line without copying it.
+    ///
+    /// Lines ending with the continuation token are joined with the
+    /// following line, lines crossing a block boundary are carried over.
+    /// Only these are copied, into an internal line buffer. The view may be
+    /// modified and stays valid until the next read. The character at end
+    /// is always a line end, so parsers may scan for it without checking
+    /// the bounds.
+    /// @param  begin       Receives the start of the line.
+    /// @param  end         Receives the end of the line.
+    /// @param  continuationToken   The line continuation token.
+    /// @return false if there are no more lines.
+    bool getNextDataLine( T *&begin, T *&end, T continuationToken );
+
+    /// @brief  Will return a view of the next non-empty line without copying it.
+    /// @param  begin       Receives the start of the line.
+    /// @param  end         Receives the end of the line, always a line end.
+    /// @return false if there are no more lines.
+    bool getNextLine( T *&begin, T *&end );
+
     /// @brief  Will read the next line ascii or binary end line char.
     /// @param  buffer      The buffer for the next line.
     /// @return true if successful.
@@ -126,6 +198,8 @@ private:
     std::vector<T> m_cache;
     size_t m_cachePos;
     size_t m_filePos;
+    std::vector<T> m_lineBuffer;
+    bool m_skipLineFeed;
 };
 
 template<class T>
@@ -137,7 +211,9 @@ IOStreamBuffer<T>::IOStreamBuffer( size_t cache )
 , m_numBlocks( 0 )
 , m_blockIdx( 0 )
 , m_cachePos( 0 )
-, m_filePos( 0 ) {
+, m_filePos( 0 )
+, m_lineBuffer()
+, m_skipLineFeed( false ) {
     m_cache.resize( cache );
     std::fill( m_cache.begin(), m_cache.end(), '\n' );
 }
@@ -192,6 +268,7 @@ bool IOStreamBuffer<T>::close() {
     m_blockIdx  = 0;
     m_cachePos  = 0;
     m_filePos   = 0;
+    m_skipLineFeed = false;
 
     return true;
 }
@@ -285,6 +362,83 @@ bool IOStreamBuffer<T>::getNextDataLine( std::vector<T> &buffer, T continuationT
     return true;
 }
 
+template<class T>
+AI_FORCE_INLINE
+bool IOStreamBuffer<T>::getNextDataLine( T *&begin, T *&end, T continuationToken ) {
+    m_lineBuffer.clear();
+    bool useLineBuffer = false;
+    for( ;; ) {
+        if ( m_cachePos >= m_cacheSize || 0 == m_filePos ) {
+            if ( !readNextBlock() ) {
+                if ( !useLineBuffer ) {
+                    return false;
+                }
+
+                // last line without line end
+                break;
+            }
+        }
+
+        // the '\n' of a '\r\n' pair split by the block boundary
+        if ( m_skipLineFeed ) {
+            m_skipLineFeed = false;
+            if ( '\n' == m_cache[ m_cachePos ] ) {
+                ++m_cachePos;
+                continue;
+            }
+        }
+
+        T *const blockEnd = &m_cache[ 0 ] + m_cacheSize;
+        T *const start = &m_cache[ m_cachePos ];
+        T *const lineEnd = findLineEnd( start, blockEnd );
+        if ( lineEnd == blockEnd ) {
+            // the line continues in the next block, carry it over
+            m_lineBuffer.insert( m_lineBuffer.end(), start, blockEnd );
+            useLineBuffer = true;
+            m_cachePos = m_cacheSize;
+            continue;
+        }
+
+        // skip the line end, a '\r\n' pair counts as one
+        T *next = lineEnd + 1;
+        if ( '\r' == *lineEnd ) {
+            if ( next == blockEnd ) {
+                m_skipLineFeed = true;
+            } else if ( '\n' == *next ) {
+                ++next;
+            }
+        }
+        m_cachePos = static_cast<size_t>( next - &m_cache[ 0 ] );
+
+        const bool continued = start != lineEnd ?
+                continuationToken == lineEnd[ -1 ] :
+                !m_lineBuffer.empty() && continuationToken == m_lineBuffer.back();
+        if ( continued ) {
+            if ( start != lineEnd ) {
+                m_lineBuffer.insert( m_lineBuffer.end(), start, lineEnd - 1 );
+            } else {
+                m_lineBuffer.pop_back();
+            }
+            useLineBuffer = true;
+            continue;
+        }
+
+        if ( !useLineBuffer ) {
+            begin = start;
+            end = lineEnd;
+            return true;
+        }
+        m_lineBuffer.insert( m_lineBuffer.end(), start, lineEnd );
+        break;
+    }
+
+    m_lineBuffer.push_back( '\n' );
+    begin = &m_lineBuffer[ 0 ];
+    end = begin + m_lineBuffer.size() - 1;
+
+    return true;
+}
+
 static AI_FORCE_INLINE
 bool isEndOfCache( size_t pos, size_t cacheSize ) {
     return ( pos == cacheSize );
@@ -330,6 +484,19 @@ bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
     return true;
 }
 
+template<class T>
+AI_FORCE_INLINE
+bool IOStreamBuffer<T>::getNextLine( T *&begin, T *&end ) {
+    // '\0' is a line end itself and therefore never joins two lines
+    do {
+        if ( !getNextDataLine( begin, end, '\0' ) ) {
+            return false;
+        }
+    } while ( begin == end );
+
+    return true;
+}
+
 template<class T>
 AI_FORCE_INLINE
 bool IOStreamBuffer<T>::getNextBlock( std::vector<T> &buffer) {
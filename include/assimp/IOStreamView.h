@@ -0,0 +1,141 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file IOStreamView.h
+ *  @brief Read-only access to the whole contents of an IOStream.
+ */
+#pragma once
+#ifndef AI_IOSTREAMVIEW_H_INC
+#define AI_IOSTREAMVIEW_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/IOStream.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace Assimp {
+
+// ----------------------------------------------------------------------------------
+/** @brief Provides the whole contents of a stream as one contiguous block.
+ *
+ *  If the stream supports IOStream::GetReadOnlyView() (e.g. streams created
+ *  by MemoryMappedIOSystem or MemoryIOSystem) the data is accessed in place,
+ *  otherwise the contents are copied into an internal, null-terminated buffer.
+ *  The view must not outlive the stream it was loaded from.
+ *
+ *  @code
+ *  IOStreamView view;
+ *  if (view.load(stream, false)) {
+ *      parse(view.data(), view.size());
+ *  }
+ *  @endcode
+ */
+class IOStreamView {
+public:
+    /// @brief  The default class constructor.
+    IOStreamView() :
+            mData(nullptr),
+            mSize(0),
+            mCopy() {
+        // empty
+    }
+
+    /// @brief  Will load the contents of the given stream.
+    /// @param  stream          The stream, the read position is not changed for mapped streams.
+    /// @param  nullTerminated  true to request a trailing '\0' behind the data. Mappings cannot
+    ///                         provide one, so mapped contents will be copied in this case.
+    /// @return true, if the contents are accessible, false for an invalid stream.
+    bool load(IOStream *stream, bool nullTerminated) {
+        mData = nullptr;
+        mSize = 0;
+        mCopy.clear();
+        if (nullptr == stream) {
+            return false;
+        }
+
+        const size_t len = stream->FileSize();
+        const uint8_t *mapped = stream->GetReadOnlyView();
+        if (nullptr != mapped && !nullTerminated) {
+            mData = reinterpret_cast<const char *>(mapped);
+            mSize = len;
+            return true;
+        }
+
+        mCopy.resize(len + 1, '\0');
+        if (nullptr != mapped) {
+            ::memcpy(mCopy.data(), mapped, len);
+            mSize = len;
+        } else if (0 != len) {
+            mSize = stream->Read(mCopy.data(), 1, len);
+        }
+        mData = mCopy.data();
+        return true;
+    }
+
+    /// @brief  Returns the contents.
+    const char *data() const {
+        return mData;
+    }
+
+    /// @brief  Returns the number of bytes, not counting the optional terminator.
+    size_t size() const {
+        return mSize;
+    }
+
+    /// @brief  Returns true, if the contents are accessed in place.
+    bool isMapped() const {
+        return nullptr != mData && mCopy.empty();
+    }
+
+private:
+    const char *mData;
+    size_t mSize;
+    std::vector<char> mCopy;
+};
+
+} // namespace Assimp
+
+#endif // AI_IOSTREAMVIEW_H_INC
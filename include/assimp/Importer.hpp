@@ -60,6 +60,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 
 #include <exception>
+#include <future>
 
 namespace Assimp {
 // =======================================================================
@@ -79,6 +80,7 @@ class BaseImporter;
 class BaseProcess;
 class SharedPostProcessInfo;
 class BatchLoader;
+class SceneBVH;
 
 // =======================================================================
 // Holy stuff, only for members of the high council of the Jedi.
@@ -92,6 +94,9 @@ struct aiScene;
 // importerdesc.h
 struct aiImporterDesc;
 
+// importstatistics.h
+struct aiImportStatistics;
+
 /** @namespace Assimp Assimp's CPP-API and all internal APIs */
 namespace Assimp {
 
@@ -478,6 +483,35 @@ public:
             const std::string &pFile,
             unsigned int pFlags);
 
+    // -------------------------------------------------------------------
+    /** @brief Reads the given file on a separate thread.
+     *
+     * The import behaves exactly like #ReadFile() and reports its progress
+     * to the #ProgressHandler of this importer, which is called from the
+     * importing thread then. Until the returned future is ready, no other
+     * methods of this instance may be called except #CancelReadFile().
+     * In builds without threading support the import runs when the
+     * result is requested from the future.
+     * @param pFile Path and filename to the file to be imported.
+     * @param pFlags Optional post processing steps, see #ReadFile().
+     * @return A future for the imported scene, which is nullptr if the
+     *   import failed or was cancelled. The scene remains in possession
+     *   of the Importer instance.
+     */
+    std::future<const aiScene *> ReadFileAsync(
+            const std::string &pFile,
+            unsigned int pFlags);
+
+    // -------------------------------------------------------------------
+    /** @brief Requests the running import to stop.
+     *
+     * Cancellation is cooperative: loaders stop at their next progress
+     * report, post-processing stops before the next step. The import
+     * then fails with the error "Import cancelled". This method may be
+     * called from any thread and does nothing if no import is running.
+     */
+    void CancelReadFile();
+
     // -------------------------------------------------------------------
     /** Frees the current scene.
      *
@@ -506,6 +540,27 @@ public:
      * following methods is called: #ReadFile(), #FreeScene(). */
     const std::exception_ptr& GetException() const;
 
+    // -------------------------------------------------------------------
+    /** Returns the structured timing report of the last import.
+     *
+     * Statistics are only gathered if #AI_CONFIG_GLOB_MEASURE_TIME is
+     * set. Post-processing applied later via ApplyPostProcessing() is
+     * appended to the report of the last ReadFile() call.
+     * @return The report, nullptr if no statistics were gathered.
+     *
+     * @note The returned value remains valid until the next call
+     * to #ReadFile() or until the importer is destroyed. */
+    const aiImportStatistics *GetImportStatistics() const;
+
+    // -------------------------------------------------------------------
+    /** Returns the bounding volume hierarchy of the current scene.
+     *
+     * The hierarchy is only built by #aiProcess_GenBoundingBoxes if
+     * #AI_CONFIG_PP_GBB_BVH is set. It refers to the current scene and
+     * is owned by it.
+     * @return The hierarchy, nullptr if there is none. */
+    const SceneBVH *GetSceneBVH() const;
+
     // -------------------------------------------------------------------
     /** Returns the scene loaded by the last successful call to ReadFile()
      *
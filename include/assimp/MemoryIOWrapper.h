@@ -142,6 +142,12 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // The buffer is already in memory, so hand it out directly
+    const uint8_t* GetReadOnlyView() const {
+        return buffer;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
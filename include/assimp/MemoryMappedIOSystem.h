@@ -0,0 +1,134 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MemoryMappedIOSystem.h
+ *  @brief IOSystem implementation which maps files for reading into memory.
+ */
+#pragma once
+#ifndef AI_MEMORYMAPPEDIOSYSTEM_H_INC
+#define AI_MEMORYMAPPEDIOSYSTEM_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+#include <string>
+
+namespace Assimp {
+
+// ----------------------------------------------------------------------------------
+//! @class  MemoryMappedIOStream
+//! @brief  Read-only stream on top of a memory-mapped file.
+//!
+//! The whole file is mapped once when the stream is opened. Read() copies out
+//! of the mapping, GetReadOnlyView() hands out the mapping itself, so loaders
+//! which need the entire file can parse it without copying.
+class ASSIMP_API MemoryMappedIOStream : public IOStream {
+    friend class MemoryMappedIOSystem;
+
+protected:
+    MemoryMappedIOStream(const uint8_t *data, size_t size, void *handle, const std::string &filename);
+
+public:
+    /** Destructor public to allow simple deletion to unmap the file. */
+    ~MemoryMappedIOStream();
+
+    // -------------------------------------------------------------------
+    /// Read from the mapping
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    // -------------------------------------------------------------------
+    /// Mapped files are read-only, will always fail
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    // -------------------------------------------------------------------
+    /// Seek specific position
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+
+    // -------------------------------------------------------------------
+    /// Get current seek position
+    size_t Tell() const override;
+
+    // -------------------------------------------------------------------
+    /// Get size of file
+    size_t FileSize() const override;
+
+    // -------------------------------------------------------------------
+    /// Nothing to flush for read-only mappings
+    void Flush() override;
+
+    // -------------------------------------------------------------------
+    /// Returns the mapping
+    const uint8_t *GetReadOnlyView() const override;
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+    size_t mPos;
+    void *mHandle;
+    std::string mFilename;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief IOSystem which maps files opened for reading into memory.
+ *
+ *  Files opened in a read mode are mapped read-only, all other modes as well
+ *  as files which cannot be mapped (empty files, special files) fall back to
+ *  the DefaultIOSystem behaviour. Install it with Importer::SetIOHandler().
+ */
+class ASSIMP_API MemoryMappedIOSystem : public DefaultIOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override;
+
+    // -------------------------------------------------------------------
+    /** Closes the given file and releases all resources associated with it. */
+    void Close(IOStream *pFile) override;
+};
+
+} // namespace Assimp
+
+#endif // AI_MEMORYMAPPEDIOSYSTEM_H_INC
@@ -52,10 +52,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <chrono>
+#include <assimp/defs.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/TinyFormatter.h>
+#include <assimp/importstatistics.h>
 
-#include <map>
+#include <atomic>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
@@ -63,37 +66,130 @@ namespace Profiling {
 using namespace Formatter;
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Measures named, possibly nested regions of an import. Timings are automatically
+ *  dumped to the log file and collected into an #aiImportStatistics report.
  */
 class Profiler {
 public:
-    Profiler() {
-        // empty
+    Profiler() : bytesRead(0) {
+        stats.mNumRegions = 0;
+        stats.mRegions = nullptr;
+        stats.mNumMetrics = 0;
+        stats.mMetrics = nullptr;
     }
 
-
-    /** Start a named timer */
+    /** Start a named timer. Regions started while another one is still
+     *  open become children of that region. */
     void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        aiProfileRegion entry;
+        entry.mName.Set(region);
+        entry.mParent = open.empty() ? AI_PROFILE_REGION_NO_PARENT : open.back().index;
+        entry.mDepth = static_cast<unsigned int>(open.size());
+        entry.mWallTime = entry.mCpuTime = 0.0;
+        entry.mBytesRead = entry.mNumAllocations = 0;
+
+        OpenRegion state;
+        state.index = static_cast<unsigned int>(regions.size());
+        state.wallStart = std::chrono::steady_clock::now();
+        state.cpuStart = GetThreadCpuTime();
+        state.bytesStart = bytesRead.load();
+        state.allocsStart = CountAllocations();
+
+        regions.push_back(entry);
+        open.push_back(state);
+        UpdateStatistics();
         ASSIMP_LOG_DEBUG("START `",region,"`");
     }
 
-
-    /** End a specific named timer and write its end time to the log */
+    /** End a specific named timer and write its end time to the log. Regions
+     *  still open inside of it are ended as well. */
     void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
+        size_t depth = open.size();
+        while (depth > 0 && region != regions[open[depth - 1].index].mName.C_Str()) {
+            --depth;
+        }
+        if (0 == depth) {
             return;
         }
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        ASSIMP_LOG_DEBUG("END   `",region,"`, dt= ", elapsedSeconds.count()," s");
+        while (open.size() >= depth) {
+            const OpenRegion &state = open.back();
+            aiProfileRegion &entry = regions[state.index];
+
+            std::chrono::duration<double> elapsedSeconds = std::chrono::steady_clock::now() - state.wallStart;
+            entry.mWallTime = elapsedSeconds.count();
+            entry.mCpuTime = GetThreadCpuTime() - state.cpuStart;
+            entry.mBytesRead = bytesRead.load() - state.bytesStart;
+            entry.mNumAllocations = CountAllocations() - state.allocsStart;
+            ASSIMP_LOG_DEBUG("END   `",entry.mName.C_Str(),"`, dt= ", entry.mWallTime," s");
+
+            open.pop_back();
+        }
+    }
+
+    /** Record a named value for the innermost open region and write it
+     *  to the log. */
+    void AddMetric(const std::string& name, double value) {
+        aiProfileMetric entry;
+        entry.mName.Set(name);
+        entry.mRegion = open.empty() ? AI_PROFILE_REGION_NO_PARENT : open.back().index;
+        entry.mValue = value;
+
+        metrics.push_back(entry);
+        UpdateStatistics();
+        ASSIMP_LOG_DEBUG("VALUE `",name,"` = ", value);
     }
 
+    /** Account for bytes read from a file. May be called from any thread. */
+    void AddBytesRead(uint64_t numBytes) {
+        bytesRead += numBytes;
+    }
+
+    /** Drop all recorded regions */
+    void Clear() {
+        regions.clear();
+        open.clear();
+        metrics.clear();
+        UpdateStatistics();
+    }
+
+    /** Get the report of all regions recorded so far. The pointer stays
+     *  valid for the lifetime of the profiler, the contents are updated
+     *  whenever a region is started or a value is added. */
+    const aiImportStatistics *GetStatistics() const {
+        return &stats;
+    }
+
+    /** Install the callback used to count heap allocations, nullptr to disable.
+     *  The callback is shared by all profilers of the library. */
+    static ASSIMP_API void SetAllocationCounter(aiAllocationCounter counter);
+
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+    struct OpenRegion {
+        unsigned int index;
+        std::chrono::steady_clock::time_point wallStart;
+        double cpuStart;
+        uint64_t bytesStart;
+        uint64_t allocsStart;
+    };
+
+    static ASSIMP_API uint64_t CountAllocations();
+
+    // processor time spent by the calling thread so far, in seconds
+    static ASSIMP_API double GetThreadCpuTime();
+
+    void UpdateStatistics() {
+        stats.mNumRegions = static_cast<unsigned int>(regions.size());
+        stats.mRegions = regions.empty() ? nullptr : regions.data();
+        stats.mNumMetrics = static_cast<unsigned int>(metrics.size());
+        stats.mMetrics = metrics.empty() ? nullptr : metrics.data();
+    }
+
+    std::vector<aiProfileRegion> regions;
+    std::vector<OpenRegion> open;
+    std::vector<aiProfileMetric> metrics;
+    std::atomic<uint64_t> bytesRead;
+    aiImportStatistics stats;
 };
 
 }
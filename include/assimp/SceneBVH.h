@@ -0,0 +1,178 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneBVH.h
+ *  @brief Bounding volume hierarchy over the triangles or mesh instances of a scene.
+ */
+#pragma once
+#ifndef AI_SCENEBVH_H_INC
+#define AI_SCENEBVH_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+#include <assimp/aabb.h>
+
+#include <vector>
+
+struct aiScene;
+struct aiNode;
+
+namespace Assimp {
+
+class ThreadPool;
+
+// ------------------------------------------------------------------------------------------------
+/** A bounding volume hierarchy over a scene, in world space.
+ *
+ *  The primitives are either the triangles of all mesh instances in the node graph or the
+ *  instances themselves, with the bounding box of the transformed mesh. The hierarchy is built
+ *  top-down with a binned surface area heuristic and stored as a flat array of nodes: the root
+ *  is node 0 and the two children of an inner node are adjacent. The primitives of a leaf are
+ *  contiguous in #GetPrimitives().
+ *
+ *  The hierarchy refers to the nodes of the scene by pointer, it must be rebuilt if the scene
+ *  changes. Queries are thread-safe. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SceneBVH {
+public:
+    /** The kind of primitives stored in the hierarchy */
+    enum Granularity {
+        /** One primitive per triangle of each mesh instance, other faces are ignored */
+        Triangles,
+        /** One primitive per mesh instance */
+        MeshInstances
+    };
+
+    /** A node of the hierarchy */
+    struct Node {
+        /** Bounds of everything below the node */
+        aiVector3D mMin;
+        /** Leaves: index of the first primitive. Inner nodes: index of the first child,
+         *  the second one is mFirst + 1. */
+        unsigned int mFirst;
+        aiVector3D mMax;
+        /** Number of primitives of a leaf, 0 for inner nodes */
+        unsigned int mCount;
+
+        bool IsLeaf() const { return mCount > 0; }
+    };
+
+    /** A triangle or mesh instance */
+    struct Primitive {
+        /** The scene node instancing the mesh */
+        const aiNode *mNode;
+        /** Index of the mesh in aiScene::mMeshes */
+        unsigned int mMesh;
+        /** Index of the face in aiMesh::mFaces, UINT_MAX for mesh instances */
+        unsigned int mFace;
+    };
+
+    /** Result of a ray query */
+    struct Hit {
+        /** Distance along the ray, in multiples of the direction vector */
+        ai_real mDistance;
+        /** Index of the primitive in #GetPrimitives() */
+        unsigned int mPrimitive;
+        /** Barycentric coordinates of the hit relative to the second and third vertex of the
+         *  triangle, 0 for mesh instances */
+        ai_real mU, mV;
+    };
+
+    SceneBVH();
+    ~SceneBVH();
+
+    // ------------------------------------------------------------------------------------
+    /** Builds the hierarchy, replacing any previous one.
+     * @param pScene The scene, with a valid node graph.
+     * @param pGranularity The kind of primitives to store.
+     * @param pMaxLeafSize Leaves with at most this many primitives are never split further.
+     *   Larger leaves are only created if splitting them wouldn't pay off.
+     * @param pThreadPool Optional worker threads to build the hierarchy with. */
+    void Build(const aiScene *pScene, Granularity pGranularity = Triangles,
+            unsigned int pMaxLeafSize = 4, ThreadPool *pThreadPool = nullptr);
+
+    // ------------------------------------------------------------------------------------
+    /** Finds the closest intersection of a ray with the primitives. For mesh instances
+     *  this is the entry point into their world space bounding box.
+     * @param pOrigin Origin of the ray.
+     * @param pDirection Direction of the ray, need not be normalized.
+     * @param pMaxDistance Intersections further away than this are ignored.
+     * @param poHit Receives the closest intersection.
+     * @return true if an intersection was found. */
+    bool Raycast(const aiVector3D &pOrigin, const aiVector3D &pDirection,
+            ai_real pMaxDistance, Hit &poHit) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all primitives whose bounding box overlaps
+     *  the given box. The indices refer to #GetPrimitives() and are sorted. */
+    void QueryAABB(const aiAABB &pBox, std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Returns the nodes of the hierarchy, the root is the first one. Empty if the
+     *  scene contains no primitives. */
+    const std::vector<Node> &GetNodes() const { return mNodes; }
+
+    /** Returns the primitives in leaf order. */
+    const std::vector<Primitive> &GetPrimitives() const { return mPrimitives; }
+
+    /** Returns the world space vertices of the triangle primitive pIndex. */
+    const aiVector3D *GetTriangle(unsigned int pIndex) const { return &mVertices[pIndex * 3]; }
+
+    /** Returns the kind of primitives stored in the hierarchy. */
+    Granularity GetGranularity() const { return mGranularity; }
+
+private:
+    Granularity mGranularity;
+    unsigned int mMaxDepth;
+    std::vector<Node> mNodes;
+    std::vector<Primitive> mPrimitives;
+    /** World space bounds of the primitives, in leaf order */
+    std::vector<aiAABB> mBounds;
+    /** World space triangle vertices, three per primitive in leaf order */
+    std::vector<aiVector3D> mVertices;
+};
+
+} // namespace Assimp
+
+#endif // AI_SCENEBVH_H_INC
@@ -71,6 +71,7 @@ struct aiMetadata;
 struct aiBone;
 struct aiMesh;
 struct aiAnimMesh;
+struct aiMeshlets;
 struct aiAnimation;
 struct aiNodeAnim;
 struct aiMeshMorphAnim;
@@ -353,6 +354,7 @@ public:
 
     // similar to Copy():
     static void Copy(aiAnimMesh **dest, const aiAnimMesh *src);
+    static void Copy(aiMeshlets **dest, const aiMeshlets *src);
     static void Copy(aiMaterial **dest, const aiMaterial *src);
     static void Copy(aiTexture **dest, const aiTexture *src);
     static void Copy(aiAnimation **dest, const aiAnimation *src);
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 #include "IOStream.hpp"
+#include "IOStreamView.h"
 
 #include <pugixml.hpp>
 #include <vector>
@@ -100,8 +101,7 @@ class TXmlParser {
 public:
     /// @brief The default class constructor.
     TXmlParser() :
-            mDoc(nullptr),
-            mData() {
+            mDoc(nullptr) {
         // empty
     }
 
@@ -112,11 +112,6 @@ public:
 
     ///	@brief  Will clear the parsed xml-file.
     void clear() {
-        if(mData.empty()) {
-            mDoc = nullptr;
-            return;
-        }
-        mData.clear();
         delete mDoc;
         mDoc = nullptr;
     }
@@ -158,13 +153,19 @@ public:
             return false;
         }
 
-        const size_t len = stream->FileSize();
-        mData.resize(len + 1);
-        memset(&mData[0], '\0', len + 1);
-        stream->Read(&mData[0], 1, len);
-        
+        // pugixml copies the buffer anyway, so parse mapped streams in place
+        IOStreamView contents;
+        contents.load(stream, false);
+
+        // stop at the first null character, as pugixml's load_string would
+        size_t len = contents.size();
+        if (const void *nul = ::memchr(contents.data(), '\0', len)) {
+            len = static_cast<const char *>(nul) - contents.data();
+        }
+
+        clear();
         mDoc = new pugi::xml_document();
-        pugi::xml_parse_result parse_result = mDoc->load_string(&mData[0], pugi::parse_full);
+        pugi::xml_parse_result parse_result = mDoc->load_buffer(contents.data(), len, pugi::parse_full, pugi::encoding_utf8);
         if (parse_result.status == pugi::status_ok) {
             return true;
         } 
@@ -366,7 +367,6 @@ public:
  private:
     pugi::xml_document *mDoc;
     TNodeType mCurrent;
-    std::vector<char> mData;
 };
 
 using XmlParser = TXmlParser<pugi::xml_node>;
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <assimp/importerdesc.h>
+#include <assimp/importstatistics.h>
 #include <assimp/types.h>
 
 #ifdef __cplusplus
@@ -58,7 +59,10 @@ extern "C" {
 #endif
 
 struct aiScene;
+struct aiMesh;
+struct aiMeshlet;
 struct aiFileIO;
+struct aiImportHandle;
 
 typedef void (*aiLogStreamCallback)(const char * /* message */, char * /* user */);
 
@@ -257,6 +261,67 @@ ASSIMP_API const C_STRUCT aiScene *aiApplyPostProcessing(
         const C_STRUCT aiScene *pScene,
         unsigned int pFlags);
 
+// --------------------------------------------------------------------------------
+/** Starts to read the given file on a worker thread.
+ *
+ * The import behaves exactly like #aiImportFileExWithProperties() with the
+ * default IO system. Poll the returned handle with #aiGetImportProgress() and
+ * #aiIsImportFinished(), stop it with #aiCancelImport() and fetch the result
+ * with #aiWaitForImport(), which also releases the handle.
+ * @param pFile Path and filename of the file to be imported.
+ * @param pFlags Optional post processing steps to be executed after
+ *   a successful import.
+ * @param pProps #aiPropertyStore instance containing import settings,
+ *   may be NULL. The settings are copied, the store can be released at once.
+ * @return A handle for the running import, NULL if it couldn't be started.
+ */
+ASSIMP_API C_STRUCT aiImportHandle *aiImportFileAsync(
+        const char *pFile,
+        unsigned int pFlags,
+        const C_STRUCT aiPropertyStore *pProps);
+
+// --------------------------------------------------------------------------------
+/** Returns the progress of a running import in the range [0, 1].
+ *
+ * The value is only as fine grained as the loader reports it.
+ * @param pHandle Handle returned by #aiImportFileAsync().
+ */
+ASSIMP_API float aiGetImportProgress(
+        const C_STRUCT aiImportHandle *pHandle);
+
+// --------------------------------------------------------------------------------
+/** Checks whether #aiWaitForImport() would return without blocking.
+ *
+ * If Assimp was built without threading support or no thread could be
+ * started, the import only runs inside #aiWaitForImport(). This returns
+ * AI_TRUE for such an import right away.
+ * @param pHandle Handle returned by #aiImportFileAsync().
+ */
+ASSIMP_API aiBool aiIsImportFinished(
+        const C_STRUCT aiImportHandle *pHandle);
+
+// --------------------------------------------------------------------------------
+/** Requests a running import to stop.
+ *
+ * Cancellation is cooperative, the import stops at the next progress report
+ * of the loader or before the next post processing step. #aiWaitForImport()
+ * returns NULL then and #aiGetErrorString() reports "Import cancelled".
+ * @param pHandle Handle returned by #aiImportFileAsync().
+ */
+ASSIMP_API void aiCancelImport(
+        C_STRUCT aiImportHandle *pHandle);
+
+// --------------------------------------------------------------------------------
+/** Waits for an import to finish and returns its result.
+ *
+ * The handle is released by this call and must not be used afterwards.
+ * @param pHandle Handle returned by #aiImportFileAsync().
+ * @return The imported scene, release it with #aiReleaseImport(). NULL if the
+ *   import failed or was cancelled, see #aiGetErrorString() for the reason.
+ */
+ASSIMP_API const C_STRUCT aiScene *aiWaitForImport(
+        C_STRUCT aiImportHandle *pHandle);
+
 // --------------------------------------------------------------------------------
 /** Get one of the predefine log streams. This is the quick'n'easy solution to
  *  access Assimp's log system. Attaching a log stream can slightly reduce Assimp's
@@ -373,6 +438,60 @@ ASSIMP_API void aiGetMemoryRequirements(
         const C_STRUCT aiScene *pIn,
         C_STRUCT aiMemoryInfo *in);
 
+// --------------------------------------------------------------------------------
+/** Get the structured timing report of an import.
+ *
+ * Statistics are only gathered if #AI_CONFIG_GLOB_MEASURE_TIME is set in the
+ * property store passed to aiImportFileExWithProperties().
+ * @param pIn Input asset.
+ * @return The report, NULL if no statistics were gathered. It stays valid
+ *   until aiReleaseImport() is called.
+ */
+ASSIMP_API const C_STRUCT aiImportStatistics *aiGetImportStatistics(
+        const C_STRUCT aiScene *pIn);
+
+// --------------------------------------------------------------------------------
+/** Install a callback which returns the number of heap allocations made so
+ * far, used to fill aiProfileRegion::mNumAllocations.
+ * @param counter The callback, NULL to stop counting allocations.
+ */
+ASSIMP_API void aiSetAllocationCounter(
+        aiAllocationCounter counter);
+
+// --------------------------------------------------------------------------------
+/** Get the number of meshlets of a mesh.
+ *
+ * Meshlets are generated if #AI_CONFIG_PP_MESHLET_GENERATE is set.
+ * @param pMesh Input mesh.
+ * @return The number of meshlets, 0 if the mesh has none.
+ */
+ASSIMP_API unsigned int aiGetMeshletCount(
+        const C_STRUCT aiMesh *pMesh);
+
+// --------------------------------------------------------------------------------
+/** Get a meshlet of a mesh.
+ * @param pMesh Input mesh.
+ * @param index Index of the meshlet, less than aiGetMeshletCount().
+ * @return The meshlet, NULL if the index is out of range.
+ */
+ASSIMP_API const C_STRUCT aiMeshlet *aiGetMeshlet(
+        const C_STRUCT aiMesh *pMesh,
+        unsigned int index);
+
+// --------------------------------------------------------------------------------
+/** Get the vertex indices of a triangle of a meshlet.
+ * @param pMesh Input mesh.
+ * @param meshlet Index of the meshlet.
+ * @param triangle Index of the triangle within the meshlet.
+ * @param indices Receives the three indices into the vertex arrays of the mesh.
+ * @return aiReturn_SUCCESS, or aiReturn_FAILURE if an index is out of range.
+ */
+ASSIMP_API C_ENUM aiReturn aiGetMeshletTriangle(
+        const C_STRUCT aiMesh *pMesh,
+        unsigned int meshlet,
+        unsigned int triangle,
+        unsigned int *indices);
+
 // --------------------------------------------------------------------------------
 /** Create an empty property store. Property stores are used to collect import
  *  settings.
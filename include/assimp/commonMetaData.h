@@ -64,4 +64,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /// Not all formats add this metadata.
 #define AI_METADATA_SOURCE_COPYRIGHT "SourceAsset_Copyright"
 
+/// Node metadata holding the level of detail of the meshes of the node as an int32_t, 1 being
+/// the first simplified level. Added by the mesh simplification, see #AI_CONFIG_PP_SIMPLIFY_LOD_COUNT.
+#define AI_METADATA_LOD_LEVEL "LodLevel"
+
 #endif
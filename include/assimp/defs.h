@@ -313,6 +313,16 @@ static const ai_real ai_epsilon = (ai_real)0.00001;
 #endif
 #endif // _MSC_VER
 
+/**
+ *  Defined if SSE2 intrinsics may be used unconditionally, which is true for
+ *  all x86-64 targets. Define ASSIMP_BUILD_NO_SIMD to use the scalar code
+ *  paths only.
+ */
+#if !defined(ASSIMP_BUILD_NO_SIMD) && !defined(SWIG) && \
+        (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define AI_SSE2_AVAILABLE
+#endif
+
 /**
  *  Helper macro to set a pointer to NULL in debug builds
  */
@@ -21,7 +21,9 @@
 #   pragma GCC system_header
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <stdint.h>
 #include <assimp/defs.h>
@@ -37,6 +39,13 @@
 #  include <assimp/Compiler/pstdint.h>
 #endif
 
+#ifdef AI_SSE2_AVAILABLE
+#  include <emmintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#endif
+
 namespace Assimp {
 
 const double fast_atof_table[16] =  {  // we write [16] here instead of [] to work around a swig bug
@@ -380,6 +389,194 @@ ai_real fast_atof( const char** inout) {
     return ret;
 }
 
+// ------------------------------------------------------------------------------------
+// Count the decimal digits at in, stopping at end. Sixteen characters are
+// classified at once where SSE2 is available.
+// ------------------------------------------------------------------------------------
+inline
+unsigned int fast_atof_count_digits(const char* in, const char* end) {
+    const char* const begin = in;
+#ifdef AI_SSE2_AVAILABLE
+    const __m128i below = _mm_set1_epi8('0' - 1);
+    const __m128i above = _mm_set1_epi8('9' + 1);
+    while ( end - in >= 16 ) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+        const unsigned int mask = ~static_cast<unsigned int>(_mm_movemask_epi8(digits)) & 0xffffu;
+        if ( 0 != mask ) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned int>(in - begin) + index;
+#else
+            return static_cast<unsigned int>(in - begin) + __builtin_ctz(mask);
+#endif
+        }
+        in += 16;
+    }
+#endif
+    while ( in != end && *in >= '0' && *in <= '9' ) {
+        ++in;
+    }
+    return static_cast<unsigned int>(in - begin);
+}
+
+// ------------------------------------------------------------------------------------
+// Convert num decimal digits, num must not exceed 19 so the value fits into
+// 64 bits. On x86 eight digits are combined at once in a general purpose register.
+// ------------------------------------------------------------------------------------
+inline
+uint64_t fast_atof_digits_to_uint(const char* in, unsigned int num) {
+    uint64_t value = 0;
+#ifdef AI_SSE2_AVAILABLE
+    for ( ; num >= 8; num -= 8, in += 8 ) {
+        uint64_t chunk;
+        ::memcpy(&chunk, in, sizeof(chunk));
+        chunk -= 0x3030303030303030ull;
+        chunk = ((chunk & 0x0f0f0f0f0f0f0f0full) * 2561) >> 8;
+        chunk = ((chunk & 0x00ff00ff00ff00ffull) * 6553601) >> 16;
+        chunk = ((chunk & 0x0000ffff0000ffffull) * 42949672960001ull) >> 32;
+        value = value * 100000000ull + chunk;
+    }
+#endif
+    for ( ; num > 0; --num, ++in ) {
+        value = value * 10 + static_cast<uint64_t>(*in - '0');
+    }
+    return value;
+}
+
+// ------------------------------------------------------------------------------------
+// Separators between the values of the array parsers. Commas only separate
+// values if they are not used as decimal points.
+// ------------------------------------------------------------------------------------
+inline
+bool fast_atof_is_separator(char in, bool comma) {
+    return in == ' ' || in == '\t' || in == '\n' || in == '\r' || in == '\f' || (comma && in == ',');
+}
+
+// ------------------------------------------------------------------------------------
+//! Same as fast_atoreal_move, but the digits are only scanned up to end. The
+//! result is bit-identical. *end must be readable and must not continue the
+//! number, e.g. a terminating zero or a line end.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+const char* fast_atoreal_move(const char* c, const char* end, Real& out, bool check_comma = true) {
+    const char* const start = c;
+    const bool inv = (*c == '-');
+    if (inv || *c == '+') {
+        ++c;
+    }
+
+    // nan, inf, overflowing integers and malformed input take the generic path
+    const unsigned int numDigits = fast_atof_count_digits(c, end);
+    const bool decimalPoint = (*c == '.' || (check_comma && *c == ',')) && c[1] >= '0' && c[1] <= '9';
+    if ( numDigits > 19 || ( 0 == numDigits && !decimalPoint ) ) {
+        return fast_atoreal_move<Real, ExceptionType>(start, out, check_comma);
+    }
+
+    Real f = static_cast<Real>( fast_atof_digits_to_uint(c, numDigits) );
+    c += numDigits;
+
+    if ((*c == '.' || (check_comma && c[0] == ',')) && c[1] >= '0' && c[1] <= '9') {
+        ++c;
+
+        // the same precision limit as in fast_atoreal_move
+        const unsigned int numDecimals = fast_atof_count_digits(c, end);
+        const unsigned int diff = std::min(numDecimals, static_cast<unsigned int>(AI_FAST_ATOF_RELAVANT_DECIMALS));
+        double pl = static_cast<double>( fast_atof_digits_to_uint(c, diff) );
+        c += numDecimals;
+
+        pl *= fast_atof_table[diff];
+        f += static_cast<Real>( pl );
+    } else if (*c == '.') {
+        ++c;
+    }
+
+    if (*c == 'e' || *c == 'E') {
+        ++c;
+        const bool einv = (*c=='-');
+        if (einv || *c=='+') {
+            ++c;
+        }
+
+        Real exp = static_cast<Real>( strtoul10_64<ExceptionType>(c, &c) );
+        if (einv) {
+            exp = -exp;
+        }
+        f *= std::pow(static_cast<Real>(10.0), exp);
+    }
+
+    if (inv) {
+        f = -f;
+    }
+    out = f;
+    return c;
+}
+
+// ------------------------------------------------------------------------------------
+//! Parse up to count reals separated by whitespace into out, and by commas if
+//! check_comma is false. Parsing stops at end or at a terminating zero, the
+//! number of parsed values is returned and *inout points behind the last one.
+//! The values are bit-identical to those of fast_atoreal_move.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+size_t fast_atoreal_array(const char** inout, const char* end, Real* out, size_t count, bool check_comma = true) {
+    const char* c = *inout;
+    size_t num = 0;
+    for ( ; num < count; ++num ) {
+        while ( c != end && fast_atof_is_separator(*c, !check_comma) ) {
+            ++c;
+        }
+        if ( c == end || *c == '\0' ) {
+            break;
+        }
+        c = fast_atoreal_move<Real, ExceptionType>(c, end, out[num], check_comma);
+    }
+    *inout = c;
+    return num;
+}
+
+// ------------------------------------------------------------------------------------
+//! Parse up to count integers separated by whitespace or commas into out, with
+//! the same results as strtol10. Parsing stops at end or at a terminating zero,
+//! the number of parsed values is returned and *inout points behind the last one.
+// ------------------------------------------------------------------------------------
+template<typename ExceptionType = DeadlyImportError>
+inline
+size_t strtol10_array(const char** inout, const char* end, int* out, size_t count) {
+    const char* c = *inout;
+    size_t num = 0;
+    for ( ; num < count; ++num ) {
+        while ( c != end && fast_atof_is_separator(*c, true) ) {
+            ++c;
+        }
+        if ( c == end || *c == '\0' ) {
+            break;
+        }
+
+        const bool inv = (*c == '-');
+        const char* digits = (inv || *c == '+') ? c + 1 : c;
+        const unsigned int numDigits = fast_atof_count_digits(digits, end);
+        if ( 0 == numDigits ) {
+            // The string is known to be bad, so don't risk printing the whole thing.
+            throw ExceptionType("The string \"", ai_str_toprintable(c, 30), "\" cannot be converted into a value." );
+        }
+
+        // longer numbers may wrap around, leave that to strtol10
+        if ( numDigits > 9 ) {
+            out[num] = strtol10(c, &c);
+            continue;
+        }
+        int value = static_cast<int>( fast_atof_digits_to_uint(digits, numDigits) );
+        out[num] = inv ? -value : value;
+        c = digits + numDigits;
+    }
+    *inout = c;
+    return num;
+}
+
 } //! namespace Assimp
 
 #endif // FAST_A_TO_F_H_INCLUDED
@@ -0,0 +1,150 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file importstatistics.h
+ *  @brief #aiImportStatistics and #aiProfileRegion, the structured import timing report.
+ */
+#pragma once
+#ifndef AI_IMPORT_STATISTICS_H_INC
+#define AI_IMPORT_STATISTICS_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Parent index of a top-level #aiProfileRegion */
+#define AI_PROFILE_REGION_NO_PARENT 0xffffffff
+
+/** Callback returning the current number of heap allocations made by the
+ *  process. The library cannot count allocations by itself, applications
+ *  which track them (i.e. by replacing the global allocator) can install
+ *  such a callback to get #aiProfileRegion::mNumAllocations filled. */
+typedef uint64_t (*aiAllocationCounter)(void);
+
+// --------------------------------------------------------------------------------
+/** A single measured region of an import, i.e. format detection, the
+ *  importer itself or one post-processing step.
+ *
+ *  Regions are nested: the measurements of a region include those of its
+ *  children. */
+// --------------------------------------------------------------------------------
+struct aiProfileRegion {
+    /** Name of the region, for example "import", "postprocess" or the
+     *  class name of a post-processing step. The FBX, OBJ and glTF2
+     *  importers split "import" into "parse" and "convert" children, all
+     *  other importers report a single "import" region. */
+    C_STRUCT aiString mName;
+
+    /** Index of the enclosing region in #aiImportStatistics::mRegions,
+     *  #AI_PROFILE_REGION_NO_PARENT for top-level regions. */
+    unsigned int mParent;
+
+    /** Nesting depth, 0 for top-level regions. */
+    unsigned int mDepth;
+
+    /** Elapsed wall-clock time, in seconds. */
+    double mWallTime;
+
+    /** Processor time spent by the importing thread, in seconds. Work done
+     *  on the worker threads of #AI_CONFIG_GLOB_MULTITHREADING is not
+     *  included, it only shows in #mWallTime. Where the platform has no per
+     *  thread clock, this is the processor time of the whole process as
+     *  reported by std::clock(). */
+    double mCpuTime;
+
+    /** Number of bytes read through the IOSystem while the region was open. */
+    uint64_t mBytesRead;
+
+    /** Number of heap allocations made while the region was open. Always
+     *  zero unless an #aiAllocationCounter has been installed. */
+    uint64_t mNumAllocations;
+};
+
+// --------------------------------------------------------------------------------
+/** A named value reported by an import step, for example the vertex cache
+ *  efficiency of the meshes before and after #aiProcess_ImproveCacheLocality. */
+// --------------------------------------------------------------------------------
+struct aiProfileMetric {
+    /** Name of the value, unique within its region. */
+    C_STRUCT aiString mName;
+
+    /** Index of the region in #aiImportStatistics::mRegions which was the
+     *  innermost open one when the value was reported,
+     *  #AI_PROFILE_REGION_NO_PARENT if there was none. */
+    unsigned int mRegion;
+
+    /** The reported value. */
+    double mValue;
+};
+
+// --------------------------------------------------------------------------------
+/** Structured timing report of the last import.
+ *
+ *  Statistics are only gathered if #AI_CONFIG_GLOB_MEASURE_TIME is set.
+ *  The regions are stored in the order they were opened, so parents always
+ *  precede their children. */
+// --------------------------------------------------------------------------------
+struct aiImportStatistics {
+    /** Number of regions in #mRegions. */
+    unsigned int mNumRegions;
+
+    /** The measured regions. */
+    C_STRUCT aiProfileRegion *mRegions;
+
+    /** Number of values in #mMetrics. */
+    unsigned int mNumMetrics;
+
+    /** The values reported by the import steps, in reporting order. */
+    C_STRUCT aiProfileMetric *mMetrics;
+};
+
+#ifdef __cplusplus
+} // end of extern "C"
+#endif
+
+#endif // AI_IMPORT_STATISTICS_H_INC
@@ -428,6 +428,99 @@ enum aiPrimitiveType {
 #define AI_PRIMITIVE_TYPE_FOR_N_INDICES(n) \
     ((n) > 3 ? aiPrimitiveType_POLYGON : (aiPrimitiveType)(1u << ((n)-1)))
 
+// ---------------------------------------------------------------------------
+/** @brief A small cluster of triangles of a mesh, see #aiMeshlets.
+ *
+ *  The vertices of the meshlet are mVertexOffset ... mVertexOffset+mNumVertices-1
+ *  in #aiMeshlets::mVertices, its triangles are mTriangleOffset ...
+ *  mTriangleOffset+mNumTriangles-1 in #aiMeshlets::mTriangles.
+ */
+struct aiMeshlet {
+    /** Index of the first vertex of the meshlet in #aiMeshlets::mVertices */
+    unsigned int mVertexOffset;
+
+    /** Index of the first triangle of the meshlet in #aiMeshlets::mTriangles */
+    unsigned int mTriangleOffset;
+
+    /** Number of unique vertices referenced by the meshlet */
+    unsigned int mNumVertices;
+
+    /** Number of triangles in the meshlet */
+    unsigned int mNumTriangles;
+
+    /** Center of a bounding sphere of the meshlet, in mesh space */
+    C_STRUCT aiVector3D mCenter;
+
+    /** Radius of the bounding sphere */
+    ai_real mRadius;
+
+    /** Apex of the normal cone of the meshlet. All triangles face away
+     *  from a viewer at position p if
+     *  dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff. */
+    C_STRUCT aiVector3D mConeApex;
+
+    /** Normalized axis of the normal cone */
+    C_STRUCT aiVector3D mConeAxis;
+
+    /** Cutoff of the normal cone. 1 if the triangles face too many
+     *  different directions for the meshlet to be culled by its cone. */
+    ai_real mConeCutoff;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief The partition of a triangle mesh into meshlets.
+ *
+ *  Generated by the meshlet step (#AI_CONFIG_PP_MESHLET_GENERATE). Each
+ *  triangle of the mesh is part of exactly one meshlet. A meshlet keeps a
+ *  list of the mesh vertices it uses and stores its triangles as 8 bit
+ *  indices into that list, which is the layout mesh shaders consume. The
+ *  partition refers to the faces and vertices of the mesh at the time it
+ *  was generated, steps which change them afterwards invalidate it.
+ */
+struct aiMeshlets {
+    /** Number of meshlets */
+    unsigned int mNumMeshlets;
+
+    /** The meshlets, mNumMeshlets entries */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /** Number of entries in mVertices, the sum of the vertex counts
+     *  of all meshlets */
+    unsigned int mNumVertices;
+
+    /** Indices into the vertex arrays of the mesh, grouped by meshlet */
+    unsigned int *mVertices;
+
+    /** Number of triangles, the sum of the triangle counts of all meshlets */
+    unsigned int mNumTriangles;
+
+    /** Three entries per triangle, each one an index relative to the
+     *  mVertexOffset of the meshlet the triangle belongs to */
+    unsigned char *mTriangles;
+
+#ifdef __cplusplus
+
+    //! Default constructor
+    aiMeshlets() AI_NO_EXCEPT
+            : mNumMeshlets(0),
+              mMeshlets(nullptr),
+              mNumVertices(0),
+              mVertices(nullptr),
+              mNumTriangles(0),
+              mTriangles(nullptr) {
+        // empty
+    }
+
+    //! Destructor
+    ~aiMeshlets() {
+        delete[] mMeshlets;
+        delete[] mVertices;
+        delete[] mTriangles;
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief An AnimMesh is an attachment to an #aiMesh stores per-vertex
  *  animations for a particular frame.
@@ -745,6 +838,24 @@ struct aiMesh {
      */
     C_STRUCT aiAABB mAABB;
 
+    /**
+     *  Partition of the mesh into meshlets, nullptr unless the meshlet
+     *  step was run and the mesh consists of triangles only.
+     */
+    C_STRUCT aiMeshlets *mMeshlets;
+
+    /**
+     *  Contiguous storage for the index arrays of the faces, nullptr unless
+     *  the importer was asked to store them back to back, see
+     *  #AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES. Index arrays of faces
+     *  pointing into this buffer are owned by the mesh and must not be
+     *  deleted individually.
+     */
+    unsigned int *mIndexBuffer;
+
+    /** Number of indices in mIndexBuffer */
+    unsigned int mIndexBufferSize;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -766,7 +877,10 @@ struct aiMesh {
               mNumAnimMeshes(0),
               mAnimMeshes(nullptr),
               mMethod(0),
-              mAABB() {
+              mAABB(),
+              mMeshlets(nullptr),
+              mIndexBuffer(nullptr),
+              mIndexBufferSize(0) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -807,7 +921,8 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
-        delete[] mFaces;
+        delete mMeshlets;
+        DeleteFaces();
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -871,6 +986,63 @@ struct aiMesh {
         return mBones != nullptr && mNumBones > 0;
     }
 
+    //! Check whether an index array is stored in mIndexBuffer
+    bool IsInIndexBuffer(const unsigned int *indices) const {
+        return nullptr != indices && nullptr != mIndexBuffer &&
+               indices >= mIndexBuffer && indices < mIndexBuffer + mIndexBufferSize;
+    }
+
+    //! Allocate numFaces faces with indicesPerFace indices each, stored back
+    //! to back in mIndexBuffer. The mesh must not have any faces yet.
+    //! @return mIndexBuffer, to be filled by the caller
+    unsigned int *AllocateContiguousFaces(unsigned int numFaces, unsigned int indicesPerFace) {
+        mNumFaces = numFaces;
+        mFaces = new aiFace[numFaces];
+        mIndexBufferSize = numFaces * indicesPerFace;
+        mIndexBuffer = new unsigned int[mIndexBufferSize];
+        for (unsigned int i = 0; i < numFaces; ++i) {
+            mFaces[i].mNumIndices = indicesPerFace;
+            mFaces[i].mIndices = mIndexBuffer + i * indicesPerFace;
+        }
+        return mIndexBuffer;
+    }
+
+    //! Release the index array of one of the faces of the mesh and clear the face
+    void FreeFaceIndices(aiFace &face) const {
+        if (!IsInIndexBuffer(face.mIndices)) {
+            delete[] face.mIndices;
+        }
+        face.mIndices = nullptr;
+        face.mNumIndices = 0;
+    }
+
+    //! Take the index array of one of the faces of the mesh and clear the face.
+    //! The caller owns the returned array, arrays stored in mIndexBuffer are copied.
+    unsigned int *TakeFaceIndices(aiFace &face) const {
+        unsigned int *indices = face.mIndices;
+        if (IsInIndexBuffer(indices)) {
+            indices = new unsigned int[face.mNumIndices];
+            ::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+        }
+        face.mIndices = nullptr;
+        return indices;
+    }
+
+    //! Delete all faces and the index buffer
+    void DeleteFaces() {
+        if (nullptr != mIndexBuffer && nullptr != mFaces) {
+            for (unsigned int i = 0; i < mNumFaces; ++i) {
+                if (IsInIndexBuffer(mFaces[i].mIndices)) {
+                    mFaces[i].mIndices = nullptr;
+                }
+            }
+        }
+        delete[] mFaces;
+        mFaces = nullptr;
+        delete[] mIndexBuffer;
+        mIndexBuffer = nullptr;
+        mIndexBufferSize = 0;
+    }
 #endif // __cplusplus
 };
 
@@ -109,6 +109,11 @@ struct ASSIMP_API AllocateFromAssimpHeap {
 
 }; // struct AllocateFromAssimpHeap
 #endif
+
+// --------------------------------------------------------------------
+/** @brief Logs a warning that a string of the given length doesn't fit
+ *    into an aiString and was cropped or dropped. */
+ASSIMP_API void ReportStringTruncation(const char *str, size_t length);
 } // namespace Intern
 //! @endcond
 } // namespace Assimp
@@ -116,11 +121,25 @@ struct ASSIMP_API AllocateFromAssimpHeap {
 extern "C" {
 #endif
 
-/** Maximum dimension for strings, ASSIMP strings are zero terminated. */
+/** Maximum dimension for strings, ASSIMP strings are zero terminated.
+ *  Configured with ASSIMP_AISTRING_MAXLEN, see config.h. */
+#ifndef AI_MAXLEN
+#   ifdef ASSIMP_AISTRING_MAXLEN
+#       define AI_MAXLEN ASSIMP_AISTRING_MAXLEN
+#   else
+#       define AI_MAXLEN 1024
+#   endif
+#endif
+
+// Loaders copy fixed-size names of up to 64 characters without checking
+#if AI_MAXLEN < 128
+#   error "AI_MAXLEN must be at least 128"
+#endif
+
 #ifdef __cplusplus
-static const size_t MAXLEN = 1024;
+static const size_t MAXLEN = AI_MAXLEN;
 #else
-#define MAXLEN 1024
+#define MAXLEN AI_MAXLEN
 #endif
 
 // ----------------------------------------------------------------------------------
@@ -288,17 +307,21 @@ struct aiString {
     /** Constructor from std::string */
     explicit aiString(const std::string &pString) :
             length((ai_uint32)pString.length()) {
-        length = length >= MAXLEN ? MAXLEN - 1 : length;
+        if (length >= MAXLEN) {
+            Assimp::Intern::ReportStringTruncation(pString.c_str(), pString.length());
+            length = MAXLEN - 1;
+        }
         memcpy(data, pString.c_str(), length);
         data[length] = '\0';
     }
 
-    /** Copy a std::string to the aiString */
+    /** Copy a std::string to the aiString, cropped to the maximum length */
     void Set(const std::string &pString) {
-        if (pString.length() > MAXLEN - 1) {
-            return;
-        }
         length = (ai_uint32)pString.length();
+        if (length >= MAXLEN) {
+            Assimp::Intern::ReportStringTruncation(pString.c_str(), pString.length());
+            length = MAXLEN - 1;
+        }
         memcpy(data, pString.c_str(), length);
         data[length] = 0;
     }
@@ -307,6 +330,7 @@ struct aiString {
     void Set(const char *sz) {
         ai_int32 len = (ai_uint32)::strlen(sz);
         if (len > (ai_int32)MAXLEN - 1) {
+            Assimp::Intern::ReportStringTruncation(sz, len);
             len = (ai_int32) MAXLEN - 1;
         }
         length = len;
@@ -352,13 +376,15 @@ struct aiString {
         return (length != other.length || 0 != memcmp(data, other.data, length));
     }
 
-    /** Append a string to the string */
+    /** Append a string to the string, nothing is appended if the result
+     *  would exceed the capacity */
     void Append(const char *app) {
         const ai_uint32 len = (ai_uint32)::strlen(app);
         if (!len) {
             return;
         }
         if (length + len >= MAXLEN) {
+            Assimp::Intern::ReportStringTruncation(app, length + len);
             return;
         }
 
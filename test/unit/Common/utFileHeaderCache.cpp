@@ -0,0 +1,135 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/FileHeaderCache.h"
+
+#include <assimp/BaseImporter.h>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+static const std::string MD2File = ASSIMP_TEST_MODELS_DIR "/MD2/faerie.md2";
+
+// Counts the files opened, "model.unknown" refers to the MD2 test file
+class CountingIOSystem : public DefaultIOSystem {
+public:
+    unsigned int numOpened = 0;
+
+    bool Exists(const char *pFile) const override {
+        return DefaultIOSystem::Exists(Map(pFile).c_str());
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        ++numOpened;
+        return DefaultIOSystem::Open(Map(pFile).c_str(), pMode);
+    }
+
+private:
+    static std::string Map(const char *pFile) {
+        return std::string("model.unknown") == pFile ? MD2File : std::string(pFile);
+    }
+};
+
+} // namespace
+
+class utFileHeaderCache : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utFileHeaderCache, headerIsReadOnceTest) {
+    CountingIOSystem io;
+    const char *tokens[] = { "not in the file" };
+    const uint32_t magic = AI_MAKE_MAGIC("IDP2");
+    {
+        FileHeaderCache header(&io, MD2File);
+        EXPECT_FALSE(header.IsLoaded());
+        EXPECT_EQ(&header, FileHeaderCache::Get(&io, MD2File));
+        EXPECT_EQ(nullptr, FileHeaderCache::Get(&io, "other.md2"));
+
+        EXPECT_FALSE(BaseImporter::SearchFileHeaderForToken(&io, MD2File, tokens, 1));
+        EXPECT_TRUE(BaseImporter::CheckMagicToken(&io, MD2File, &magic, 1));
+        EXPECT_FALSE(BaseImporter::CheckMagicToken(&io, MD2File, &magic, 1, 4));
+        EXPECT_TRUE(header.IsLoaded());
+        EXPECT_EQ(1u, io.numOpened);
+
+        // ranges beyond the header are read from the file
+        const char *data = nullptr;
+        size_t numRead = 0;
+        EXPECT_TRUE(header.Peek(0, 16, data, numRead));
+        EXPECT_EQ(16u, numRead);
+        EXPECT_FALSE(header.Peek(FileHeaderCache::HeaderSize, 4, data, numRead));
+    }
+    EXPECT_EQ(nullptr, FileHeaderCache::Get(&io, MD2File));
+
+    EXPECT_TRUE(BaseImporter::CheckMagicToken(&io, MD2File, &magic, 1));
+    EXPECT_EQ(2u, io.numOpened);
+}
+
+TEST_F(utFileHeaderCache, missingFileTest) {
+    CountingIOSystem io;
+    const std::string file = "does_not_exist.md2";
+    const uint32_t magic = AI_MAKE_MAGIC("IDP2");
+
+    FileHeaderCache header(&io, file);
+    EXPECT_FALSE(BaseImporter::CheckMagicToken(&io, file, &magic, 1));
+    EXPECT_FALSE(BaseImporter::CheckMagicToken(&io, file, &magic, 1));
+    EXPECT_EQ(1u, io.numOpened);
+}
+
+TEST_F(utFileHeaderCache, signatureDetectionTest) {
+    CountingIOSystem *io = new CountingIOSystem;
+    Importer importer;
+    importer.SetIOHandler(io);
+
+    const aiScene *scene = importer.ReadFile("model.unknown", 0);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_LT(0u, scene->mNumMeshes);
+
+    // header for detection, file size for progress and the import itself
+    EXPECT_EQ(3u, io->numOpened);
+}
@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+
+#include "Common/SceneArena.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstdint>
+
+using namespace Assimp;
+
+namespace {
+
+static const unsigned int Flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals;
+
+void ExpectSameMeshes(const aiScene *expected, const aiScene *scene) {
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i];
+        const aiMesh *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+            ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+            EXPECT_EQ(0, memcmp(a->mFaces[f].mIndices, b->mFaces[f].mIndices, a->mFaces[f].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+} // namespace
+
+class utSceneArena : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utSceneArena, allocateTest) {
+    SceneArena arena;
+    EXPECT_FALSE(arena.Owns(&arena));
+
+    void *small = arena.Allocate(3);
+    void *large = arena.Allocate(SceneArena::DefaultBlockSize * 2);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(small) % SceneArena::Alignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(large) % SceneArena::Alignment);
+    EXPECT_TRUE(arena.Owns(small));
+    EXPECT_TRUE(arena.Owns(large));
+    EXPECT_EQ(SceneArena::Alignment + SceneArena::DefaultBlockSize * 2, arena.GetAllocatedSize());
+    EXPECT_LE(arena.GetAllocatedSize(), arena.GetCapacity());
+}
+
+TEST_F(utSceneArena, packedImportTest) {
+    Importer expected;
+    ASSERT_NE(nullptr, expected.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", Flags));
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", Flags);
+    ASSERT_NE(nullptr, scene);
+
+    const SceneArena *arena = ScenePriv(scene)->mArena.get();
+    ASSERT_NE(nullptr, arena);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_TRUE(arena->Owns(scene->mMeshes[i]->mVertices));
+        EXPECT_TRUE(arena->Owns(scene->mMeshes[i]->mFaces));
+        EXPECT_TRUE(arena->Owns(scene->mMeshes[i]->mFaces[0].mIndices));
+    }
+    ExpectSameMeshes(expected.GetScene(), scene);
+}
+
+TEST_F(utSceneArena, postProcessPackedSceneTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, true);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", Flags));
+
+    // the scene is unpacked for the step and packed again afterwards
+    const aiScene *scene = importer.ApplyPostProcessing(aiProcess_CalcTangentSpace);
+    ASSERT_NE(nullptr, scene);
+    const SceneArena *arena = ScenePriv(scene)->mArena.get();
+    ASSERT_NE(nullptr, arena);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        ASSERT_TRUE(scene->mMeshes[i]->HasTangentsAndBitangents());
+        EXPECT_TRUE(arena->Owns(scene->mMeshes[i]->mTangents));
+    }
+
+    Importer expected;
+    ASSERT_NE(nullptr, expected.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", Flags | aiProcess_CalcTangentSpace));
+    ExpectSameMeshes(expected.GetScene(), scene);
+}
+
+TEST_F(utSceneArena, copyAndUnpackTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, true);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", Flags));
+
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, importer.GetScene());
+    ASSERT_NE(nullptr, copy);
+    EXPECT_EQ(nullptr, ScenePriv(copy)->mArena.get());
+    ExpectSameMeshes(importer.GetScene(), copy);
+
+    aiScene *scene = importer.GetOrphanedScene();
+    EXPECT_TRUE(UnpackSceneFromArena(scene));
+    EXPECT_FALSE(UnpackSceneFromArena(scene));
+    ExpectSameMeshes(copy, scene);
+
+    delete copy;
+    delete scene;
+}
+
+TEST_F(utSceneArena, packContiguousFaceIndicesTest) {
+    Importer expected;
+    ASSERT_NE(nullptr, expected.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure));
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, true);
+    importer.SetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    // the index buffer of the mesh is released and its indices live in the arena
+    const SceneArena *arena = ScenePriv(scene)->mArena.get();
+    ASSERT_NE(nullptr, arena);
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_EQ(nullptr, mesh->mIndexBuffer);
+    EXPECT_TRUE(arena->Owns(mesh->mFaces[0].mIndices));
+    ExpectSameMeshes(expected.GetScene(), scene);
+
+    importer.FreeScene();
+}
@@ -0,0 +1,265 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/ThreadPool.h"
+#include "PostProcessing/GenBoundingBoxesProcess.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/SceneBVH.h>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utSceneBVH : public ::testing::Test {
+protected:
+    static const unsigned int Size = 70;
+
+    // a wavy Size x Size grid, instanced twice: once in place and once moved and rotated
+    void SetUp() override {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = (Size + 1) * (Size + 1);
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int y = 0; y <= Size; ++y) {
+            for (unsigned int x = 0; x <= Size; ++x) {
+                mesh->mVertices[y * (Size + 1) + x] = aiVector3D((ai_real)x, (ai_real)y, std::sin((ai_real)(x + y) * (ai_real)0.3));
+            }
+        }
+        mesh->mNumFaces = Size * Size * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        unsigned int f = 0;
+        for (unsigned int y = 0; y < Size; ++y) {
+            for (unsigned int x = 0; x < Size; ++x) {
+                const unsigned int v = y * (Size + 1) + x;
+                const unsigned int quad[2][3] = { { v, v + 1, v + Size + 2 }, { v, v + Size + 2, v + Size + 1 } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    mesh->mFaces[f].mNumIndices = 3;
+                    mesh->mFaces[f].mIndices = new unsigned int[3];
+                    std::copy(quad[t], quad[t] + 3, mesh->mFaces[f].mIndices);
+                }
+            }
+        }
+
+        mScene = new aiScene();
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        mScene->mMeshes[0] = mesh;
+        mScene->mRootNode = new aiNode("root");
+        aiNode *children[2] = { new aiNode("a"), new aiNode("b") };
+        aiMatrix4x4 rotation, translation;
+        aiMatrix4x4::RotationX((ai_real)0.5, rotation);
+        aiMatrix4x4::Translation(aiVector3D(10, -5, 20), translation);
+        children[1]->mTransformation = translation * rotation;
+        for (aiNode *child : children) {
+            child->mParent = mScene->mRootNode;
+            child->mNumMeshes = 1;
+            child->mMeshes = new unsigned int[1];
+            child->mMeshes[0] = 0;
+        }
+        mScene->mRootNode->addChildren(2, children);
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    // checks the structure of the hierarchy: every primitive is in exactly one leaf
+    // and each node contains its children
+    static void checkStructure(const SceneBVH &bvh) {
+        const std::vector<SceneBVH::Node> &nodes = bvh.GetNodes();
+        ASSERT_FALSE(nodes.empty());
+        std::vector<unsigned int> covered(bvh.GetPrimitives().size(), 0);
+        for (const SceneBVH::Node &node : nodes) {
+            if (node.IsLeaf()) {
+                for (unsigned int i = node.mFirst; i < node.mFirst + node.mCount; ++i) {
+                    ++covered[i];
+                }
+                continue;
+            }
+            for (unsigned int c = node.mFirst; c < node.mFirst + 2; ++c) {
+                EXPECT_LE(node.mMin.x, nodes[c].mMin.x);
+                EXPECT_LE(node.mMin.y, nodes[c].mMin.y);
+                EXPECT_LE(node.mMin.z, nodes[c].mMin.z);
+                EXPECT_GE(node.mMax.x, nodes[c].mMax.x);
+                EXPECT_GE(node.mMax.y, nodes[c].mMax.y);
+                EXPECT_GE(node.mMax.z, nodes[c].mMax.z);
+            }
+        }
+        EXPECT_EQ(covered.end(), std::find_if(covered.begin(), covered.end(), [](unsigned int n) { return n != 1; }));
+    }
+
+    // casts rays at the scene and compares the hits with a brute force search
+    static void checkRays(const SceneBVH &bvh) {
+        unsigned int seed = 3, numHits = 0;
+        auto random = [&seed]() {
+            seed = seed * 1103515245u + 12345u;
+            return (ai_real)((seed >> 16) % 10000) / 10000;
+        };
+        for (unsigned int r = 0; r < 200; ++r) {
+            const aiVector3D origin(random() * 60 - 10, random() * 60 - 10, 30);
+            const aiVector3D direction(random() - (ai_real)0.5, random() - (ai_real)0.5, -1);
+
+            ai_real closest = 1000;
+            for (unsigned int i = 0; i < bvh.GetPrimitives().size(); ++i) {
+                const aiVector3D *v = bvh.GetTriangle(i);
+                const aiVector3D e1 = v[1] - v[0], e2 = v[2] - v[0], p = direction ^ e2;
+                const ai_real det = e1 * p;
+                const aiVector3D s = origin - v[0], q = s ^ e1;
+                const ai_real u = (s * p) / det, w = (direction * q) / det, t = (e2 * q) / det;
+                if (det != 0 && u >= 0 && w >= 0 && u + w <= 1 && t >= 0 && t < closest) {
+                    closest = t;
+                }
+            }
+
+            SceneBVH::Hit hit;
+            const bool found = bvh.Raycast(origin, direction, 1000, hit);
+            EXPECT_EQ(closest < 1000, found);
+            if (found) {
+                EXPECT_NEAR(closest, hit.mDistance, 1e-3);
+                ++numHits;
+            }
+        }
+        EXPECT_GT(numHits, 20u);
+    }
+
+    aiScene *mScene = nullptr;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSceneBVH, triangles) {
+    SceneBVH bvh;
+    bvh.Build(mScene);
+    ASSERT_EQ(Size * Size * 4, bvh.GetPrimitives().size());
+    checkStructure(bvh);
+    checkRays(bvh);
+
+    // the hit reports the primitive and where on it the ray hit
+    SceneBVH::Hit hit;
+    ASSERT_TRUE(bvh.Raycast(aiVector3D((ai_real)2.25, (ai_real)2.75, 10), aiVector3D(0, 0, -1), 100, hit));
+    const SceneBVH::Primitive &prim = bvh.GetPrimitives()[hit.mPrimitive];
+    EXPECT_EQ(mScene->mRootNode->mChildren[0], prim.mNode);
+    EXPECT_EQ(0u, prim.mMesh);
+    EXPECT_EQ((2 * Size + 2) * 2 + 1, prim.mFace);
+    EXPECT_FALSE(bvh.Raycast(aiVector3D(-5, -5, 10), aiVector3D(0, 0, -1), 100, hit));
+    EXPECT_FALSE(bvh.Raycast(aiVector3D((ai_real)2.25, (ai_real)2.75, 10), aiVector3D(0, 0, -1), 5, hit));
+
+    // box queries return all triangles touching the box
+    aiAABB box(aiVector3D((ai_real)4.5, (ai_real)4.5, -2), aiVector3D((ai_real)6.5, (ai_real)5.5, 2));
+    std::vector<unsigned int> results;
+    bvh.QueryAABB(box, results);
+    std::vector<unsigned int> expected;
+    for (unsigned int i = 0; i < bvh.GetPrimitives().size(); ++i) {
+        const aiVector3D *v = bvh.GetTriangle(i);
+        aiAABB b(v[0], v[0]);
+        for (unsigned int k = 1; k < 3; ++k) {
+            b.mMin = aiVector3D(std::min(b.mMin.x, v[k].x), std::min(b.mMin.y, v[k].y), std::min(b.mMin.z, v[k].z));
+            b.mMax = aiVector3D(std::max(b.mMax.x, v[k].x), std::max(b.mMax.y, v[k].y), std::max(b.mMax.z, v[k].z));
+        }
+        if (b.mMin.x <= box.mMax.x && b.mMax.x >= box.mMin.x && b.mMin.y <= box.mMax.y &&
+                b.mMax.y >= box.mMin.y && b.mMin.z <= box.mMax.z && b.mMax.z >= box.mMin.z) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(expected, results);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSceneBVH, parallelBuild) {
+    ThreadPool pool(4);
+    SceneBVH bvh;
+    bvh.Build(mScene, SceneBVH::Triangles, 2, &pool);
+    ASSERT_EQ(Size * Size * 4, bvh.GetPrimitives().size());
+    checkStructure(bvh);
+    checkRays(bvh);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSceneBVH, meshInstances) {
+    SceneBVH bvh;
+    bvh.Build(mScene, SceneBVH::MeshInstances);
+    ASSERT_EQ(2u, bvh.GetPrimitives().size());
+    checkStructure(bvh);
+    EXPECT_EQ(UINT_MAX, bvh.GetPrimitives()[0].mFace);
+
+    SceneBVH::Hit hit;
+    ASSERT_TRUE(bvh.Raycast(aiVector3D(5, 5, 10), aiVector3D(0, 0, -1), 100, hit));
+    EXPECT_EQ(mScene->mRootNode->mChildren[0], bvh.GetPrimitives()[hit.mPrimitive].mNode);
+    EXPECT_NEAR(9, hit.mDistance, 1e-3);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSceneBVH, builtByPostProcessing) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GBB_BVH, 1);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_GenBoundingBoxes);
+    ASSERT_NE(nullptr, scene);
+    const SceneBVH *bvh = importer.GetSceneBVH();
+    ASSERT_NE(nullptr, bvh);
+    checkStructure(*bvh);
+
+    importer.SetPropertyInteger(AI_CONFIG_PP_GBB_BVH, 0);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_GenBoundingBoxes));
+    EXPECT_EQ(nullptr, importer.GetSceneBVH());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSceneBVH, droppedByLaterPostProcessing) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GBB_BVH, 2);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_GenBoundingBoxes));
+    ASSERT_NE(nullptr, importer.GetSceneBVH());
+
+    // validation leaves the scene alone, other steps may change the nodes the hierarchy refers to
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+    EXPECT_NE(nullptr, importer.GetSceneBVH());
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_OptimizeGraph));
+    EXPECT_EQ(nullptr, importer.GetSceneBVH());
+
+    // and a new one is built along with them
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_OptimizeMeshes | aiProcess_GenBoundingBoxes));
+    const SceneBVH *bvh = importer.GetSceneBVH();
+    ASSERT_NE(nullptr, bvh);
+    checkStructure(*bvh);
+}
@@ -0,0 +1,144 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/SpatialHashGrid.h"
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Assimp;
+
+class utSpatialHashGrid : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ::srand(42);
+
+        // a random cloud followed by a flat grid with every point duplicated
+        for (size_t i = 0; i < 1000; ++i) {
+            vecs.push_back(aiVector3D(Random(), Random(), Random()));
+        }
+        for (int y = 0; y < 100; ++y) {
+            for (int x = 0; x < 100; ++x) {
+                vecs.push_back(aiVector3D(x * 0.5f, y * 0.5f, 0.f));
+                vecs.push_back(aiVector3D(x * 0.5f, y * 0.5f, 0.f));
+            }
+        }
+    }
+
+    static float Random() {
+        return static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / 100));
+    }
+
+    std::vector<unsigned int> BruteForce(const aiVector3D &pos, ai_real radius) const {
+        std::vector<unsigned int> result;
+        for (size_t i = 0; i < vecs.size(); ++i) {
+            if ((vecs[i] - pos).SquareLength() < radius * radius) {
+                result.push_back(static_cast<unsigned int>(i));
+            }
+        }
+        return result;
+    }
+
+    std::vector<aiVector3D> vecs;
+};
+
+TEST_F(utSpatialHashGrid, findPositionsTest) {
+    SpatialHashGrid grid(vecs.data(), static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D));
+    EXPECT_LT(0, grid.GetCellSize());
+
+    std::vector<unsigned int> indices;
+    const ai_real radii[] = { 0.01f, 0.6f, 5.f, 500.f };
+    for (ai_real radius : radii) {
+        for (size_t i = 0; i < vecs.size(); i += 37) {
+            grid.FindPositions(vecs[i], radius, indices);
+            EXPECT_EQ(BruteForce(vecs[i], radius), indices);
+        }
+    }
+
+    grid.FindPositions(aiVector3D(1000.f, 0.f, 0.f), 1.f, indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST_F(utSpatialHashGrid, findIdenticalsTest) {
+    SpatialHashGrid grid(vecs.data(), static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D));
+
+    std::vector<unsigned int> indices;
+    grid.FindIdenticalPositions(vecs[0], indices);
+    ASSERT_EQ(1u, indices.size());
+    EXPECT_EQ(0u, indices[0]);
+
+    grid.FindIdenticalPositions(vecs[1000], indices);
+    ASSERT_EQ(2u, indices.size());
+    EXPECT_EQ(1000u, indices[0]);
+    EXPECT_EQ(1001u, indices[1]);
+}
+
+TEST_F(utSpatialHashGrid, generateMappingTableTest) {
+    SpatialHashGrid grid(vecs.data(), static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D));
+
+    std::vector<unsigned int> table;
+    EXPECT_EQ(1000u + 100u * 100u, grid.GenerateMappingTable(table, 0.01f));
+    ASSERT_EQ(vecs.size(), table.size());
+    EXPECT_EQ(table[1000], table[1001]);
+    EXPECT_NE(table[1001], table[1002]);
+}
+
+TEST_F(utSpatialHashGrid, parallelBuildTest) {
+    // enough positions for several build jobs
+    std::vector<aiVector3D> many;
+    for (int i = 0; i < 20; ++i) {
+        many.insert(many.end(), vecs.begin(), vecs.end());
+    }
+
+    SpatialHashGrid serial(many.data(), static_cast<unsigned int>(many.size()), sizeof(aiVector3D));
+    ThreadPool pool(4);
+    SpatialHashGrid parallel(many.data(), static_cast<unsigned int>(many.size()), sizeof(aiVector3D), &pool);
+    EXPECT_EQ(serial.GetCellSize(), parallel.GetCellSize());
+
+    std::vector<unsigned int> a, b;
+    for (size_t i = 0; i < many.size(); i += 101) {
+        serial.FindPositions(many[i], 0.6f, a);
+        parallel.FindPositions(many[i], 0.6f, b);
+        EXPECT_EQ(a, b);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Assimp;
+
+class utThreadPool : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utThreadPool, parallelForVisitsAllIndicesTest) {
+    ThreadPool pool(3);
+    std::vector<int> visited(1000, 0);
+    pool.ParallelFor(visited.size(), [&](size_t i) {
+        visited[i] += static_cast<int>(i);
+    });
+    for (size_t i = 0; i < visited.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), visited[i]);
+    }
+
+    // nothing to do is fine, too
+    pool.ParallelFor(0, [](size_t) {
+        FAIL();
+    });
+}
+
+TEST_F(utThreadPool, nestedParallelForTest) {
+    ThreadPool pool(2);
+    std::atomic<int> sum(0);
+    pool.ParallelFor(8, [&](size_t) {
+        pool.ParallelFor(8, [&](size_t j) {
+            sum += static_cast<int>(j);
+        });
+    });
+    EXPECT_EQ(8 * 28, sum.load());
+}
+
+TEST_F(utThreadPool, parallelForRethrowsTest) {
+    ThreadPool pool(4);
+    bool caught = false;
+    try {
+        pool.ParallelFor(100, [](size_t i) {
+            if (i == 7) {
+                throw std::runtime_error("7");
+            }
+        });
+    } catch (const std::runtime_error &e) {
+        caught = true;
+        EXPECT_STREQ("7", e.what());
+    }
+    EXPECT_TRUE(caught);
+}
+
+TEST_F(utThreadPool, enqueueTest) {
+    std::atomic<int> counter(0);
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) {
+            pool.Enqueue([&counter]() { ++counter; });
+        }
+        // the destructor finishes all pending tasks
+    }
+    EXPECT_EQ(50, counter.load());
+}
@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/Importer.h"
 #include "TestIOSystem.h"
 
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
 using namespace ::Assimp;
 
 class BatchLoaderTest : public ::testing::Test {
@@ -79,3 +83,51 @@ TEST_F( BatchLoaderTest, validateAccessTest ) {
     BatchLoader loader2( m_io, true );
     EXPECT_TRUE( loader2.getValidation() );
 }
+
+TEST_F( BatchLoaderTest, numThreadsAccessTest ) {
+    BatchLoader loader( m_io );
+    EXPECT_EQ( 0, loader.getNumThreads() );
+    loader.setNumThreads( 4 );
+    EXPECT_EQ( 4, loader.getNumThreads() );
+}
+
+TEST_F( BatchLoaderTest, parallelLoadTest ) {
+    DefaultIOSystem io;
+    BatchLoader loader( &io );
+    loader.setNumThreads( 4 );
+
+    const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl"
+    };
+    unsigned int ids[4];
+    for ( unsigned int i = 0; i < 4; ++i ) {
+        ids[ i ] = loader.AddLoadRequest( files[ i ] );
+    }
+
+    // identical requests are merged
+    EXPECT_EQ( ids[ 1 ], loader.AddLoadRequest( files[ 1 ] ) );
+
+    loader.LoadAll();
+    aiScene *merged = nullptr;
+    for ( unsigned int i = 0; i < 4; ++i ) {
+        aiScene *scene = loader.GetImport( ids[ i ] );
+        ASSERT_NE( nullptr, scene ) << files[ i ];
+
+        Importer importer;
+        const aiScene *expected = importer.ReadFile( files[ i ], 0 );
+        ASSERT_NE( nullptr, expected );
+        EXPECT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+        if ( i == 1 ) {
+            merged = scene;
+        } else {
+            delete scene;
+        }
+    }
+
+    // the merged request is polled a second time and shares the scene
+    EXPECT_EQ( merged, loader.GetImport( ids[ 1 ] ) );
+    delete merged;
+}
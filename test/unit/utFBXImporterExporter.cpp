@@ -49,6 +49,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace Assimp;
 
 class utFBXImporterExporter : public AbstractImportExportBase {
@@ -423,3 +426,154 @@ TEST_F(utFBXImporterExporter, importMaxPbrMaterialsSpecularGloss) {
     ASSERT_EQ(mat->Get("$raw.3dsMax|main|emit_color", aiTextureType_NONE, 0, emitColor), aiReturn_SUCCESS);
     EXPECT_EQ(emitColor, aiColor4D(1, 0, 1, 1));
 }
+
+static void ExpectSameMeshes(const aiScene *expected, const aiScene *scene) {
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        EXPECT_EQ(a->mName, b->mName);
+        EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+        EXPECT_EQ(a->mNumBones, b->mNumBones);
+        EXPECT_EQ(a->mNumAnimMeshes, b->mNumAnimMeshes);
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        if (a->HasNormals()) {
+            EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        }
+        for (unsigned int j = 0; j < a->mNumBones && j < b->mNumBones; ++j) {
+            EXPECT_EQ(a->mBones[j]->mName, b->mBones[j]->mName);
+            EXPECT_EQ(a->mBones[j]->mNumWeights, b->mBones[j]->mNumWeights);
+        }
+    }
+}
+
+TEST_F(utFBXImporterExporter, importCompressedArraysMultithreaded) {
+    // The arrays of the binary file are zlib-compressed, with multithreading enabled they
+    // are inflated on the worker pool. The result must not depend on it.
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_NONBSD_DIR "/FBX/2013_BINARY/jeep1.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    const aiScene *scene = parallel.ReadFile(ASSIMP_TEST_MODELS_NONBSD_DIR "/FBX/2013_BINARY/jeep1.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ExpectSameMeshes(expected, scene);
+}
+
+TEST_F(utFBXImporterExporter, importMultithreadedConversion) {
+    // meshes split by material and skinned meshes are converted on the worker pool,
+    // the output order must not change
+    static const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx",
+        ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx",
+    };
+    for (const char *file : files) {
+        Assimp::Importer serial;
+        const aiScene *expected = serial.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, expected);
+
+        Assimp::Importer parallel;
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+        const aiScene *scene = parallel.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+
+        ExpectSameMeshes(expected, scene);
+    }
+}
+
+namespace {
+
+// evaluates a channel at the given time, interpolating linearly between its keys
+template <typename KeyType, typename ValueType>
+ValueType SampleKeys(const KeyType *keys, unsigned int numKeys, double time, ValueType (*lerp)(const ValueType &, const ValueType &, ai_real)) {
+    unsigned int i = 0;
+    while (i + 1 < numKeys && keys[i + 1].mTime <= time) {
+        ++i;
+    }
+    if (i + 1 == numKeys || keys[i].mTime >= time) {
+        return keys[i].mValue;
+    }
+    const ai_real factor = static_cast<ai_real>((time - keys[i].mTime) / (keys[i + 1].mTime - keys[i].mTime));
+    return lerp(keys[i].mValue, keys[i + 1].mValue, factor);
+}
+
+aiVector3D LerpVector(const aiVector3D &a, const aiVector3D &b, ai_real factor) {
+    return a + (b - a) * factor;
+}
+
+aiQuaternion SlerpQuaternion(const aiQuaternion &a, const aiQuaternion &b, ai_real factor) {
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, a, b, factor);
+    return out;
+}
+
+ai_real RotationAngle(const aiQuaternion &a, const aiQuaternion &b) {
+    const ai_real dot = std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+    return 2 * std::acos(std::min(dot, ai_real(1.0)));
+}
+
+} // namespace
+
+TEST_F(utFBXImporterExporter, importAnimationKeyReduction) {
+    const float tolerance = 1e-3f, rotationTolerance = 2e-3f;
+
+    // the reduced curves are compared against the exact values, leave some room for rounding
+    const ai_real epsilon = static_cast<ai_real>(1e-5);
+
+    Assimp::Importer full;
+    const aiScene *expected = full.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+    ASSERT_TRUE(expected->HasAnimations());
+
+    Assimp::Importer reduced;
+    reduced.SetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_KEY_TOLERANCE, tolerance);
+    reduced.SetPropertyFloat(AI_CONFIG_IMPORT_FBX_ANIMATION_ROTATION_KEY_TOLERANCE, rotationTolerance);
+    const aiScene *scene = reduced.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumAnimations, scene->mNumAnimations);
+    unsigned int numFull = 0, numReduced = 0;
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        const aiAnimation *a = expected->mAnimations[i], *b = scene->mAnimations[i];
+        EXPECT_EQ(a->mDuration, b->mDuration);
+        ASSERT_EQ(a->mNumChannels, b->mNumChannels);
+        for (unsigned int j = 0; j < b->mNumChannels; ++j) {
+            const aiNodeAnim *ca = a->mChannels[j], *cb = b->mChannels[j];
+            ASSERT_LE(cb->mNumPositionKeys, ca->mNumPositionKeys);
+            ASSERT_LE(cb->mNumRotationKeys, ca->mNumRotationKeys);
+            ASSERT_LE(cb->mNumScalingKeys, ca->mNumScalingKeys);
+            ASSERT_GT(cb->mNumPositionKeys, 0u);
+            ASSERT_GT(cb->mNumRotationKeys, 0u);
+            ASSERT_GT(cb->mNumScalingKeys, 0u);
+
+            // the end points are kept
+            EXPECT_EQ(ca->mPositionKeys[0].mTime, cb->mPositionKeys[0].mTime);
+            EXPECT_EQ(ca->mPositionKeys[ca->mNumPositionKeys - 1].mTime, cb->mPositionKeys[cb->mNumPositionKeys - 1].mTime);
+
+            // the reduced curves reproduce every original key within the tolerances
+            for (unsigned int k = 0; k < ca->mNumPositionKeys; ++k) {
+                const aiVectorKey &key = ca->mPositionKeys[k];
+                const aiVector3D value = SampleKeys(cb->mPositionKeys, cb->mNumPositionKeys, key.mTime, &LerpVector);
+                EXPECT_LE((value - key.mValue).Length(), tolerance + epsilon);
+            }
+            for (unsigned int k = 0; k < ca->mNumScalingKeys; ++k) {
+                const aiVectorKey &key = ca->mScalingKeys[k];
+                const aiVector3D value = SampleKeys(cb->mScalingKeys, cb->mNumScalingKeys, key.mTime, &LerpVector);
+                EXPECT_LE((value - key.mValue).Length(), tolerance + epsilon);
+            }
+            for (unsigned int k = 0; k < ca->mNumRotationKeys; ++k) {
+                const aiQuatKey &key = ca->mRotationKeys[k];
+                const aiQuaternion value = SampleKeys(cb->mRotationKeys, cb->mNumRotationKeys, key.mTime, &SlerpQuaternion);
+                EXPECT_LE(RotationAngle(value, key.mValue), rotationTolerance + epsilon);
+            }
+
+            numFull += ca->mNumPositionKeys + ca->mNumRotationKeys + ca->mNumScalingKeys;
+            numReduced += cb->mNumPositionKeys + cb->mNumRotationKeys + cb->mNumScalingKeys;
+        }
+    }
+    EXPECT_LT(numReduced, numFull);
+}
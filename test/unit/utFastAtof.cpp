@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/fast_atof.h>
+#include <assimp/ParsingUtils.h>
 
 namespace {
 
@@ -188,3 +189,85 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+struct FastAtorealRangeWrapper {
+    ai_real operator()(const char* str) {
+        ai_real value;
+        Assimp::fast_atoreal_move<ai_real>(str, str + strlen(str), value);
+        return value;
+    }
+};
+
+TEST_F(FastAtofTest, FastAtorealRange)
+{
+    RunTest<ai_real>(FastAtorealRangeWrapper());
+}
+
+TEST_F(FastAtofTest, FastAtorealArrayIsExact)
+{
+    const char data[] = "  1.354\t-345554.54e-5 34563.65683598734\n.125 -.1e+9 12345678901234567.890123456789 "
+                        "5.300 1e-307 400012 inf nan 0.000001e-301";
+    const size_t Count = 12;
+    double values[Count + 1];
+    const char* c = data;
+    EXPECT_EQ(Count, Assimp::fast_atoreal_array<double>(&c, data + strlen(data), values, Count + 1));
+    EXPECT_EQ(data + strlen(data), c);
+
+    c = data;
+    for (size_t i = 0; i < Count; ++i) {
+        double expected;
+        while (Assimp::IsSpaceOrNewLine(*c)) {
+            ++c;
+        }
+        c = Assimp::fast_atoreal_move<double>(c, expected);
+        if (IsNan(expected)) {
+            EXPECT_TRUE(IsNan(values[i]));
+        } else {
+            EXPECT_EQ(0, memcmp(&expected, &values[i], sizeof(double))) << i;
+        }
+    }
+}
+
+TEST_F(FastAtofTest, FastAtorealArraySeparators)
+{
+    const char data[] = "1.5,2.5, 3,4\n";
+    float values[4];
+    const char* c = data;
+    EXPECT_EQ(4U, Assimp::fast_atoreal_array<float>(&c, data + strlen(data), values, 4, false));
+    EXPECT_EQ(1.5f, values[0]);
+    EXPECT_EQ(2.5f, values[1]);
+    EXPECT_EQ(3.0f, values[2]);
+    EXPECT_EQ(4.0f, values[3]);
+
+    // only count values are parsed
+    c = data;
+    EXPECT_EQ(2U, Assimp::fast_atoreal_array<float>(&c, data + strlen(data), values, 2, false));
+    EXPECT_EQ(',', *c);
+
+    // with check_comma the comma is a decimal point
+    c = "1,5 2";
+    EXPECT_EQ(2U, Assimp::fast_atoreal_array<float>(&c, c + 5, values, 4));
+    EXPECT_EQ(1.5f, values[0]);
+    EXPECT_EQ(2.0f, values[1]);
+
+    c = "1.0 x";
+    EXPECT_THROW(Assimp::fast_atoreal_array<float>(&c, c + 5, values, 2), DeadlyImportError);
+}
+
+TEST_F(FastAtofTest, Strtol10Array)
+{
+    const char data[] = "0 1 -22, +333 123456789 -2147483647 4444444444";
+    int values[8];
+    const char* c = data;
+    ASSERT_EQ(7U, Assimp::strtol10_array(&c, data + strlen(data), values, 8));
+    EXPECT_EQ(0, values[0]);
+    EXPECT_EQ(1, values[1]);
+    EXPECT_EQ(-22, values[2]);
+    EXPECT_EQ(333, values[3]);
+    EXPECT_EQ(123456789, values[4]);
+    EXPECT_EQ(-2147483647, values[5]);
+    EXPECT_EQ(Assimp::strtol10("4444444444"), values[6]);
+
+    c = "1 -";
+    EXPECT_THROW(Assimp::strtol10_array(&c, c + 3, values, 8), DeadlyImportError);
+}
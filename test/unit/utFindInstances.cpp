@@ -0,0 +1,166 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/FindInstancesProcess.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utFindInstances : public ::testing::Test {
+protected:
+    // an irregular strip of triangles, placed with the given transformation
+    static aiMesh *createMesh(const aiMatrix4x4 &transform) {
+        static const unsigned int NumVertices = 12;
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = NumVertices;
+        mesh->mVertices = new aiVector3D[NumVertices];
+        mesh->mNormals = new aiVector3D[NumVertices];
+        const aiMatrix3x3 rotation(transform);
+        for (unsigned int i = 0; i < NumVertices; ++i) {
+            const aiVector3D p((ai_real)i, (ai_real)(i % 2) * 2 + (ai_real)(i % 3) * (ai_real)0.3, (ai_real)(i * i % 5) * (ai_real)0.1);
+            mesh->mVertices[i] = transform * p;
+            mesh->mNormals[i] = rotation * aiVector3D(0, (ai_real)(i % 2), 1).Normalize();
+        }
+        mesh->mNumFaces = NumVertices - 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f].mIndices = new unsigned int[3];
+            mesh->mFaces[f].mIndices[0] = f;
+            mesh->mFaces[f].mIndices[1] = f + 1 + f % 2;
+            mesh->mFaces[f].mIndices[2] = f + 2 - f % 2;
+        }
+        return mesh;
+    }
+
+    // a scene with one node per mesh
+    static aiScene *createScene(const std::vector<aiMesh *> &meshes) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+        scene->mMeshes = new aiMesh *[meshes.size()];
+        std::copy(meshes.begin(), meshes.end(), scene->mMeshes);
+        scene->mRootNode = new aiNode("root");
+        std::vector<aiNode *> children;
+        for (unsigned int i = 0; i < meshes.size(); ++i) {
+            aiNode *child = new aiNode("node" + std::to_string(i));
+            child->mNumMeshes = 1;
+            child->mMeshes = new unsigned int[1];
+            child->mMeshes[0] = i;
+            children.push_back(child);
+        }
+        scene->mRootNode->addChildren(static_cast<unsigned int>(children.size()), &children[0]);
+        return scene;
+    }
+
+    static void execute(aiScene *scene, bool rigid) {
+        Importer importer;
+        importer.SetPropertyBool(AI_CONFIG_PP_FI_RIGID_TRANSFORMS, rigid);
+        FindInstancesProcess process;
+        process.SetupProperties(&importer);
+        process.Execute(scene);
+    }
+
+    static aiMatrix4x4 rigidTransform() {
+        aiMatrix4x4 rotation, translation;
+        aiMatrix4x4::Rotation((ai_real)0.7, aiVector3D(1, 2, 3).Normalize(), rotation);
+        aiMatrix4x4::Translation(aiVector3D(100, -20, 5), translation);
+        return translation * rotation;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstances, identicalMeshes) {
+    aiScene *scene = createScene({ createMesh(aiMatrix4x4()), createMesh(rigidTransform()), createMesh(aiMatrix4x4()) });
+    execute(scene, false);
+
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    EXPECT_EQ(0u, scene->mRootNode->mChildren[0]->mMeshes[0]);
+    EXPECT_EQ(1u, scene->mRootNode->mChildren[1]->mMeshes[0]);
+    EXPECT_EQ(0u, scene->mRootNode->mChildren[2]->mMeshes[0]);
+    EXPECT_EQ(0u, scene->mRootNode->mChildren[2]->mNumChildren);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstances, rigidlyTransformedMeshes) {
+    const aiMatrix4x4 transform = rigidTransform();
+    aiMatrix4x4 mirror;
+    mirror.a1 = -1;
+    aiScene *scene = createScene({ createMesh(aiMatrix4x4()), createMesh(transform), createMesh(mirror) });
+    execute(scene, true);
+
+    // the mirrored copy is no rigid instance
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    const aiNode *node = scene->mRootNode->mChildren[1];
+    EXPECT_EQ(0u, node->mNumMeshes);
+    ASSERT_EQ(1u, node->mNumChildren);
+    const aiNode *instance = node->mChildren[0];
+    EXPECT_EQ(node, instance->mParent);
+    ASSERT_EQ(1u, instance->mNumMeshes);
+    EXPECT_EQ(0u, instance->mMeshes[0]);
+    EXPECT_TRUE(instance->mTransformation.Equal(transform, (ai_real)1e-3));
+    EXPECT_EQ(1u, scene->mRootNode->mChildren[2]->mMeshes[0]);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstances, skinnedMeshes) {
+    aiMesh *meshes[2] = { createMesh(aiMatrix4x4()), createMesh(aiMatrix4x4()) };
+    for (aiMesh *mesh : meshes) {
+        mesh->mNumBones = 1;
+        mesh->mBones = new aiBone *[1];
+        mesh->mBones[0] = new aiBone();
+        mesh->mBones[0]->mName.Set("bone");
+        mesh->mBones[0]->mNumWeights = 1;
+        mesh->mBones[0]->mWeights = new aiVertexWeight[1];
+        mesh->mBones[0]->mWeights[0] = aiVertexWeight(3, 1);
+    }
+    aiScene *scene = createScene({ meshes[0], meshes[1] });
+    execute(scene, true);
+
+    EXPECT_EQ(1u, scene->mNumMeshes);
+    delete scene;
+}
@@ -0,0 +1,201 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenMeshletsProcess.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/cimport.h>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utGenMeshletsProcess : public ::testing::Test {
+protected:
+    static const unsigned int Size = 32;
+
+    // a flat Size x Size grid of quads in the xy plane, facing +z
+    static aiMesh *createGrid() {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = (Size + 1) * (Size + 1);
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int y = 0; y <= Size; ++y) {
+            for (unsigned int x = 0; x <= Size; ++x) {
+                mesh->mVertices[y * (Size + 1) + x] = aiVector3D((ai_real)x, (ai_real)y, 0);
+            }
+        }
+
+        mesh->mNumFaces = Size * Size * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        unsigned int f = 0;
+        for (unsigned int y = 0; y < Size; ++y) {
+            for (unsigned int x = 0; x < Size; ++x) {
+                const unsigned int v = y * (Size + 1) + x;
+                const unsigned int quad[2][3] = { { v, v + 1, v + Size + 2 }, { v, v + Size + 2, v + Size + 1 } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    mesh->mFaces[f].mNumIndices = 3;
+                    mesh->mFaces[f].mIndices = new unsigned int[3];
+                    std::copy(quad[t], quad[t] + 3, mesh->mFaces[f].mIndices);
+                }
+            }
+        }
+        return mesh;
+    }
+
+    // checks that every face is in exactly one meshlet and that the limits and bounds hold
+    static void checkMeshlets(const aiMesh *mesh, unsigned int maxVertices, unsigned int maxTriangles) {
+        const aiMeshlets *meshlets = mesh->mMeshlets;
+        ASSERT_NE(nullptr, meshlets);
+        EXPECT_EQ(mesh->mNumFaces, meshlets->mNumTriangles);
+
+        std::vector<unsigned int> found(mesh->mNumFaces, 0);
+        for (unsigned int i = 0; i < meshlets->mNumMeshlets; ++i) {
+            const aiMeshlet &m = meshlets->mMeshlets[i];
+            EXPECT_GT(m.mNumTriangles, 0u);
+            EXPECT_LE(m.mNumTriangles, maxTriangles);
+            EXPECT_LE(m.mNumVertices, maxVertices);
+
+            for (unsigned int v = 0; v < m.mNumVertices; ++v) {
+                const aiVector3D &p = mesh->mVertices[meshlets->mVertices[m.mVertexOffset + v]];
+                EXPECT_LE((p - m.mCenter).Length(), m.mRadius * (ai_real)1.0001);
+            }
+
+            for (unsigned int t = 0; t < m.mNumTriangles; ++t) {
+                unsigned int idx[3];
+                ASSERT_EQ(aiReturn_SUCCESS, aiGetMeshletTriangle(mesh, i, t, idx));
+
+                // find the face with the same indices
+                for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                    if (std::equal(idx, idx + 3, mesh->mFaces[f].mIndices)) {
+                        ++found[f];
+                        break;
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(found.end(), std::find_if(found.begin(), found.end(), [](unsigned int n) { return n != 1; }));
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, gridIsPartitioned) {
+    aiMesh *mesh = createGrid();
+    mesh->mMeshlets = GenMeshletsProcess::BuildMeshlets(mesh, 64, 124);
+    checkMeshlets(mesh, 64, 124);
+
+    // 64 vertices allow about 7x7 quads per meshlet
+    EXPECT_LE(mesh->mMeshlets->mNumMeshlets, mesh->mNumFaces / 60);
+
+    // all triangles face +z, so the cones are as narrow as possible
+    for (unsigned int i = 0; i < aiGetMeshletCount(mesh); ++i) {
+        const aiMeshlet *m = aiGetMeshlet(mesh, i);
+        ASSERT_NE(nullptr, m);
+        EXPECT_NEAR(1, m->mConeAxis.z, 1e-5);
+        EXPECT_NEAR(0, m->mConeCutoff, 1e-3);
+    }
+    EXPECT_EQ(nullptr, aiGetMeshlet(mesh, aiGetMeshletCount(mesh)));
+    unsigned int idx[3];
+    EXPECT_EQ(aiReturn_FAILURE, aiGetMeshletTriangle(mesh, 0, 124, idx));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, smallLimits) {
+    aiMesh *mesh = createGrid();
+    mesh->mMeshlets = GenMeshletsProcess::BuildMeshlets(mesh, 3, 124);
+    checkMeshlets(mesh, 3, 124);
+    EXPECT_EQ(mesh->mNumFaces, mesh->mMeshlets->mNumMeshlets);
+
+    delete mesh->mMeshlets;
+    mesh->mMeshlets = GenMeshletsProcess::BuildMeshlets(mesh, 255, 7);
+    checkMeshlets(mesh, 255, 7);
+    EXPECT_EQ((mesh->mNumFaces + 6) / 7, mesh->mMeshlets->mNumMeshlets);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, processAndCopy) {
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = createGrid();
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_MESHLET_GENERATE, true);
+    importer.SetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_VERTICES, 32);
+    importer.SetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_TRIANGLES, 40);
+    GenMeshletsProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(scene);
+    checkMeshlets(scene->mMeshes[0], 32, 40);
+
+    aiMesh *copy = nullptr;
+    SceneCombiner::Copy(&copy, scene->mMeshes[0]);
+    ASSERT_NE(nullptr, copy->mMeshlets);
+    EXPECT_NE(scene->mMeshes[0]->mMeshlets, copy->mMeshlets);
+    EXPECT_EQ(scene->mMeshes[0]->mMeshlets->mNumMeshlets, copy->mMeshlets->mNumMeshlets);
+    checkMeshlets(copy, 32, 40);
+    delete copy;
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshletsProcess, enabledByItsOwnKey) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_EQ(nullptr, scene->mMeshes[i]->mMeshlets);
+    }
+
+    // no aiProcess_JoinIdenticalVertices needed
+    importer.SetPropertyBool(AI_CONFIG_PP_MESHLET_GENERATE, true);
+    scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        ASSERT_NE(nullptr, scene->mMeshes[i]->mMeshlets);
+        EXPECT_LT(0u, scene->mMeshes[i]->mMeshlets->mNumMeshlets);
+    }
+}
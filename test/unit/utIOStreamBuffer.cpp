@@ -140,6 +140,60 @@ TEST_F( IOStreamBufferTest, readlineTest ) {
     EXPECT_TRUE( myBuffer.close() );
 }
 
+const char lineData[]{"first line\r\nsecond \\\nline\nthis line is longer than the cache\n\nlast"};
+
+TEST_F( IOStreamBufferTest, readLineViewTest ) {
+    char fname[]={ "lineviewtest.XXXXXX" };
+    auto* fs = MakeTmpFile(fname);
+    ASSERT_NE(nullptr, fs);
+    std::fwrite( lineData, sizeof(*lineData), strlen( lineData ), fs );
+    std::fclose(fs);
+    fs = std::fopen(fname, "rb");
+    ASSERT_NE(nullptr, fs);
+    {
+        TestDefaultIOStream myStream( fs, fname );
+        IOStreamBuffer<char> myBuffer( 8 );
+        EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+        const char *expected[] = { "first line", "second line", "this line is longer than the cache", "", "last" };
+        char *begin = nullptr, *end = nullptr;
+        for ( const char *line : expected ) {
+            ASSERT_TRUE( myBuffer.getNextDataLine( begin, end, '\\' ) );
+            EXPECT_EQ( std::string( line ), std::string( begin, end ) );
+            EXPECT_TRUE( IsLineEnd( *end ) );
+        }
+        EXPECT_FALSE( myBuffer.getNextDataLine( begin, end, '\\' ) );
+        EXPECT_TRUE( myBuffer.close() );
+    }
+    remove(fname);
+}
+
+TEST_F( IOStreamBufferTest, readNonEmptyLineViewTest ) {
+    char fname[]={ "lineviewtest.XXXXXX" };
+    auto* fs = MakeTmpFile(fname);
+    ASSERT_NE(nullptr, fs);
+    std::fwrite( lineData, sizeof(*lineData), strlen( lineData ), fs );
+    std::fclose(fs);
+    fs = std::fopen(fname, "rb");
+    ASSERT_NE(nullptr, fs);
+    {
+        TestDefaultIOStream myStream( fs, fname );
+        IOStreamBuffer<char> myBuffer( 8 );
+        EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+        // no line continuation, empty lines are skipped
+        const char *expected[] = { "first line", "second \\", "line", "this line is longer than the cache", "last" };
+        char *begin = nullptr, *end = nullptr;
+        for ( const char *line : expected ) {
+            ASSERT_TRUE( myBuffer.getNextLine( begin, end ) );
+            EXPECT_EQ( std::string( line ), std::string( begin, end ) );
+        }
+        EXPECT_FALSE( myBuffer.getNextLine( begin, end ) );
+        EXPECT_TRUE( myBuffer.close() );
+    }
+    remove(fname);
+}
+
 TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/cimport.h>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -361,3 +363,100 @@ TEST_F(ImporterTest, unexpectedException) {
         EXPECT_TRUE(false);
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, multithreadedPostProcessingIsDeterministic) {
+    const unsigned int flags =
+            aiProcess_Triangulate |
+            aiProcess_JoinIdenticalVertices |
+            aiProcess_GenSmoothNormals |
+            aiProcess_CalcTangentSpace |
+            aiProcess_ImproveCacheLocality |
+            aiProcess_FindDegenerates |
+            aiProcess_LimitBoneWeights |
+            aiProcess_ValidateDataStructure;
+
+    const aiScene *expected = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_NE(nullptr, expected);
+
+    Importer parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    const aiScene *scene = parallel.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i];
+        const aiMesh *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices * sizeof(aiVector3D)));
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        if (a->HasNormals()) {
+            EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices * sizeof(aiVector3D)));
+        }
+        ASSERT_EQ(a->HasTangentsAndBitangents(), b->HasTangentsAndBitangents());
+        if (a->HasTangentsAndBitangents()) {
+            EXPECT_EQ(0, memcmp(a->mTangents, b->mTangents, a->mNumVertices * sizeof(aiVector3D)));
+        }
+        for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+            ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+            EXPECT_EQ(0, memcmp(a->mFaces[f].mIndices, b->mFaces[f].mIndices, a->mFaces[f].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, readFileAsync) {
+    std::future<const aiScene *> result = pImp->ReadFileAsync(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    const aiScene *scene = result.get();
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(scene, pImp->GetScene());
+
+    Importer expected;
+    ASSERT_NE(nullptr, expected.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate));
+    EXPECT_EQ(expected.GetScene()->mNumMeshes, scene->mNumMeshes);
+}
+
+namespace {
+// Cancels the import at its first progress report
+class CancellingProgressHandler : public ProgressHandler {
+public:
+    explicit CancellingProgressHandler(Importer *importer) :
+            mImporter(importer) {}
+
+    bool Update(float) override {
+        mImporter->CancelReadFile();
+        return false;
+    }
+
+private:
+    Importer *mImporter;
+};
+} // namespace
+
+TEST_F(ImporterTest, cancelReadFile) {
+    pImp->SetProgressHandler(new CancellingProgressHandler(pImp));
+    const aiScene *scene = pImp->ReadFileAsync(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate).get();
+    EXPECT_EQ(nullptr, scene);
+    EXPECT_STREQ("Import cancelled", pImp->GetErrorString());
+
+    // the request is consumed by the cancelled import
+    pImp->SetProgressHandler(nullptr);
+    pImp->CancelReadFile();
+    EXPECT_NE(nullptr, pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate));
+}
+
+TEST_F(ImporterTest, importFileAsyncCApi) {
+    aiImportHandle *handle = aiImportFileAsync(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate, nullptr);
+    ASSERT_NE(nullptr, handle);
+    const aiScene *scene = aiWaitForImport(handle);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_LT(0u, scene->mNumMeshes);
+    aiReleaseImport(scene);
+
+    handle = aiImportFileAsync(ASSIMP_TEST_MODELS_DIR "/OBJ/does_not_exist.obj", 0, nullptr);
+    ASSERT_NE(nullptr, handle);
+    EXPECT_EQ(nullptr, aiWaitForImport(handle));
+    EXPECT_STRNE("", aiGetErrorString());
+}
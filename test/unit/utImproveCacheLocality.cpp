@@ -40,3 +40,170 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "UnitTestPCH.h"
+
+#include "PostProcessing/ImproveCacheLocality.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/importstatistics.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace Assimp;
+
+class utImproveCacheLocality : public ::testing::Test {
+protected:
+    // a Size x Size grid of quads, split into triangles which are shuffled
+    static const unsigned int Size = 30;
+
+    virtual void SetUp() {
+        const unsigned int numVertices = (Size + 1) * (Size + 1);
+        mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = numVertices;
+        mesh->mVertices = new aiVector3D[numVertices];
+        mesh->mColors[0] = new aiColor4D[numVertices];
+        for (unsigned int v = 0; v < numVertices; ++v) {
+            mesh->mVertices[v] = aiVector3D(static_cast<ai_real>(v % (Size + 1)), static_cast<ai_real>(v / (Size + 1)), 0);
+            mesh->mColors[0][v] = aiColor4D(static_cast<float>(v), 0, 0, 1);
+        }
+
+        std::vector<std::array<unsigned int, 3>> triangles;
+        for (unsigned int y = 0; y < Size; ++y) {
+            for (unsigned int x = 0; x < Size; ++x) {
+                const unsigned int v = y * (Size + 1) + x;
+                triangles.push_back({ { v, v + 1, v + Size + 2 } });
+                triangles.push_back({ { v, v + Size + 2, v + Size + 1 } });
+            }
+        }
+        unsigned int seed = 1;
+        for (size_t i = triangles.size() - 1; i > 0; --i) {
+            seed = seed * 1103515245u + 12345u;
+            std::swap(triangles[i], triangles[(seed >> 8) % (i + 1)]);
+        }
+
+        mesh->mNumFaces = static_cast<unsigned int>(triangles.size());
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f].mIndices = new unsigned int[3];
+            std::copy(triangles[f].begin(), triangles[f].end(), mesh->mFaces[f].mIndices);
+        }
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+    }
+
+    // the triangles of the mesh by original vertex index, order independent
+    std::vector<std::array<unsigned int, 3>> getTriangles() const {
+        std::vector<std::array<unsigned int, 3>> triangles;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            std::array<unsigned int, 3> tri;
+            for (unsigned int k = 0; k < 3; ++k) {
+                tri[k] = static_cast<unsigned int>(mesh->mColors[0][mesh->mFaces[f].mIndices[k]].r);
+            }
+            std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+            triangles.push_back(tri);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    aiMesh *mesh = nullptr;
+    ImproveCacheLocalityProcess process;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, reducesCacheMisses) {
+    const std::vector<std::array<unsigned int, 3>> before = getTriangles();
+    const ImproveCacheLocalityProcess::MeshStatistics stats = process.ProcessMesh(mesh, 0);
+
+    ASSERT_EQ(mesh->mNumFaces, stats.mNumFaces);
+    EXPECT_EQ(mesh->mNumVertices, stats.mNumVertices);
+    EXPECT_LT(stats.mMissesOut, stats.mMissesIn);
+    EXPECT_LT(stats.mMissesOut / static_cast<float>(stats.mNumFaces), 0.8f);
+
+    // the same triangles with the same winding are left
+    EXPECT_EQ(before, getTriangles());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, vertexFetchOrder) {
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone *[1];
+    aiBone *bone = mesh->mBones[0] = new aiBone();
+    bone->mNumWeights = 2;
+    bone->mWeights = new aiVertexWeight[2];
+    bone->mWeights[0] = aiVertexWeight(0, 0.25f);
+    bone->mWeights[1] = aiVertexWeight(Size * 2, 0.5f);
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_ICL_VERTEX_FETCH, true);
+    process.SetupProperties(&importer);
+    process.ProcessMesh(mesh, 0);
+
+    // vertices are numbered in the order of first use
+    unsigned int next = 0;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = mesh->mFaces[f].mIndices[k];
+            ASSERT_LE(v, next);
+            next = std::max(next, v + 1);
+        }
+    }
+
+    // all streams and the bone weights moved along
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        const unsigned int original = static_cast<unsigned int>(mesh->mColors[0][v].r);
+        EXPECT_EQ(static_cast<ai_real>(original % (Size + 1)), mesh->mVertices[v].x);
+        EXPECT_EQ(static_cast<ai_real>(original / (Size + 1)), mesh->mVertices[v].y);
+    }
+    EXPECT_EQ(0.f, mesh->mColors[0][bone->mWeights[0].mVertexId].r);
+    EXPECT_EQ(Size * 2.f, mesh->mColors[0][bone->mWeights[1].mVertexId].r);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, overdrawKeepsTriangles) {
+    Importer importer;
+    importer.SetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD, 1.05f);
+    process.SetupProperties(&importer);
+
+    const std::vector<std::array<unsigned int, 3>> before = getTriangles();
+    const ImproveCacheLocalityProcess::MeshStatistics stats = process.ProcessMesh(mesh, 0);
+
+    ASSERT_EQ(mesh->mNumFaces, stats.mNumFaces);
+    EXPECT_LT(stats.mMissesOut, stats.mMissesIn);
+    EXPECT_EQ(before, getTriangles());
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        EXPECT_EQ(static_cast<float>(v), mesh->mColors[0][v].r);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, reportsStatistics) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality);
+    ASSERT_NE(nullptr, scene);
+
+    const aiImportStatistics *stats = importer.GetImportStatistics();
+    ASSERT_NE(nullptr, stats);
+    double acmrIn = 0, acmrOut = 0;
+    for (unsigned int i = 0; i < stats->mNumMetrics; ++i) {
+        const aiProfileMetric &metric = stats->mMetrics[i];
+        EXPECT_STREQ("ImproveCacheLocalityProcess", stats->mRegions[metric.mRegion].mName.C_Str());
+        if (0 == strcmp("ACMR in", metric.mName.C_Str())) {
+            acmrIn = metric.mValue;
+        } else if (0 == strcmp("ACMR out", metric.mName.C_Str())) {
+            acmrOut = metric.mValue;
+        }
+    }
+    EXPECT_GT(acmrIn, 0.0);
+    EXPECT_GT(acmrOut, 0.0);
+    EXPECT_LE(acmrOut, acmrIn);
+}
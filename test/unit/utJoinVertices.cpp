@@ -140,3 +140,51 @@ TEST_F(utJoinVertices, testProcess) {
     }
     EXPECT_EQ(150.f * 299.f * 3.f, fSum); // gaussian sum equation
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testExactMatchProcess) {
+    piProcess->SetExactMatch(true);
+    piProcess->ProcessMesh(pcMesh, 0);
+
+    // bitwise identical copies are joined just as in the default mode
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    float fSum = 0.f;
+    for (unsigned int i = 0; i < 300; ++i) {
+        aiVector3D &v = pcMesh->mVertices[i];
+        fSum += v.x + v.y + v.z;
+    }
+    EXPECT_EQ(150.f * 299.f * 3.f, fSum);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testExactMatchKeepsDistinctVertices) {
+    // nudge the third copy of each vertex and give all but the last
+    // vertex of the second copy a bone, that one gets a signed zero instead
+    for (unsigned int a = 0; a < 300; ++a) {
+        pcMesh->mVertices[600 + a].x += 1e-6f * (a + 1);
+    }
+    pcMesh->mNormals[599].z = -0.f;
+
+    pcMesh->mNumBones = 1;
+    pcMesh->mBones = new aiBone *[1];
+    aiBone *bone = pcMesh->mBones[0] = new aiBone();
+    bone->mNumWeights = 299;
+    bone->mWeights = new aiVertexWeight[299];
+    for (unsigned int a = 0; a < 299; ++a) {
+        bone->mWeights[a] = aiVertexWeight(300 + a, 1.f);
+    }
+
+    piProcess->SetExactMatch(true);
+    piProcess->ProcessMesh(pcMesh, 0);
+
+    // only the signed zero vertex is joined with its first copy
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(899U, pcMesh->mNumVertices);
+    EXPECT_EQ(299U, bone->mNumWeights);
+    EXPECT_EQ(299U, pcMesh->mFaces[199].mIndices[2]);
+    for (unsigned int i = 600; i < 900; ++i) {
+        EXPECT_EQ(i - 1, pcMesh->mFaces[i / 3].mIndices[i % 3]);
+    }
+}
@@ -0,0 +1,134 @@
+/*-------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+-------------------------------------------------------------------------*/
+#include "UnitTestPCH.h"
+#include "UnitTestFileGenerator.h"
+
+#include <assimp/IOStreamView.h>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace Assimp;
+
+class utMemoryMappedIOSystem : public ::testing::Test {
+    // empty
+};
+
+static const char MappedData[] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit.";
+
+TEST_F(utMemoryMappedIOSystem, readMappedFileTest) {
+    char fpath[] = { TMP_PATH "mmapfp.XXXXXX" };
+    FILE *fs = MakeTmpFile(fpath);
+    ASSERT_NE(nullptr, fs);
+    const size_t len = sizeof(MappedData) - 1;
+    EXPECT_EQ(len, std::fwrite(MappedData, 1, len, fs));
+    std::fclose(fs);
+
+    MemoryMappedIOSystem io;
+    IOStream *stream = io.Open(fpath, "rb");
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(len, stream->FileSize());
+    ASSERT_NE(nullptr, stream->GetReadOnlyView());
+    EXPECT_EQ(0, ::memcmp(MappedData, stream->GetReadOnlyView(), len));
+
+    char buffer[6] = {};
+    EXPECT_EQ(AI_SUCCESS, stream->Seek(6, aiOrigin_SET));
+    EXPECT_EQ(5u, stream->Read(buffer, 1, 5));
+    EXPECT_STREQ("ipsum", buffer);
+    EXPECT_EQ(11u, stream->Tell());
+    EXPECT_EQ(0u, stream->Write(buffer, 1, 5));
+
+    IOStreamView view;
+    EXPECT_TRUE(view.load(stream, false));
+    EXPECT_TRUE(view.isMapped());
+    EXPECT_EQ(len, view.size());
+
+    EXPECT_TRUE(view.load(stream, true));
+    EXPECT_FALSE(view.isMapped());
+    EXPECT_EQ(len, view.size());
+    EXPECT_EQ('\0', view.data()[len]);
+    io.Close(stream);
+
+    // write access is not mapped
+    stream = io.Open(fpath, "r+b");
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(nullptr, stream->GetReadOnlyView());
+    EXPECT_TRUE(view.load(stream, false));
+    EXPECT_FALSE(view.isMapped());
+    EXPECT_EQ(len, view.size());
+    EXPECT_EQ(0, ::memcmp(MappedData, view.data(), len));
+    io.Close(stream);
+
+    std::remove(fpath);
+}
+
+TEST_F(utMemoryMappedIOSystem, memoryStreamViewTest) {
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(MappedData), sizeof(MappedData));
+    IOStreamView view;
+    EXPECT_TRUE(view.load(&stream, false));
+    EXPECT_TRUE(view.isMapped());
+    EXPECT_EQ(static_cast<const void *>(MappedData), static_cast<const void *>(view.data()));
+}
+
+TEST_F(utMemoryMappedIOSystem, importFromMappedFilesTest) {
+    static const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/FBX/box.fbx",
+        ASSIMP_TEST_MODELS_DIR "/FBX/embedded_ascii/box.FBX",
+        ASSIMP_TEST_MODELS_DIR "/Collada/duck.dae"
+    };
+    for (const char *file : files) {
+        Importer importer;
+        importer.SetIOHandler(new MemoryMappedIOSystem);
+        const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+        EXPECT_NE(nullptr, scene) << file;
+
+        Importer reference;
+        const aiScene *expected = reference.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, expected) << file;
+        ASSERT_NE(nullptr, scene) << file;
+        EXPECT_EQ(expected->mNumMeshes, scene->mNumMeshes) << file;
+    }
+}
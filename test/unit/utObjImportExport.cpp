@@ -325,6 +325,42 @@ TEST_F(utObjImportExport, relative_indices_Test) {
     }
 }
 
+TEST_F(utObjImportExport, missing_components_default_to_zero_Test) {
+    static const char *curObjModel =
+            "v 0.0 0.0 0.0\n"
+            "v 1.0 0.0 0.0\n"
+            "v 0.0 1.0 0.0\n"
+            "vn 0.0 1.0\n"
+            "vn 0.0 0.0 1.0\n"
+            "vn 1.0\n"
+            "f 1//1 2//2 3//3\nB";
+
+    Assimp::Importer myimporter;
+    const aiScene *scene = myimporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(scene->mNumMeshes, 1U);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(mesh->mNumVertices, 3U);
+    ASSERT_TRUE(mesh->HasNormals());
+    EXPECT_EQ(aiVector3D(0.0, 1.0, 0.0), mesh->mNormals[0]);
+    EXPECT_EQ(aiVector3D(0.0, 0.0, 1.0), mesh->mNormals[1]);
+    EXPECT_EQ(aiVector3D(1.0, 0.0, 0.0), mesh->mNormals[2]);
+}
+
+TEST_F(utObjImportExport, unparsable_component_Test) {
+    static const char *curObjModel =
+            "v 0.0 0.0 0.0\n"
+            "v 1.0 0.0 0.0\n"
+            "v 0.0 1.0 0.0\n"
+            "vn 0.0 x 1.0\n"
+            "f 1//1 2//1 3//1\nB";
+
+    Assimp::Importer myimporter;
+    const aiScene *scene = myimporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
+    EXPECT_EQ(nullptr, scene);
+}
+
 TEST_F(utObjImportExport, homogeneous_coordinates_Test) {
     static const char *curObjModel =
             "v -0.500000 0.000000 0.400000 0.50000\n"
@@ -140,6 +140,28 @@ TEST_F(utPLYImportExport, vertexColorTest) {
     EXPECT_EQ(2u, first_face.mIndices[2]);
 }
 
+TEST_F(utPLYImportExport, importContiguousFaceIndices) {
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/cube_uv.ply", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    // six quads, stored back to back
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(6u, mesh->mNumFaces);
+    ASSERT_NE(nullptr, mesh->mIndexBuffer);
+    EXPECT_EQ(24u, mesh->mIndexBufferSize);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        EXPECT_EQ(mesh->mIndexBuffer + i * 4, mesh->mFaces[i].mIndices);
+    }
+    EXPECT_TRUE(mesh->HasTextureCoords(0));
+
+    // triangulation reuses the quads' index arrays for one of the triangles
+    scene = importer.ApplyPostProcessing(aiProcess_Triangulate | aiProcess_SplitLargeMeshes | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(12u, scene->mMeshes[0]->mNumFaces);
+}
+
 // Test issue #623, PLY importer should not automatically create faces
 TEST_F(utPLYImportExport, pointcloudTest) {
     Assimp::Importer importer;
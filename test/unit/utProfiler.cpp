@@ -44,6 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UTLogStream.h"
 #include <assimp/Profiler.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/cimport.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <string>
 
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
@@ -75,3 +81,133 @@ TEST_F( utProfiler, addRegion_success ) {
     //UTLogStream *stream( (UTLogStream*) m_stream );
     //EXPECT_FALSE( stream->m_messages.empty() );
 }
+
+static uint64_t numTestAllocations = 0;
+
+static uint64_t countTestAllocations() {
+    return numTestAllocations;
+}
+
+static const aiProfileRegion *findRegion(const aiImportStatistics *stats, const std::string &name) {
+    for (unsigned int i = 0; i < stats->mNumRegions; ++i) {
+        if (name == stats->mRegions[i].mName.C_Str()) {
+            return &stats->mRegions[i];
+        }
+    }
+    return nullptr;
+}
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    Profiler myProfiler;
+    EXPECT_EQ( 0u, myProfiler.GetStatistics()->mNumRegions );
+
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.AddBytesRead( 42 );
+    myProfiler.EndRegion( "outer" ); // ends "inner" as well
+    myProfiler.BeginRegion( "second" );
+    myProfiler.EndRegion( "second" );
+    myProfiler.EndRegion( "unknown" );
+
+    const aiImportStatistics *stats = myProfiler.GetStatistics();
+    ASSERT_EQ( 3u, stats->mNumRegions );
+    EXPECT_STREQ( "outer", stats->mRegions[0].mName.C_Str() );
+    EXPECT_EQ( static_cast<unsigned int>(AI_PROFILE_REGION_NO_PARENT), stats->mRegions[0].mParent );
+    EXPECT_EQ( 0u, stats->mRegions[1].mParent );
+    EXPECT_EQ( 1u, stats->mRegions[1].mDepth );
+    EXPECT_EQ( static_cast<unsigned int>(AI_PROFILE_REGION_NO_PARENT), stats->mRegions[2].mParent );
+    EXPECT_EQ( 42u, stats->mRegions[0].mBytesRead );
+    EXPECT_EQ( 42u, stats->mRegions[1].mBytesRead );
+    EXPECT_EQ( 0u, stats->mRegions[2].mBytesRead );
+    EXPECT_GE( stats->mRegions[0].mWallTime, stats->mRegions[1].mWallTime );
+
+    myProfiler.Clear();
+    EXPECT_EQ( 0u, myProfiler.GetStatistics()->mNumRegions );
+}
+
+TEST_F( utProfiler, metrics_success ) {
+    Profiler myProfiler;
+    myProfiler.AddMetric( "outside", 1.0 );
+    myProfiler.BeginRegion( "step" );
+    myProfiler.AddMetric( "ratio", 0.5 );
+    myProfiler.EndRegion( "step" );
+
+    const aiImportStatistics *stats = myProfiler.GetStatistics();
+    ASSERT_EQ( 2u, stats->mNumMetrics );
+    EXPECT_EQ( static_cast<unsigned int>(AI_PROFILE_REGION_NO_PARENT), stats->mMetrics[0].mRegion );
+    EXPECT_STREQ( "ratio", stats->mMetrics[1].mName.C_Str() );
+    EXPECT_EQ( 0u, stats->mMetrics[1].mRegion );
+    EXPECT_EQ( 0.5, stats->mMetrics[1].mValue );
+
+    myProfiler.Clear();
+    EXPECT_EQ( 0u, myProfiler.GetStatistics()->mNumMetrics );
+}
+
+TEST_F( utProfiler, allocationCounter_success ) {
+    Profiler::SetAllocationCounter( &countTestAllocations );
+
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "t1" );
+    numTestAllocations += 7;
+    myProfiler.EndRegion( "t1" );
+    Profiler::SetAllocationCounter( nullptr );
+
+    EXPECT_EQ( 7u, myProfiler.GetStatistics()->mRegions[0].mNumAllocations );
+}
+
+TEST_F( utProfiler, importStatistics_success ) {
+    Assimp::Importer importer;
+    EXPECT_EQ( nullptr, importer.GetImportStatistics() );
+
+    const char *file = ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj";
+    ASSERT_NE( nullptr, importer.ReadFile( file, aiProcess_ValidateDataStructure | aiProcess_Triangulate ) );
+    EXPECT_EQ( nullptr, importer.GetImportStatistics() );
+
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    ASSERT_NE( nullptr, importer.ReadFile( file, aiProcess_ValidateDataStructure | aiProcess_Triangulate ) );
+    const aiImportStatistics *stats = importer.GetImportStatistics();
+    ASSERT_NE( nullptr, stats );
+
+    const aiProfileRegion *total = findRegion( stats, "total" );
+    ASSERT_NE( nullptr, total );
+    EXPECT_EQ( 0u, total->mDepth );
+    EXPECT_GT( total->mBytesRead, 0u );
+    EXPECT_GE( total->mWallTime, 0.0 );
+
+    const char *names[] = { "detection", "import", "parse", "convert", "validate", "preprocess", "postprocess", "TriangulateProcess" };
+    for ( const char *name : names ) {
+        const aiProfileRegion *region = findRegion( stats, name );
+        ASSERT_NE( nullptr, region ) << name;
+        EXPECT_GT( region->mDepth, 0u ) << name;
+        EXPECT_LE( region->mWallTime, total->mWallTime ) << name;
+    }
+    EXPECT_STREQ( "import", stats->mRegions[ findRegion( stats, "parse" )->mParent ].mName.C_Str() );
+    EXPECT_STREQ( "postprocess", stats->mRegions[ findRegion( stats, "TriangulateProcess" )->mParent ].mName.C_Str() );
+}
+
+TEST_F( utProfiler, importStatisticsGltf2Phases ) {
+    Assimp::Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    ASSERT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", 0 ) );
+    const aiImportStatistics *stats = importer.GetImportStatistics();
+    ASSERT_NE( nullptr, stats );
+
+    for ( const char *name : { "parse", "convert" } ) {
+        const aiProfileRegion *region = findRegion( stats, name );
+        ASSERT_NE( nullptr, region ) << name;
+        EXPECT_STREQ( "import", stats->mRegions[ region->mParent ].mName.C_Str() ) << name;
+    }
+}
+
+TEST_F( utProfiler, importStatisticsCApi_success ) {
+    aiPropertyStore *props = aiCreatePropertyStore();
+    aiSetImportPropertyInteger( props, AI_CONFIG_GLOB_MEASURE_TIME, 1 );
+    const aiScene *scene = aiImportFileExWithProperties( ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0, nullptr, props );
+    aiReleasePropertyStore( props );
+    ASSERT_NE( nullptr, scene );
+
+    const aiImportStatistics *stats = aiGetImportStatistics( scene );
+    ASSERT_NE( nullptr, stats );
+    EXPECT_NE( nullptr, findRegion( stats, "import" ) );
+    aiReleaseImport( scene );
+}
@@ -99,6 +99,34 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+TEST_F(utSTLImporterExporter, importContiguousFaceIndices) {
+    Assimp::Importer reference;
+    const aiScene *expected = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_NE(nullptr, mesh->mIndexBuffer);
+    ASSERT_EQ(expected->mMeshes[0]->mNumFaces, mesh->mNumFaces);
+    EXPECT_EQ(mesh->mNumFaces * 3, mesh->mIndexBufferSize);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        EXPECT_EQ(mesh->mIndexBuffer + i * 3, mesh->mFaces[i].mIndices);
+        EXPECT_EQ(expected->mMeshes[0]->mFaces[i], mesh->mFaces[i]);
+    }
+
+    // steps which rewrite, move or drop index arrays keep the buffer consistent
+    importer.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+    scene = importer.ApplyPostProcessing(aiProcess_JoinIdenticalVertices | aiProcess_FindDegenerates |
+                                         aiProcess_SortByPType | aiProcess_ImproveCacheLocality |
+                                         aiProcess_PreTransformVertices | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_LT(0u, scene->mMeshes[0]->mNumFaces);
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utSTLImporterExporter, exporterTest) {
@@ -75,3 +75,60 @@ TEST_F(utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion) {
     EXPECT_NO_THROW(SceneCombiner::CopyScene(nullptr, nullptr));
     EXPECT_NO_THROW(SceneCombiner::CopySceneFlat(nullptr, nullptr));
 }
+
+static aiMesh *CreateContiguousMesh(unsigned int numFaces, unsigned int firstIndex) {
+    aiMesh *mesh = new aiMesh;
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    unsigned int *indices = mesh->AllocateContiguousFaces(numFaces, 3);
+    for (unsigned int i = 0; i < numFaces * 3; ++i) {
+        indices[i] = firstIndex + i;
+    }
+    return mesh;
+}
+
+TEST_F(utSceneCombiner, CopyMeshWithIndexBuffer_Test) {
+    std::unique_ptr<aiMesh> src(CreateContiguousMesh(4, 0));
+
+    // a face with an index array of its own next to the buffered ones
+    src->FreeFaceIndices(src->mFaces[3]);
+    src->mFaces[3].mNumIndices = 3;
+    src->mFaces[3].mIndices = new unsigned int[3]{ 2, 1, 0 };
+
+    aiMesh *ptr = nullptr;
+    SceneCombiner::Copy(&ptr, src.get());
+    std::unique_ptr<aiMesh> dest(ptr);
+
+    ASSERT_NE(nullptr, dest->mIndexBuffer);
+    EXPECT_NE(src->mIndexBuffer, dest->mIndexBuffer);
+    EXPECT_EQ(src->mIndexBufferSize, dest->mIndexBufferSize);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(dest->mIndexBuffer + i * 3, dest->mFaces[i].mIndices);
+        EXPECT_EQ(src->mFaces[i], dest->mFaces[i]);
+    }
+    EXPECT_FALSE(dest->IsInIndexBuffer(dest->mFaces[3].mIndices));
+    EXPECT_NE(src->mFaces[3].mIndices, dest->mFaces[3].mIndices);
+    EXPECT_EQ(src->mFaces[3], dest->mFaces[3]);
+}
+
+TEST_F(utSceneCombiner, MergeMeshesWithIndexBuffer_Test) {
+    std::vector<aiMesh *> merge_list;
+    merge_list.push_back(CreateContiguousMesh(2, 0));
+    merge_list.push_back(CreateContiguousMesh(3, 0));
+
+    aiMesh *ptr = nullptr;
+    SceneCombiner::MergeMeshes(&ptr, 0, merge_list.begin(), merge_list.end());
+    std::unique_ptr<aiMesh> out(ptr);
+
+    ASSERT_EQ(5u, out->mNumFaces);
+    ASSERT_NE(nullptr, out->mIndexBuffer);
+    EXPECT_EQ(15u, out->mIndexBufferSize);
+    for (unsigned int i = 0; i < 15; ++i) {
+        // the indices of the second mesh are offset by the vertices of the first
+        EXPECT_EQ(i, out->mIndexBuffer[i]);
+    }
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        EXPECT_EQ(out->mIndexBuffer + i * 3, out->mFaces[i].mIndices);
+    }
+}
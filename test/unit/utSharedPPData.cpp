@@ -45,6 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 
 #include "Common/BaseProcess.h"
+#include "PostProcessing/ProcessHelper.h"
+#include "PostProcessing/TriangulateProcess.h"
 
 using namespace std;
 using namespace Assimp;
@@ -122,3 +124,73 @@ TEST_F(SharedPPDataTest, testPropertyDeallocation)
     delete localShared;
     EXPECT_TRUE(destructed);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SharedPPDataTest, testMeshDataInvalidation)
+{
+    aiMesh meshes[2];
+    const aiMesh *list[2] = { &meshes[0], &meshes[1] };
+
+    uint64_t *hash = new uint64_t(42);
+    EXPECT_EQ(hash, shared->AddMeshData(&meshes[0], MeshData_FaceHash, hash));
+    EXPECT_EQ(hash, shared->AddMeshData(&meshes[0], MeshData_FaceHash, new uint64_t(7)));
+    EXPECT_EQ(42u, *shared->GetMeshData<uint64_t>(&meshes[0], MeshData_FaceHash));
+    EXPECT_EQ(nullptr, shared->GetMeshData<uint64_t>(&meshes[1], MeshData_FaceHash));
+
+    shared->AddMeshData(&meshes[0], MeshData_FaceNormals, new std::vector<aiVector3D>());
+    shared->AddMeshData(&meshes[1], MeshData_FaceHash, new uint64_t(1));
+    EXPECT_EQ(3u, shared->GetMeshDataCount());
+
+    // the face hash doesn't depend on the normals or positions
+    shared->InvalidateMeshData(MeshAttr_Normals, list, 2);
+    EXPECT_EQ(3u, shared->GetMeshDataCount());
+    shared->InvalidateMeshData(MeshAttr_Positions, list, 2);
+    EXPECT_EQ(2u, shared->GetMeshDataCount());
+    EXPECT_EQ(nullptr, shared->GetMeshData<std::vector<aiVector3D> >(&meshes[0], MeshData_FaceNormals));
+
+    // data of meshes which are gone is dropped
+    shared->InvalidateMeshData(0, list, 1);
+    EXPECT_EQ(1u, shared->GetMeshDataCount());
+
+    shared->InvalidateMeshData(MeshAttr_Meshes, list, 2);
+    EXPECT_EQ(0u, shared->GetMeshDataCount());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SharedPPDataTest, testStepKeepsUnrelatedMeshData)
+{
+    aiMesh mesh;
+    const aiMesh *list[1] = { &mesh };
+    shared->AddMeshData(&mesh, MeshData_SpatialIndex, new SharedSpatialIndex());
+    shared->AddMeshData(&mesh, MeshData_FaceHash, new uint64_t(1));
+
+    // triangulation only touches the faces, the spatial index stays valid
+    TriangulateProcess step;
+    shared->InvalidateMeshData(step.GetMutatedMeshAttributes(), list, 1);
+    EXPECT_EQ(1u, shared->GetMeshDataCount());
+    EXPECT_NE(nullptr, shared->GetMeshData<SharedSpatialIndex>(&mesh, MeshData_SpatialIndex));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SharedPPDataTest, testCachedSpatialIndex)
+{
+    aiMesh mesh;
+    mesh.mNumVertices = 3;
+    mesh.mVertices = new aiVector3D[3];
+    mesh.mVertices[1] = aiVector3D(1, 0, 0);
+    mesh.mVertices[2] = aiVector3D(0, 1, 0);
+
+    SharedSpatialIndex local;
+    const SharedSpatialIndex &first = GetSpatialIndex(shared, &mesh, nullptr, local);
+    const SharedSpatialIndex &second = GetSpatialIndex(shared, &mesh, nullptr, local);
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &local);
+
+    std::vector<unsigned int> found;
+    second.first.FindPositions(aiVector3D(1, 0, 0), second.second, found);
+    ASSERT_EQ(1u, found.size());
+    EXPECT_EQ(1u, found[0]);
+
+    // without a cache the index is built into the local instance
+    EXPECT_EQ(&local, &GetSpatialIndex(nullptr, &mesh, nullptr, local));
+}
@@ -0,0 +1,262 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/SimplifyProcess.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/commonMetaData.h>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+
+#include <limits>
+
+using namespace Assimp;
+
+class utSimplifyProcess : public ::testing::Test {
+protected:
+    static const unsigned int Size = 20;
+
+    // a flat Size x Size grid of quads in the xy plane, the vertices of the column
+    // at x == seam are split between the quads left and right of it
+    static aiMesh *createGrid(unsigned int seam, ai_real noise) {
+        const unsigned int rowSize = Size + 2;
+        aiMesh *mesh = new aiMesh();
+        mesh->mName.Set("grid");
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = (Size + 1) * rowSize;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumUVComponents[0] = 2;
+        unsigned int seed = 7;
+        for (unsigned int y = 0; y <= Size; ++y) {
+            for (unsigned int x = 0; x <= Size + 1; ++x) {
+                const unsigned int px = x > seam ? x - 1 : x;
+                seed = seed * 1103515245u + 12345u;
+                const ai_real z = noise * ((seed >> 16) % 1000) / 1000;
+                mesh->mVertices[y * rowSize + x] = aiVector3D((ai_real)px, (ai_real)y, z);
+                mesh->mTextureCoords[0][y * rowSize + x] = aiVector3D(x > seam ? (ai_real)1 : (ai_real)0, 0, 0);
+            }
+        }
+
+        mesh->mNumFaces = Size * Size * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        unsigned int f = 0;
+        for (unsigned int y = 0; y < Size; ++y) {
+            for (unsigned int px = 0; px < Size; ++px) {
+                const unsigned int x = px >= seam ? px + 1 : px;
+                const unsigned int v = y * rowSize + x;
+                const unsigned int quad[2][3] = { { v, v + 1, v + rowSize + 1 }, { v, v + rowSize + 1, v + rowSize } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    mesh->mFaces[f].mNumIndices = 3;
+                    mesh->mFaces[f].mIndices = new unsigned int[3];
+                    std::copy(quad[t], quad[t] + 3, mesh->mFaces[f].mIndices);
+                }
+            }
+        }
+        return mesh;
+    }
+
+    static unsigned int countVertices(const aiMesh *mesh, bool (*predicate)(const aiVector3D &)) {
+        unsigned int count = 0;
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            count += predicate(mesh->mVertices[v]) ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, flatGridKeepsBordersAndSeams) {
+    aiMesh *mesh = createGrid(Size / 2, 0);
+    const ai_real error = SimplifyProcess::SimplifyMesh(mesh, 100, (ai_real)0.01);
+
+    EXPECT_EQ((ai_real)0, error);
+    EXPECT_LT(mesh->mNumFaces, Size * Size);
+    EXPECT_GE(mesh->mNumFaces, 100u);
+
+    // the outline, where the seam adds two vertices, and both sides of the seam are all still there
+    EXPECT_EQ(Size * 4 + 2, countVertices(mesh, [](const aiVector3D &p) {
+        return p.x == 0 || p.y == 0 || p.x == Size || p.y == Size;
+    }));
+    EXPECT_EQ(2 * (Size + 1), countVertices(mesh, [](const aiVector3D &p) {
+        return p.x == Size / 2;
+    }));
+
+    // no face is flipped and every vertex is used
+    std::vector<bool> used(mesh->mNumVertices, false);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const unsigned int *idx = mesh->mFaces[f].mIndices;
+        const aiVector3D n = (mesh->mVertices[idx[1]] - mesh->mVertices[idx[0]]) ^ (mesh->mVertices[idx[2]] - mesh->mVertices[idx[0]]);
+        EXPECT_GT(n.z, 0);
+        used[idx[0]] = used[idx[1]] = used[idx[2]] = true;
+    }
+    EXPECT_EQ(used.end(), std::find(used.begin(), used.end(), false));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, duplicateVerticesAreNoSeam) {
+    // the split column has the same texture coordinates on both sides
+    aiMesh *mesh = createGrid(Size / 2, 0);
+    std::fill(mesh->mTextureCoords[0], mesh->mTextureCoords[0] + mesh->mNumVertices, aiVector3D());
+    SimplifyProcess::SimplifyMesh(mesh, 100, (ai_real)0.01);
+
+    EXPECT_LE(countVertices(mesh, [](const aiVector3D &p) {
+        return p.x == Size / 2;
+    }), Size + 1);
+    EXPECT_EQ(Size * 4, countVertices(mesh, [](const aiVector3D &p) {
+        return p.x == 0 || p.y == 0 || p.x == Size || p.y == Size;
+    }));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, nonFinitePositionsAreSkipped) {
+    aiMesh *mesh = createGrid(Size / 2, 0);
+    mesh->mVertices[Size + 3].y = std::numeric_limits<ai_real>::quiet_NaN();
+    EXPECT_EQ((ai_real)0, SimplifyProcess::SimplifyMesh(mesh, 100, (ai_real)0.01));
+    EXPECT_EQ(Size * Size * 2, mesh->mNumFaces);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, errorBoundIsRespected) {
+    aiMesh *mesh = createGrid(Size + 1, (ai_real)0.5);
+    SimplifyProcess::SimplifyMesh(mesh, 10, 0);
+    EXPECT_EQ(Size * Size * 2, mesh->mNumFaces);
+
+    const ai_real error = SimplifyProcess::SimplifyMesh(mesh, 10, (ai_real)0.2);
+    EXPECT_LT(mesh->mNumFaces, Size * Size * 2);
+    EXPECT_GT(error, (ai_real)0);
+    EXPECT_LE(error, (ai_real)0.2);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, generatesLodChain) {
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = createGrid(Size + 1, 0);
+    scene->mRootNode = new aiNode("root");
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_SIMPLIFY, true);
+    importer.SetPropertyInteger(AI_CONFIG_PP_SIMPLIFY_LOD_COUNT, 2);
+    SimplifyProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(scene);
+
+    ASSERT_EQ(3u, scene->mNumMeshes);
+    EXPECT_EQ(Size * Size * 2, scene->mMeshes[0]->mNumFaces);
+    EXPECT_STREQ("grid_LOD1", scene->mMeshes[1]->mName.C_Str());
+    EXPECT_STREQ("grid_LOD2", scene->mMeshes[2]->mName.C_Str());
+    EXPECT_LE(scene->mMeshes[1]->mNumFaces, Size * Size);
+    EXPECT_LT(scene->mMeshes[2]->mNumFaces, scene->mMeshes[1]->mNumFaces);
+
+    ASSERT_EQ(2u, scene->mRootNode->mNumChildren);
+    for (unsigned int level = 1; level <= 2; ++level) {
+        const aiNode *child = scene->mRootNode->mChildren[level - 1];
+        EXPECT_EQ(scene->mRootNode, child->mParent);
+        ASSERT_EQ(1u, child->mNumMeshes);
+        EXPECT_EQ(level, child->mMeshes[0]);
+        int32_t lodLevel = 0;
+        ASSERT_TRUE(child->mMetaData->Get(AI_METADATA_LOD_LEVEL, lodLevel));
+        EXPECT_EQ(static_cast<int32_t>(level), lodLevel);
+    }
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, disabledByDefault) {
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = createGrid(Size + 1, 0);
+    scene->mRootNode = new aiNode("root");
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_SIMPLIFY_LOD_COUNT, 2);
+    SimplifyProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(scene);
+
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    EXPECT_EQ(Size * Size * 2, scene->mMeshes[0]->mNumFaces);
+    EXPECT_EQ(0u, scene->mRootNode->mNumChildren);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSimplifyProcess, longNamesAreShortened) {
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = createGrid(Size + 1, 0);
+    scene->mMeshes[0]->mName.Set(std::string(MAXLEN - 1, 'm'));
+    scene->mRootNode = new aiNode(std::string(MAXLEN - 1, 'n'));
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_SIMPLIFY, true);
+    importer.SetPropertyInteger(AI_CONFIG_PP_SIMPLIFY_LOD_COUNT, 1);
+    SimplifyProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(scene);
+
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    const aiString &meshName = scene->mMeshes[1]->mName;
+    EXPECT_EQ(MAXLEN - 1, meshName.length);
+    EXPECT_EQ(meshName.length, strlen(meshName.C_Str()));
+    EXPECT_EQ(std::string(MAXLEN - 6, 'm') + "_LOD1", meshName.C_Str());
+
+    ASSERT_EQ(1u, scene->mRootNode->mNumChildren);
+    const aiString &nodeName = scene->mRootNode->mChildren[0]->mName;
+    EXPECT_EQ(MAXLEN - 1, nodeName.length);
+    EXPECT_EQ(std::string(MAXLEN - 6, 'n') + "_LOD1", nodeName.C_Str());
+    delete scene;
+}
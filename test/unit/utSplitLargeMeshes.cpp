@@ -153,3 +153,116 @@ TEST_F(SplitLargeMeshesTest, testTriangleSplit) {
     }
     EXPECT_EQ(0, iOldFaceNum);
 }
+
+// ------------------------------------------------------------------------------------------------
+static aiMesh *CreateGridMesh(unsigned int size) {
+    // a regular grid of quads, each made of two triangles
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = (size + 1) * (size + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            mesh->mVertices[y * (size + 1) + x] = aiVector3D((ai_real)x, (ai_real)y, 0);
+            mesh->mNormals[y * (size + 1) + x] = aiVector3D(0, 0, 1);
+        }
+    }
+
+    // shuffle the faces so splitting by face order isn't spatially coherent
+    std::vector<unsigned int> order(size * size);
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        order[i] = (i * 7919) % (unsigned int)order.size();
+    }
+
+    mesh->mNumFaces = size * size * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        const unsigned int x = order[i] % size, y = order[i] / size;
+        const unsigned int v0 = y * (size + 1) + x, v1 = v0 + 1, v2 = v0 + size + 1, v3 = v2 + 1;
+        const unsigned int indices[2][3] = { { v0, v1, v3 }, { v0, v3, v2 } };
+        for (unsigned int t = 0; t < 2; ++t) {
+            aiFace &face = mesh->mFaces[i * 2 + t];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                face.mIndices[k] = indices[t][k];
+            }
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void CheckSpatialChunks(const std::vector<std::pair<aiMesh *, unsigned int>> &avOut, unsigned int size) {
+    ai_real area = 0;
+    unsigned int numFaces = 0;
+    for (const std::pair<aiMesh *, unsigned int> &entry : avOut) {
+        const aiMesh *mesh = entry.first;
+        EXPECT_EQ(0U, entry.second);
+        ASSERT_TRUE(NULL != mesh->mNormals);
+        numFaces += mesh->mNumFaces;
+
+        // the bounding box must be tight
+        aiVector3D min(1e10f, 1e10f, 1e10f), max(-1e10f, -1e10f, -1e10f);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            for (unsigned int k = 0; k < mesh->mFaces[i].mNumIndices; ++k) {
+                ASSERT_LT(mesh->mFaces[i].mIndices[k], mesh->mNumVertices);
+                const aiVector3D &v = mesh->mVertices[mesh->mFaces[i].mIndices[k]];
+                min.x = std::min(min.x, v.x);
+                min.y = std::min(min.y, v.y);
+                max.x = std::max(max.x, v.x);
+                max.y = std::max(max.y, v.y);
+            }
+        }
+        EXPECT_EQ(min.x, mesh->mAABB.mMin.x);
+        EXPECT_EQ(min.y, mesh->mAABB.mMin.y);
+        EXPECT_EQ(max.x, mesh->mAABB.mMax.x);
+        EXPECT_EQ(max.y, mesh->mAABB.mMax.y);
+        area += (max.x - min.x) * (max.y - min.y);
+    }
+    EXPECT_EQ(size * size * 2, numFaces);
+
+    // spatially coherent chunks barely overlap
+    EXPECT_LT(area, (ai_real)(size * size) * 1.5f);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testSpatialTriangleSplit) {
+    std::vector<std::pair<aiMesh *, unsigned int>> avOut;
+
+    const unsigned int size = 64;
+    piProcessTriangle->SetSpatial(true);
+    piProcessTriangle->SplitMesh(0, CreateGridMesh(size), avOut);
+    EXPECT_LT(4U, avOut.size());
+
+    for (const std::pair<aiMesh *, unsigned int> &entry : avOut) {
+        EXPECT_LE(entry.first->mNumFaces, 1000U);
+        // the output is still verbose
+        EXPECT_EQ(entry.first->mNumFaces * 3, entry.first->mNumVertices);
+    }
+    CheckSpatialChunks(avOut, size);
+
+    for (const std::pair<aiMesh *, unsigned int> &entry : avOut) {
+        delete entry.first;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testSpatialVertexSplit) {
+    std::vector<std::pair<aiMesh *, unsigned int>> avOut;
+
+    const unsigned int size = 64;
+    piProcessVertex->SetSpatial(true);
+    piProcessVertex->SplitMesh(0, CreateGridMesh(size), avOut);
+    EXPECT_LT(4U, avOut.size());
+
+    for (const std::pair<aiMesh *, unsigned int> &entry : avOut) {
+        EXPECT_LE(entry.first->mNumVertices, 1000U);
+    }
+    CheckSpatialChunks(avOut, size);
+
+    for (const std::pair<aiMesh *, unsigned int> &entry : avOut) {
+        delete entry.first;
+    }
+}
@@ -75,3 +75,18 @@ TEST_F( utTypes, Color3dIndexOpTest ) {
     const ai_real b = col[ 2 ];
     EXPECT_FLOAT_EQ( 3, b );
 }
+
+TEST_F( utTypes, StringTruncatesToMaxLenTest ) {
+    EXPECT_EQ( sizeof( ai_uint32 ) + MAXLEN, sizeof( aiString ) );
+
+    aiString str( std::string( MAXLEN + 10, 'a' ) );
+    EXPECT_EQ( MAXLEN - 1, str.length );
+    EXPECT_EQ( '\0', str.data[ MAXLEN - 1 ] );
+
+    str.Append( "b" );
+    EXPECT_EQ( MAXLEN - 1, str.length );
+
+    str.Set( std::string( MAXLEN, 'c' ) );
+    EXPECT_EQ( MAXLEN - 1, str.length );
+    EXPECT_EQ( 'c', str.data[ 0 ] );
+}
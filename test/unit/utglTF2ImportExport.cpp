@@ -112,6 +112,35 @@ TEST_F(utglTF2ImportExport, importBinaryglTF2FromFileTest) {
     EXPECT_TRUE(binaryImporterTest());
 }
 
+TEST_F(utglTF2ImportExport, importContiguousFaceIndices) {
+    Assimp::Importer reference;
+    const aiScene *expected = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_FACE_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        ASSERT_NE(nullptr, mesh->mIndexBuffer);
+        ASSERT_EQ(expected->mMeshes[m]->mNumFaces, mesh->mNumFaces);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            EXPECT_EQ(mesh->mIndexBuffer + i * 3, mesh->mFaces[i].mIndices);
+            EXPECT_EQ(expected->mMeshes[m]->mFaces[i], mesh->mFaces[i]);
+        }
+    }
+
+    // merging the meshes moves their faces into one buffer
+    scene = importer.ApplyPostProcessing(aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph |
+                                         aiProcess_GenSmoothNormals | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_GE(expected->mNumMeshes, scene->mNumMeshes);
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 TEST_F(utglTF2ImportExport, importglTF2AndExportToOBJ) {
     Assimp::Importer importer;
@@ -634,3 +663,41 @@ TEST_F(utglTF2ImportExport, wrongTypes) {
     }
 }
 
+
+TEST_F(utglTF2ImportExport, importMorphTargetsMultithreaded) {
+    // the accessors of a primitive and its morph targets are decoded on the worker
+    // pool when multithreading is enabled, the result must not depend on it
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/glTF-Sample-Models/AnimatedMorphCube-glTF/AnimatedMorphCube.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    const aiScene *scene = parallel.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/glTF-Sample-Models/AnimatedMorphCube-glTF/AnimatedMorphCube.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *a = expected->mMeshes[m], *b = scene->mMeshes[m];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_TRUE(b->HasTangentsAndBitangents());
+        ASSERT_EQ(a->mNumAnimMeshes, b->mNumAnimMeshes);
+        ASSERT_GT(b->mNumAnimMeshes, 0u);
+        for (unsigned int i = 0; i < b->mNumVertices; ++i) {
+            EXPECT_EQ(a->mVertices[i], b->mVertices[i]);
+            EXPECT_EQ(a->mNormals[i], b->mNormals[i]);
+            EXPECT_EQ(a->mTangents[i], b->mTangents[i]);
+            EXPECT_EQ(a->mBitangents[i], b->mBitangents[i]);
+        }
+        for (unsigned int t = 0; t < b->mNumAnimMeshes; ++t) {
+            const aiAnimMesh *ta = a->mAnimMeshes[t], *tb = b->mAnimMeshes[t];
+            ASSERT_EQ(ta->mNumVertices, tb->mNumVertices);
+            for (unsigned int i = 0; i < tb->mNumVertices; ++i) {
+                EXPECT_EQ(ta->mVertices[i], tb->mVertices[i]);
+                if (tb->HasNormals()) {
+                    EXPECT_EQ(ta->mNormals[i], tb->mNormals[i]);
+                }
+            }
+        }
+    }
+}